@@ -0,0 +1,1299 @@
+/*
+ * Library: libcrc
+ * File:    examples/crcsum.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2026 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The file crcsum.c contains a command line program in the style of sha256sum
+ * which calculates the CRC values of files and directory trees, and which can
+ * verify those values later against a manifest. The program writes one line
+ * per file and algorithm, so the output can be stored as a manifest.
+ *
+ * Files are hashed concurrently on a pool of worker threads. Every thread has
+ * its own queue of tasks and takes new work from the queues of other threads
+ * when its own queue is empty. Directories are walked by the same threads.
+ * Large files are split in segments which are calculated by different threads
+ * and the values of the segments are merged with the crc_xxx_combine()
+ * functions of the library. All algorithms requested are calculated in one
+ * pass over the data with crc_multi().
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if ! defined(_WIN32)
+#define CRCSUM_HAVE_POSIX
+#include <ctype.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+#include "../include/checksum.h"
+
+#if defined(CRCSUM_HAVE_POSIX)
+
+/*
+ * #define CRCSUM_xxxx
+ *
+ * Files larger than CRCSUM_SPLIT_SIZE bytes are split in segments of
+ * CRCSUM_SEGMENT_SIZE bytes which are calculated in parallel. Files which
+ * cannot be mapped in memory are read in blocks of CRCSUM_READ_SIZE bytes.
+ * The segment size must be a multiple of the page size of the system.
+ */
+
+#define CRCSUM_SEGMENT_SIZE	((off_t) 32*1024*1024)
+#define CRCSUM_SPLIT_SIZE	(2*CRCSUM_SEGMENT_SIZE)
+#define CRCSUM_READ_SIZE	(256*1024)
+#define CRCSUM_MAX_THREADS	256
+#define CRCSUM_MAX_LINE		4096
+
+/*
+ * struct crcsum_algo_tp
+ *
+ * The structure crcsum_algo_tp describes one of the algorithms which can be
+ * selected with the -a option. The tag is the name of the algorithm in the
+ * tagged output format and the manifest.
+ */
+
+						/************************************************/
+struct crcsum_algo_tp {				/*						*/
+	const char *	name;			/* Name used with the -a option			*/
+	const char *	tag;			/* Name used in tagged lines			*/
+	enum crc_algo	algo;			/* Algorithm in the library			*/
+	int		digits;			/* Number of hexadecimal digits of the CRC	*/
+	uint64_t	(*combine)( uint64_t crc1, uint64_t crc2, size_t len2 );	/* Merge two segments	*/
+};						/*						*/
+						/************************************************/
+
+/*
+ * struct crcsum_entry_tp
+ *
+ * The structure crcsum_entry_tp holds the results of one file. When a
+ * manifest is verified the expected values are stored in the same entry.
+ */
+
+						/************************************************/
+struct crcsum_entry_tp {			/*						*/
+	char *		path;			/* Name of the file				*/
+	uint32_t	mask;			/* Algorithms calculated for the file		*/
+	int		error;			/* Error number, or 0 when successful		*/
+	uint64_t	crc[CRC_ALGO_NUM];	/* Calculated CRC values			*/
+	uint64_t	expect[CRC_ALGO_NUM];	/* CRC values in the manifest			*/
+};						/*						*/
+						/************************************************/
+
+/*
+ * struct crcsum_file_tp
+ *
+ * The structure crcsum_file_tp holds the state of a file which is split in
+ * segments. The thread which finishes the last segment merges the values of
+ * all segments and closes the file.
+ */
+
+						/************************************************/
+struct crcsum_file_tp {				/*						*/
+	struct crcsum_entry_tp *entry;		/* Entry which receives the result		*/
+	int		fd;			/* Open file descriptor				*/
+	off_t		size;			/* Size of the file in bytes			*/
+	size_t		num_seg;		/* Number of segments				*/
+	size_t		remaining;		/* Number of segments not yet finished		*/
+	int		error;			/* First error of a segment			*/
+	uint64_t	(*seg_crc)[CRC_ALGO_NUM];	/* CRC values of all segments		*/
+};						/*						*/
+						/************************************************/
+
+/*
+ * struct crcsum_task_tp
+ *
+ * The structure crcsum_task_tp describes one unit of work in the queue of a
+ * worker thread. A path task checks the type of a path and hashes a file or
+ * queues the contents of a directory. A segment task calculates the CRC
+ * values of one segment of a large file.
+ */
+
+enum crcsum_task_type { CRCSUM_TASK_PATH, CRCSUM_TASK_SEGMENT };
+
+						/************************************************/
+struct crcsum_task_tp {				/*						*/
+	enum crcsum_task_type type;		/* Kind of work					*/
+	char *		path;			/* Path to check when not yet in an entry	*/
+	struct crcsum_entry_tp *entry;		/* Entry of the file, or NULL			*/
+	bool		top;			/* Path was given on the command line		*/
+	struct crcsum_file_tp *file;		/* File of a segment task			*/
+	size_t		seg;			/* Index of the segment				*/
+};						/*						*/
+						/************************************************/
+
+/*
+ * struct crcsum_worker_tp
+ *
+ * The structure crcsum_worker_tp holds a worker thread and its queue of
+ * tasks. The queue is a ring buffer. The owner adds and removes tasks at the
+ * tail, other threads steal the oldest tasks at the head.
+ */
+
+						/************************************************/
+struct crcsum_worker_tp {			/*						*/
+	pthread_t	thread;			/* The thread					*/
+	int		id;			/* Index of the worker				*/
+	bool		started;		/* The thread has been created			*/
+	pthread_mutex_t	lock;			/* Protects the queue				*/
+	struct crcsum_task_tp **tasks;		/* Ring buffer with tasks			*/
+	size_t		capacity;		/* Size of the ring buffer, a power of two	*/
+	size_t		head;			/* Position of the oldest task			*/
+	size_t		tail;			/* Position after the newest task		*/
+};						/*						*/
+						/************************************************/
+
+#define CRCSUM_COMBINE(name, type)									\
+static uint64_t combine_##name( uint64_t crc1, uint64_t crc2, size_t len2 ) {				\
+	return crc_##name##_combine( (type) crc1, (type) crc2, len2 );					\
+}
+
+CRCSUM_COMBINE( 8,          uint8_t  )
+CRCSUM_COMBINE( 16,         uint16_t )
+CRCSUM_COMBINE( 32,         uint32_t )
+CRCSUM_COMBINE( 32c,        uint32_t )
+CRCSUM_COMBINE( 64_ecma,    uint64_t )
+CRCSUM_COMBINE( 64_we,      uint64_t )
+CRCSUM_COMBINE( ccitt_1d0f, uint16_t )
+CRCSUM_COMBINE( ccitt_ffff, uint16_t )
+CRCSUM_COMBINE( dnp,        uint16_t )
+CRCSUM_COMBINE( kermit,     uint16_t )
+CRCSUM_COMBINE( modbus,     uint16_t )
+CRCSUM_COMBINE( xmodem,     uint16_t )
+
+static const struct crcsum_algo_tp crcsum_algos[] = {
+	{ "crc8",      "CRC8",      CRC_ALGO_8,           2, combine_8          },
+	{ "crc16",     "CRC16",     CRC_ALGO_16,          4, combine_16         },
+	{ "crc32",     "CRC32",     CRC_ALGO_32,          8, combine_32         },
+	{ "crc32c",    "CRC32C",    CRC_ALGO_32C,         8, combine_32c        },
+	{ "crc64ecma", "CRC64ECMA", CRC_ALGO_64_ECMA,    16, combine_64_ecma    },
+	{ "crc64we",   "CRC64WE",   CRC_ALGO_64_WE,      16, combine_64_we      },
+	{ "ccitt1d0f", "CCITT1D0F", CRC_ALGO_CCITT_1D0F,  4, combine_ccitt_1d0f },
+	{ "ccittffff", "CCITTFFFF", CRC_ALGO_CCITT_FFFF,  4, combine_ccitt_ffff },
+	{ "dnp",       "DNP",       CRC_ALGO_DNP,         4, combine_dnp        },
+	{ "kermit",    "KERMIT",    CRC_ALGO_KERMIT,      4, combine_kermit     },
+	{ "modbus",    "MODBUS",    CRC_ALGO_MODBUS,      4, combine_modbus     },
+	{ "xmodem",    "XMODEM",    CRC_ALGO_XMODEM,      4, combine_xmodem     }
+};
+
+#define CRCSUM_NUM_ALGOS	( sizeof( crcsum_algos ) / sizeof( crcsum_algos[0] ) )
+
+static const struct crcsum_algo_tp *	find_algo( const char *name );
+static bool				parse_algos( char *list, uint32_t *mask );
+static bool				read_manifest( const char *name, uint32_t mask );
+static struct crcsum_entry_tp *		add_entry( char *path, uint32_t mask );
+static int				compare_entries( const void *a, const void *b );
+static void				print_entries( bool tagged );
+static void				verify_entries( bool quiet );
+static void				report_error( const char *path, int error );
+
+static void				run_task( struct crcsum_worker_tp *w, struct crcsum_task_tp *task );
+static void				run_path( struct crcsum_worker_tp *w, struct crcsum_task_tp *task );
+static void				run_dir( struct crcsum_worker_tp *w, const char *path );
+static void				run_file( struct crcsum_worker_tp *w, struct crcsum_entry_tp *entry );
+static void				run_segment( struct crcsum_file_tp *file, size_t seg );
+static int				calc_range( int fd, off_t offset, off_t num_bytes, uint32_t mask, uint64_t results[CRC_ALGO_NUM] );
+static int				calc_read( int fd, off_t offset, off_t num_bytes, bool bounded, uint32_t mask, uint64_t results[CRC_ALGO_NUM] );
+
+static void				pool_push( struct crcsum_worker_tp *w, struct crcsum_task_tp *task );
+static struct crcsum_task_tp *		pool_take( struct crcsum_worker_tp *w );
+static void				pool_done( void );
+static void *				pool_worker( void *arg );
+
+static uint32_t				algo_mask;
+static bool				verify_mode;
+static int				exit_status;
+
+static struct crcsum_entry_tp **	entries;
+static size_t				num_entries;
+static size_t				max_entries;
+static pthread_mutex_t			entry_lock	= PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t			file_lock	= PTHREAD_MUTEX_INITIALIZER;
+
+static struct crcsum_worker_tp *	workers;
+static int				num_workers;
+static pthread_mutex_t			pool_lock	= PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t			pool_wake	= PTHREAD_COND_INITIALIZER;
+static size_t				pool_queued;
+static size_t				pool_pending;
+static int				pool_idle;
+
+/*
+ * int main( int argc, char *argv[] );
+ *
+ * The function main() is the entry point of the crcsum program. It parses the
+ * options, queues the paths on the command line or the entries of the
+ * manifest, runs the worker pool until all work is done and prints the
+ * results.
+ */
+
+int main( int argc, char *argv[] ) {
+
+	int a;
+	int opt;
+	long num_threads;
+	const char *manifest;
+	bool tagged;
+	bool quiet;
+	struct crcsum_task_tp *task;
+
+	algo_mask   = 0;
+	manifest    = NULL;
+	num_threads = 0;
+	tagged      = false;
+	quiet       = false;
+
+	while ( ( opt = getopt( argc, argv, "a:c:j:qt" ) ) != -1 ) {
+
+		switch ( opt ) {
+
+			case 'a' :
+				if ( ! parse_algos( optarg, & algo_mask ) ) {
+
+					fprintf( stderr, "crcsum: unknown algorithm in '%s'\n", optarg );
+					exit( 2 );
+				}
+				break;
+
+			case 'c' : manifest    = optarg;                       break;
+			case 'j' : num_threads = strtol( optarg, NULL, 10 );   break;
+			case 'q' : quiet       = true;                         break;
+			case 't' : tagged      = true;                         break;
+
+			default  :
+				fprintf( stderr, "Usage: crcsum [-a algorithm[,...]] [-j threads] [-t] path ...\n" );
+				fprintf( stderr, "       crcsum [-a algorithm] [-j threads] [-q] -c manifest\n\n" );
+				fprintf( stderr, "    -a Algorithms to calculate, default crc32. Supported are:\n       " );
+				for (a=0; a<(int)CRCSUM_NUM_ALGOS; a++) fprintf( stderr, " %s", crcsum_algos[a].name );
+				fprintf( stderr, "\n" );
+				fprintf( stderr, "    -c Verify the files listed in a manifest. The name - reads stdin.\n" );
+				fprintf( stderr, "    -j Number of worker threads, default one per processor.\n" );
+				fprintf( stderr, "    -q Do not print a line for every file which is OK.\n" );
+				fprintf( stderr, "    -t Write tagged lines which contain the algorithm name.\n" );
+				exit( 2 );
+		}
+	}
+
+	if ( algo_mask == 0 ) algo_mask = CRC_ALGO_MASK( CRC_ALGO_32 );
+
+	if ( num_threads <= 0 ) {
+
+#if defined(_SC_NPROCESSORS_ONLN)
+		num_threads = sysconf( _SC_NPROCESSORS_ONLN );
+#endif
+		if ( num_threads <= 0 ) num_threads = 1;
+	}
+
+	if ( num_threads > CRCSUM_MAX_THREADS ) num_threads = CRCSUM_MAX_THREADS;
+
+	num_workers = (int) num_threads;
+	workers     = calloc( (size_t) num_workers, sizeof( struct crcsum_worker_tp ) );
+
+	if ( workers == NULL ) {
+
+		fprintf( stderr, "crcsum: out of memory\n" );
+		exit( 2 );
+	}
+
+	for (a=0; a<num_workers; a++) {
+
+		workers[a].id = a;
+		pthread_mutex_init( & workers[a].lock, NULL );
+	}
+
+	/*
+	 * In verify mode every entry of the manifest becomes a task. Otherwise
+	 * every path on the command line is queued and the type of the path is
+	 * checked by the worker which runs the task. The initial tasks are
+	 * spread over the queues of all workers.
+	 */
+
+	if ( manifest != NULL ) {
+
+		if ( optind < argc ) {
+
+			fprintf( stderr, "crcsum: paths cannot be combined with -c\n" );
+			exit( 2 );
+		}
+
+		verify_mode = true;
+
+		if ( ! read_manifest( manifest, algo_mask ) ) exit( 2 );
+
+		for (a=0; a<(int)num_entries; a++) {
+
+			task = calloc( 1, sizeof( struct crcsum_task_tp ) );
+			if ( task == NULL ) { fprintf( stderr, "crcsum: out of memory\n" ); exit( 2 ); }
+
+			task->type  = CRCSUM_TASK_PATH;
+			task->entry = entries[a];
+			task->top   = true;
+
+			pool_push( & workers[a % num_workers], task );
+		}
+	}
+
+	else {
+
+		for (a=optind; a<argc  ||  a==optind; a++) {
+
+			task = calloc( 1, sizeof( struct crcsum_task_tp ) );
+			if ( task != NULL ) task->path = strdup( ( a < argc ) ? argv[a] : "-" );
+			if ( task == NULL  ||  task->path == NULL ) { fprintf( stderr, "crcsum: out of memory\n" ); exit( 2 ); }
+
+			task->type = CRCSUM_TASK_PATH;
+			task->top  = true;
+
+			pool_push( & workers[(a-optind) % num_workers], task );
+		}
+	}
+
+	/*
+	 * The main thread acts as the first worker. When a thread cannot be
+	 * created the other workers steal its tasks.
+	 */
+
+	for (a=1; a<num_workers; a++) {
+
+		workers[a].started = ( pthread_create( & workers[a].thread, NULL, pool_worker, & workers[a] ) == 0 );
+	}
+
+	pool_worker( & workers[0] );
+
+	for (a=1; a<num_workers; a++) {
+
+		if ( workers[a].started ) pthread_join( workers[a].thread, NULL );
+	}
+
+	if ( verify_mode ) verify_entries( quiet );
+
+	else {
+
+		qsort( entries, num_entries, sizeof( entries[0] ), compare_entries );
+		print_entries( tagged );
+	}
+
+	return exit_status;
+
+}  /* main (crcsum.c) */
+
+/*
+ * static const struct crcsum_algo_tp *find_algo( const char *name );
+ *
+ * The function find_algo() returns the description of the algorithm with the
+ * given name or tag, or NULL if the algorithm is unknown. Case is ignored.
+ */
+
+static const struct crcsum_algo_tp *find_algo( const char *name ) {
+
+	size_t a;
+
+	for (a=0; a<CRCSUM_NUM_ALGOS; a++) {
+
+		if ( ! strcasecmp( name, crcsum_algos[a].name ) ) return & crcsum_algos[a];
+	}
+
+	return NULL;
+
+}  /* find_algo */
+
+/*
+ * static bool parse_algos( char *list, uint32_t *mask );
+ *
+ * The function parse_algos() adds the algorithms in a comma separated list to
+ * a mask. The function returns false if the list contains an unknown name.
+ */
+
+static bool parse_algos( char *list, uint32_t *mask ) {
+
+	char *name;
+	char *next;
+	const struct crcsum_algo_tp *algo;
+
+	for (name=list; name!=NULL; name=next) {
+
+		next = strchr( name, ',' );
+		if ( next != NULL ) *next++ = 0;
+
+		algo = find_algo( name );
+		if ( algo == NULL ) return false;
+
+		*mask |= CRC_ALGO_MASK( algo->algo );
+	}
+
+	return true;
+
+}  /* parse_algos */
+
+/*
+ * static bool read_manifest( const char *name, uint32_t mask );
+ *
+ * The function read_manifest() reads the expected CRC values from a manifest
+ * and creates an entry for every file. Tagged lines have the form
+ * "TAG (path) = value". Untagged lines have the form "value  path" and use the
+ * single algorithm selected with -a. Consecutive lines of the same file are
+ * merged in one entry, so that all algorithms are calculated in one pass.
+ */
+
+static bool read_manifest( const char *name, uint32_t mask ) {
+
+	FILE *fp;
+	char line[CRCSUM_MAX_LINE];
+	char *ptr;
+	char *path;
+	char *value;
+	char *end;
+	size_t len;
+	size_t num_bad;
+	uint64_t crc;
+	const struct crcsum_algo_tp *algo;
+	const struct crcsum_algo_tp *untagged;
+	struct crcsum_entry_tp *entry;
+
+	untagged = NULL;
+
+	for (len=0; len<CRCSUM_NUM_ALGOS; len++) {
+
+		if ( mask == CRC_ALGO_MASK( crcsum_algos[len].algo ) ) untagged = & crcsum_algos[len];
+	}
+
+	if ( ! strcmp( name, "-" ) ) fp = stdin;
+	else                         fp = fopen( name, "r" );
+
+	if ( fp == NULL ) {
+
+		fprintf( stderr, "crcsum: %s: %s\n", name, strerror( errno ) );
+		return false;
+	}
+
+	num_bad = 0;
+	entry   = NULL;
+
+	while ( fgets( line, CRCSUM_MAX_LINE, fp ) != NULL ) {
+
+		len = strlen( line );
+		while ( len > 0  &&  ( line[len-1] == '\n'  ||  line[len-1] == '\r' ) ) line[--len] = 0;
+
+		if ( len == 0  ||  line[0] == '#' ) continue;
+
+		algo  = NULL;
+		path  = NULL;
+		value = NULL;
+		ptr   = strstr( line, " (" );
+
+		if ( ptr != NULL ) {
+
+			*ptr = 0;
+			algo = find_algo( line );
+			*ptr = ' ';
+		}
+
+		if ( algo != NULL ) {
+
+			path = ptr + 2;
+			end  = NULL;
+
+			for (ptr=strstr( path, ") = " ); ptr!=NULL; ptr=strstr( ptr+1, ") = " )) end = ptr;
+
+			if ( end != NULL ) {
+
+				*end  = 0;
+				value = end + 4;
+			}
+		}
+
+		else if ( untagged != NULL ) {
+
+			algo  = untagged;
+			value = line;
+			ptr   = line;
+
+			while ( isxdigit( (unsigned char) *ptr ) ) ptr++;
+
+			if ( ptr[0] == ' '  &&  ( ptr[1] == ' '  ||  ptr[1] == '*' ) ) {
+
+				*ptr = 0;
+				path = ptr + 2;
+			}
+
+			else path = NULL;
+		}
+
+		if ( algo == NULL  ||  path == NULL  ||  value == NULL  ||  *path == 0  ||  *value == 0 ) { num_bad++; continue; }
+
+		errno = 0;
+		crc   = strtoull( value, & end, 16 );
+
+		if ( errno != 0  ||  *end != 0  ||  (int) strlen( value ) != algo->digits ) { num_bad++; continue; }
+
+		if ( entry == NULL  ||  strcmp( entry->path, path )  ||  ( entry->mask & CRC_ALGO_MASK( algo->algo ) ) ) {
+
+			path  = strdup( path );
+			entry = ( path != NULL ) ? add_entry( path, 0 ) : NULL;
+
+			if ( entry == NULL ) {
+
+				fprintf( stderr, "crcsum: out of memory\n" );
+				if ( fp != stdin ) fclose( fp );
+				return false;
+			}
+		}
+
+		entry->mask               |= CRC_ALGO_MASK( algo->algo );
+		entry->expect[algo->algo]  = crc;
+	}
+
+	if ( fp != stdin ) fclose( fp );
+
+	if ( num_bad > 0 ) fprintf( stderr, "crcsum: WARNING: %zu line%s improperly formatted\n", num_bad, ( num_bad == 1 ) ? " is" : "s are" );
+
+	if ( num_entries == 0 ) {
+
+		fprintf( stderr, "crcsum: %s: no properly formatted checksum lines found\n", name );
+		return false;
+	}
+
+	return true;
+
+}  /* read_manifest */
+
+/*
+ * static struct crcsum_entry_tp *add_entry( char *path, uint32_t mask );
+ *
+ * The function add_entry() creates a result entry for a file and adds it to
+ * the list of entries. The entry takes ownership of the path. NULL is
+ * returned if no memory is available.
+ */
+
+static struct crcsum_entry_tp *add_entry( char *path, uint32_t mask ) {
+
+	size_t new_max;
+	struct crcsum_entry_tp *entry;
+	struct crcsum_entry_tp **new_entries;
+
+	entry = calloc( 1, sizeof( struct crcsum_entry_tp ) );
+	if ( entry == NULL ) return NULL;
+
+	entry->path = path;
+	entry->mask = mask;
+
+	pthread_mutex_lock( & entry_lock );
+
+	if ( num_entries >= max_entries ) {
+
+		new_max     = ( max_entries > 0 ) ? 2 * max_entries : 256;
+		new_entries = realloc( entries, new_max * sizeof( entries[0] ) );
+
+		if ( new_entries == NULL ) {
+
+			pthread_mutex_unlock( & entry_lock );
+			free( entry );
+			return NULL;
+		}
+
+		entries     = new_entries;
+		max_entries = new_max;
+	}
+
+	entries[num_entries++] = entry;
+
+	pthread_mutex_unlock( & entry_lock );
+
+	return entry;
+
+}  /* add_entry */
+
+/*
+ * static int compare_entries( const void *a, const void *b );
+ *
+ * The function compare_entries() sorts the entries on path name, so that the
+ * output does not depend on the order in which the threads finish.
+ */
+
+static int compare_entries( const void *a, const void *b ) {
+
+	const struct crcsum_entry_tp *const *ea = a;
+	const struct crcsum_entry_tp *const *eb = b;
+
+	return strcmp( (*ea)->path, (*eb)->path );
+
+}  /* compare_entries */
+
+/*
+ * static void print_entries( bool tagged );
+ *
+ * The function print_entries() writes the CRC values of all files to stdout.
+ * With one algorithm the format of sha256sum is used. With more than one
+ * algorithm, or when requested, every line starts with the algorithm name.
+ */
+
+static void print_entries( bool tagged ) {
+
+	size_t a;
+	size_t b;
+	const struct crcsum_algo_tp *algo;
+	const struct crcsum_entry_tp *entry;
+
+	if ( algo_mask & ( algo_mask - 1 ) ) tagged = true;
+
+	for (a=0; a<num_entries; a++) {
+
+		entry = entries[a];
+
+		if ( entry->error != 0 ) {
+
+			report_error( entry->path, entry->error );
+			continue;
+		}
+
+		for (b=0; b<CRCSUM_NUM_ALGOS; b++) {
+
+			algo = & crcsum_algos[b];
+
+			if ( ! ( entry->mask & CRC_ALGO_MASK( algo->algo ) ) ) continue;
+
+			if ( tagged ) printf( "%s (%s) = %0*" PRIx64 "\n", algo->tag, entry->path, algo->digits, entry->crc[algo->algo] );
+			else          printf( "%0*" PRIx64 "  %s\n", algo->digits, entry->crc[algo->algo], entry->path );
+		}
+	}
+
+}  /* print_entries */
+
+/*
+ * static void verify_entries( bool quiet );
+ *
+ * The function verify_entries() compares the calculated values with the
+ * values in the manifest and prints the status of every file in the order
+ * of the manifest.
+ */
+
+static void verify_entries( bool quiet ) {
+
+	size_t a;
+	size_t b;
+	size_t num_failed;
+	size_t num_unread;
+	bool ok;
+	const struct crcsum_entry_tp *entry;
+
+	num_failed = 0;
+	num_unread = 0;
+
+	for (a=0; a<num_entries; a++) {
+
+		entry = entries[a];
+
+		if ( entry->error != 0 ) {
+
+			fprintf( stderr, "crcsum: %s: %s\n", entry->path, strerror( entry->error ) );
+			printf( "%s: FAILED open or read\n", entry->path );
+			num_unread++;
+			continue;
+		}
+
+		ok = true;
+
+		for (b=0; b<CRC_ALGO_NUM; b++) {
+
+			if ( ( entry->mask & CRC_ALGO_MASK( b ) )  &&  entry->crc[b] != entry->expect[b] ) ok = false;
+		}
+
+		if      ( ! ok   ) { printf( "%s: FAILED\n", entry->path ); num_failed++; }
+		else if ( ! quiet )  printf( "%s: OK\n",     entry->path );
+	}
+
+	if ( num_unread > 0 ) fprintf( stderr, "crcsum: WARNING: %zu listed file%s could not be read\n",           num_unread, ( num_unread == 1 ) ? "" : "s" );
+	if ( num_failed > 0 ) fprintf( stderr, "crcsum: WARNING: %zu computed checksum%s did NOT match\n", num_failed, ( num_failed == 1 ) ? "" : "s" );
+
+	if ( num_unread > 0  ||  num_failed > 0 ) exit_status = 1;
+
+}  /* verify_entries */
+
+/*
+ * static void report_error( const char *path, int error );
+ *
+ * The function report_error() prints an error for a path to stderr and sets
+ * the exit status of the program.
+ */
+
+static void report_error( const char *path, int error ) {
+
+	pthread_mutex_lock( & entry_lock );
+
+	fprintf( stderr, "crcsum: %s: %s\n", path, strerror( error ) );
+	exit_status = 1;
+
+	pthread_mutex_unlock( & entry_lock );
+
+}  /* report_error */
+
+/*
+ * static void run_task( struct crcsum_worker_tp *w, struct crcsum_task_tp *task );
+ *
+ * The function run_task() performs the work of a task and releases it.
+ */
+
+static void run_task( struct crcsum_worker_tp *w, struct crcsum_task_tp *task ) {
+
+	switch ( task->type ) {
+
+		case CRCSUM_TASK_PATH    : run_path( w, task );                 break;
+		case CRCSUM_TASK_SEGMENT : run_segment( task->file, task->seg ); break;
+	}
+
+	free( task->path );
+	free( task );
+
+}  /* run_task */
+
+/*
+ * static void run_path( struct crcsum_worker_tp *w, struct crcsum_task_tp *task );
+ *
+ * The function run_path() checks the type of a path. Directories are walked,
+ * regular files are hashed. Paths on the command line may also be devices or
+ * pipes. Inside a directory tree symbolic links and special files are
+ * skipped, so that the walk cannot loop or block.
+ */
+
+static void run_path( struct crcsum_worker_tp *w, struct crcsum_task_tp *task ) {
+
+	int retval;
+	struct stat st;
+	struct crcsum_entry_tp *entry;
+
+	if ( task->entry != NULL ) { run_file( w, task->entry ); return; }
+
+	if ( strcmp( task->path, "-" ) ) {
+
+		retval = ( task->top ) ? stat( task->path, & st ) : lstat( task->path, & st );
+
+		if ( retval != 0 ) { report_error( task->path, errno ); return; }
+
+		if ( S_ISDIR( st.st_mode ) ) { run_dir( w, task->path ); return; }
+
+		if ( ! task->top  &&  ! S_ISREG( st.st_mode ) ) return;
+	}
+
+	entry = add_entry( task->path, algo_mask );
+	if ( entry == NULL ) { report_error( task->path, ENOMEM ); return; }
+
+	task->path = NULL;
+
+	run_file( w, entry );
+
+}  /* run_path */
+
+/*
+ * static void run_dir( struct crcsum_worker_tp *w, const char *path );
+ *
+ * The function run_dir() queues a path task for every entry of a directory
+ * in the queue of the current worker, where idle workers can steal them.
+ */
+
+static void run_dir( struct crcsum_worker_tp *w, const char *path ) {
+
+	DIR *dir;
+	struct dirent *de;
+	size_t len;
+	size_t sep;
+	size_t name_len;
+	struct crcsum_task_tp *task;
+
+	dir = opendir( path );
+	if ( dir == NULL ) { report_error( path, errno ); return; }
+
+	len = strlen( path );
+	while ( len > 1  &&  path[len-1] == '/' ) len--;
+	sep = ( path[len-1] == '/' ) ? 0 : 1;
+
+	while ( ( de = readdir( dir ) ) != NULL ) {
+
+		if ( ! strcmp( de->d_name, "." )  ||  ! strcmp( de->d_name, ".." ) ) continue;
+
+		name_len = strlen( de->d_name );
+		task     = calloc( 1, sizeof( struct crcsum_task_tp ) );
+		if ( task != NULL ) task->path = malloc( len + sep + name_len + 1 );
+
+		if ( task == NULL  ||  task->path == NULL ) {
+
+			free( task );
+			report_error( path, ENOMEM );
+			break;
+		}
+
+		memcpy( task->path, path, len );
+		task->path[len] = '/';
+		memcpy( task->path + len + sep, de->d_name, name_len + 1 );
+
+		task->type = CRCSUM_TASK_PATH;
+
+		pool_push( w, task );
+	}
+
+	closedir( dir );
+
+}  /* run_dir */
+
+/*
+ * static void run_file( struct crcsum_worker_tp *w, struct crcsum_entry_tp *entry );
+ *
+ * The function run_file() calculates the CRC values of a file. Small files
+ * are calculated at once. A large regular file is split in segments and all
+ * segments except the first are queued, so that idle workers can steal them
+ * while the current worker calculates the first segment.
+ */
+
+static void run_file( struct crcsum_worker_tp *w, struct crcsum_entry_tp *entry ) {
+
+	int fd;
+	size_t a;
+	struct stat st;
+	struct crcsum_file_tp *file;
+	struct crcsum_task_tp *task;
+
+	if ( ! strcmp( entry->path, "-" ) ) {
+
+		entry->error = calc_read( STDIN_FILENO, 0, 0, false, entry->mask, entry->crc );
+		return;
+	}
+
+	fd = open( entry->path, O_RDONLY );
+	if ( fd < 0 ) { entry->error = errno; return; }
+
+	if      ( fstat( fd, & st ) != 0     ) entry->error = errno;
+	else if ( S_ISDIR( st.st_mode )      ) entry->error = EISDIR;
+	else if ( ! S_ISREG( st.st_mode )    ) entry->error = calc_read( fd, 0, 0, false, entry->mask, entry->crc );
+	else if ( st.st_size > CRCSUM_SPLIT_SIZE  &&  num_workers > 1 ) {
+
+		file = calloc( 1, sizeof( struct crcsum_file_tp ) );
+
+		if ( file != NULL ) {
+
+			file->entry     = entry;
+			file->fd        = fd;
+			file->size      = st.st_size;
+			file->num_seg   = (size_t) ( ( st.st_size + CRCSUM_SEGMENT_SIZE - 1 ) / CRCSUM_SEGMENT_SIZE );
+			file->remaining = file->num_seg;
+			file->seg_crc   = calloc( file->num_seg, sizeof( file->seg_crc[0] ) );
+
+			if ( file->seg_crc != NULL ) {
+
+				for (a=1; a<file->num_seg; a++) {
+
+					task = calloc( 1, sizeof( struct crcsum_task_tp ) );
+
+					if ( task == NULL ) { run_segment( file, a ); continue; }
+
+					task->type = CRCSUM_TASK_SEGMENT;
+					task->file = file;
+					task->seg  = a;
+
+					pool_push( w, task );
+				}
+
+				run_segment( file, 0 );
+				return;
+			}
+
+			free( file );
+		}
+
+		entry->error = calc_range( fd, 0, st.st_size, entry->mask, entry->crc );
+	}
+
+	else entry->error = calc_range( fd, 0, st.st_size, entry->mask, entry->crc );
+
+	close( fd );
+
+}  /* run_file */
+
+/*
+ * static void run_segment( struct crcsum_file_tp *file, size_t seg );
+ *
+ * The function run_segment() calculates the CRC values of one segment of a
+ * large file. The thread which finishes the last segment merges the values
+ * of all segments in order with the combine functions of the library and
+ * closes the file.
+ */
+
+static void run_segment( struct crcsum_file_tp *file, size_t seg ) {
+
+	int error;
+	bool last;
+	off_t offset;
+	off_t num_bytes;
+	size_t a;
+	size_t b;
+	uint64_t crc;
+	enum crc_algo algo;
+	struct crcsum_entry_tp *entry;
+
+	entry     = file->entry;
+	offset    = (off_t) seg * CRCSUM_SEGMENT_SIZE;
+	num_bytes = file->size - offset;
+	if ( num_bytes > CRCSUM_SEGMENT_SIZE ) num_bytes = CRCSUM_SEGMENT_SIZE;
+
+	error = calc_range( file->fd, offset, num_bytes, entry->mask, file->seg_crc[seg] );
+
+	pthread_mutex_lock( & file_lock );
+
+	if ( error != 0  &&  file->error == 0 ) file->error = error;
+	last = ( --file->remaining == 0 );
+
+	pthread_mutex_unlock( & file_lock );
+
+	if ( ! last ) return;
+
+	entry->error = file->error;
+
+	for (a=0; a<CRCSUM_NUM_ALGOS  &&  entry->error == 0; a++) {
+
+		algo = crcsum_algos[a].algo;
+		if ( ! ( entry->mask & CRC_ALGO_MASK( algo ) ) ) continue;
+
+		crc = file->seg_crc[0][algo];
+
+		for (b=1; b<file->num_seg; b++) {
+
+			num_bytes = file->size - (off_t) b * CRCSUM_SEGMENT_SIZE;
+			if ( num_bytes > CRCSUM_SEGMENT_SIZE ) num_bytes = CRCSUM_SEGMENT_SIZE;
+
+			crc = crcsum_algos[a].combine( crc, file->seg_crc[b][algo], (size_t) num_bytes );
+		}
+
+		entry->crc[algo] = crc;
+	}
+
+	close( file->fd );
+	free( file->seg_crc );
+	free( file );
+
+}  /* run_segment */
+
+/*
+ * static int calc_range( int fd, off_t offset, off_t num_bytes, uint32_t mask, uint64_t results[CRC_ALGO_NUM] );
+ *
+ * The function calc_range() calculates the CRC values of a range of a
+ * regular file. The range is mapped in memory with a hint that it is read
+ * sequentially and passed to crc_multi() at once. When the range cannot be
+ * mapped it is read in blocks. The function returns 0 or an error number.
+ */
+
+static int calc_range( int fd, off_t offset, off_t num_bytes, uint32_t mask, uint64_t results[CRC_ALGO_NUM] ) {
+
+	void *map;
+	static const unsigned char empty[1] = { 0 };
+
+	if ( num_bytes == 0 ) {
+
+		crc_multi( empty, 0, mask, results );
+		return 0;
+	}
+
+	if ( (uintmax_t) num_bytes <= (uintmax_t) SIZE_MAX ) {
+
+		map = mmap( NULL, (size_t) num_bytes, PROT_READ, MAP_PRIVATE, fd, offset );
+
+		if ( map != MAP_FAILED ) {
+
+#if defined(MADV_SEQUENTIAL)
+			madvise( map, (size_t) num_bytes, MADV_SEQUENTIAL );
+#endif
+			crc_multi( (const unsigned char *) map, (size_t) num_bytes, mask, results );
+			munmap( map, (size_t) num_bytes );
+
+			return 0;
+		}
+	}
+
+	return calc_read( fd, offset, num_bytes, true, mask, results );
+
+}  /* calc_range */
+
+/*
+ * static int calc_read( int fd, off_t offset, off_t num_bytes, bool bounded, uint32_t mask, uint64_t results[CRC_ALGO_NUM] );
+ *
+ * The function calc_read() reads a file in blocks and passes every block to
+ * the streaming routines of all algorithms in the mask. When bounded is true
+ * num_bytes bytes are read from offset with pread(), otherwise the file is
+ * read with read() until the end, which also works for pipes. The function
+ * returns 0 or an error number.
+ */
+
+static int calc_read( int fd, off_t offset, off_t num_bytes, bool bounded, uint32_t mask, uint64_t results[CRC_ALGO_NUM] ) {
+
+	int a;
+	int error;
+	int num_algo;
+	size_t want;
+	ssize_t num_read;
+	unsigned char *buffer;
+	struct crc_ctx ctx[CRC_ALGO_NUM];
+
+	buffer = malloc( CRCSUM_READ_SIZE );
+	if ( buffer == NULL ) return ENOMEM;
+
+	num_algo = 0;
+
+	for (a=0; a<CRC_ALGO_NUM; a++) {
+
+		if ( mask & CRC_ALGO_MASK( a ) ) crc_init( & ctx[num_algo++], (enum crc_algo) a );
+	}
+
+	error = 0;
+
+	for (;;) {
+
+		want = CRCSUM_READ_SIZE;
+
+		if ( bounded ) {
+
+			if ( num_bytes <= 0 ) break;
+			if ( num_bytes < (off_t) want ) want = (size_t) num_bytes;
+
+			num_read = pread( fd, buffer, want, offset );
+		}
+
+		else num_read = read( fd, buffer, want );
+
+		if ( num_read < 0  &&  errno == EINTR ) continue;
+		if ( num_read < 0 ) { error = errno; break; }
+
+		if ( num_read == 0 ) {
+
+			if ( bounded ) error = EIO;
+			break;
+		}
+
+		for (a=0; a<num_algo; a++) crc_update( & ctx[a], buffer, (size_t) num_read );
+
+		offset    += num_read;
+		num_bytes -= num_read;
+	}
+
+	for (a=0; a<num_algo; a++) results[ctx[a].algo] = crc_final( & ctx[a] );
+
+	free( buffer );
+
+	return error;
+
+}  /* calc_read */
+
+/*
+ * static void pool_push( struct crcsum_worker_tp *w, struct crcsum_task_tp *task );
+ *
+ * The function pool_push() adds a task at the tail of the queue of a worker
+ * and wakes an idle worker. The task is counted before it is queued, so that
+ * a thread which steals and finishes it at once cannot see the pool as done
+ * while the task which queued it is still running. When the queue cannot
+ * grow the task is run directly by the calling thread.
+ */
+
+static void pool_push( struct crcsum_worker_tp *w, struct crcsum_task_tp *task ) {
+
+	size_t a;
+	size_t new_capacity;
+	struct crcsum_task_tp **new_tasks;
+
+	pthread_mutex_lock( & pool_lock );
+
+	pool_queued++;
+	pool_pending++;
+
+	pthread_mutex_unlock( & pool_lock );
+
+	pthread_mutex_lock( & w->lock );
+
+	if ( w->tail - w->head == w->capacity ) {
+
+		new_capacity = ( w->capacity > 0 ) ? 2 * w->capacity : 64;
+		new_tasks    = malloc( new_capacity * sizeof( new_tasks[0] ) );
+
+		if ( new_tasks == NULL ) {
+
+			pthread_mutex_unlock( & w->lock );
+
+			pthread_mutex_lock( & pool_lock );
+			pool_queued--;
+			pthread_mutex_unlock( & pool_lock );
+
+			run_task( w, task );
+			pool_done();
+			return;
+		}
+
+		for (a=w->head; a!=w->tail; a++) new_tasks[a & (new_capacity-1)] = w->tasks[a & (w->capacity-1)];
+
+		free( w->tasks );
+
+		w->tasks    = new_tasks;
+		w->capacity = new_capacity;
+	}
+
+	w->tasks[w->tail++ & (w->capacity-1)] = task;
+
+	pthread_mutex_unlock( & w->lock );
+
+	pthread_mutex_lock( & pool_lock );
+	if ( pool_idle > 0 ) pthread_cond_signal( & pool_wake );
+	pthread_mutex_unlock( & pool_lock );
+
+}  /* pool_push */
+
+/*
+ * static struct crcsum_task_tp *pool_take( struct crcsum_worker_tp *w );
+ *
+ * The function pool_take() returns the newest task of the own queue of a
+ * worker. When that queue is empty the oldest task of another worker is
+ * stolen. Old tasks are usually the largest, like the directories near the
+ * top of a tree. NULL is returned when no queue has a task.
+ */
+
+static struct crcsum_task_tp *pool_take( struct crcsum_worker_tp *w ) {
+
+	int a;
+	struct crcsum_worker_tp *victim;
+	struct crcsum_task_tp *task;
+
+	task = NULL;
+
+	pthread_mutex_lock( & w->lock );
+	if ( w->tail != w->head ) task = w->tasks[--w->tail & (w->capacity-1)];
+	pthread_mutex_unlock( & w->lock );
+
+	for (a=1; task == NULL  &&  a<num_workers; a++) {
+
+		victim = & workers[(w->id + a) % num_workers];
+
+		pthread_mutex_lock( & victim->lock );
+		if ( victim->tail != victim->head ) task = victim->tasks[victim->head++ & (victim->capacity-1)];
+		pthread_mutex_unlock( & victim->lock );
+	}
+
+	if ( task != NULL ) {
+
+		pthread_mutex_lock( & pool_lock );
+		pool_queued--;
+		pthread_mutex_unlock( & pool_lock );
+	}
+
+	return task;
+
+}  /* pool_take */
+
+/*
+ * static void pool_done( void );
+ *
+ * The function pool_done() marks a task as finished. When no work is left
+ * all idle workers are woken, so that they can stop.
+ */
+
+static void pool_done( void ) {
+
+	pthread_mutex_lock( & pool_lock );
+
+	if ( --pool_pending == 0 ) pthread_cond_broadcast( & pool_wake );
+
+	pthread_mutex_unlock( & pool_lock );
+
+}  /* pool_done */
+
+/*
+ * static void *pool_worker( void *arg );
+ *
+ * The function pool_worker() is the main loop of a worker thread. It runs
+ * tasks until all queues are empty and no running task can add new work.
+ */
+
+static void *pool_worker( void *arg ) {
+
+	bool finished;
+	struct crcsum_worker_tp *w;
+	struct crcsum_task_tp *task;
+
+	w = arg;
+
+	for (;;) {
+
+		task = pool_take( w );
+
+		if ( task != NULL ) {
+
+			run_task( w, task );
+			pool_done();
+			continue;
+		}
+
+		pthread_mutex_lock( & pool_lock );
+
+		while ( pool_queued == 0  &&  pool_pending > 0 ) {
+
+			pool_idle++;
+			pthread_cond_wait( & pool_wake, & pool_lock );
+			pool_idle--;
+		}
+
+		finished = ( pool_pending == 0 );
+
+		pthread_mutex_unlock( & pool_lock );
+
+		if ( finished ) break;
+	}
+
+	return NULL;
+
+}  /* pool_worker */
+
+#else
+
+/*
+ * int main( void );
+ *
+ * The crcsum program uses POSIX threads and directory functions. On other
+ * systems only a message is printed.
+ */
+
+int main( void ) {
+
+	fprintf( stderr, "crcsum: this program requires a POSIX system\n" );
+
+	return 2;
+
+}  /* main (crcsum.c) */
+
+#endif
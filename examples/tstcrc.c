@@ -32,6 +32,12 @@
  * of data. The program calculates the three different CRC's for a file who's
  * name is either provided at the command line, or data typed in right the
  * program has started.
+ *
+ * All CRC values are calculated in one pass over the data with crc_multi().
+ * Regular files are mapped in memory where the operating system supports it,
+ * so that the bulk kernels of the library can run over the whole file. Pipes
+ * and other files which cannot be mapped are read in blocks and passed to the
+ * streaming interface.
  */
 
 #include <inttypes.h>
@@ -41,10 +47,38 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if ! defined(_WIN32)
+#define TSTCRC_HAVE_MMAP
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include "../include/checksum.h"
 
 #define MAX_STRING_SIZE	2048
 
+/*
+ * #define TSTCRC_xxxx
+ *
+ * TSTCRC_ALGOS is the set of algorithms printed by the program. Files which
+ * cannot be mapped in memory are read in blocks of TSTCRC_READ_SIZE bytes,
+ * small enough to stay in the level 2 cache while every algorithm processes
+ * the block.
+ */
+
+#define TSTCRC_ALGOS		( CRC_ALGO_MASK(CRC_ALGO_16)         | CRC_ALGO_MASK(CRC_ALGO_MODBUS)      \
+				| CRC_ALGO_MASK(CRC_ALGO_SICK)       | CRC_ALGO_MASK(CRC_ALGO_XMODEM)      \
+				| CRC_ALGO_MASK(CRC_ALGO_CCITT_FFFF) | CRC_ALGO_MASK(CRC_ALGO_CCITT_1D0F)  \
+				| CRC_ALGO_MASK(CRC_ALGO_KERMIT)     | CRC_ALGO_MASK(CRC_ALGO_DNP)         \
+				| CRC_ALGO_MASK(CRC_ALGO_32) )
+#define TSTCRC_READ_SIZE	(64*1024)
+
+static bool		calc_file( const char *name, uint64_t results[CRC_ALGO_NUM] );
+static bool		calc_read( FILE *fp, int fd, uint64_t results[CRC_ALGO_NUM] );
+
 /*
  * int main( int argc, char *argv[] );
  *
@@ -58,24 +92,12 @@ int main( int argc, char *argv[] ) {
 	char input_string[MAX_STRING_SIZE];
 	unsigned char *ptr;
 	unsigned char *dest;
-	unsigned char hex_val;
-	unsigned char prev_byte;
-	uint16_t crc_16_val;
-	uint16_t crc_16_modbus_val;
-	uint16_t crc_ccitt_ffff_val;
-	uint16_t crc_ccitt_0000_val;
-	uint16_t crc_ccitt_1d0f_val;
-	uint16_t crc_dnp_val;
-	uint16_t crc_sick_val;
-	uint16_t crc_kermit_val;
-	uint32_t crc_32_val;
-	uint16_t low_byte;
-	uint16_t high_byte;
+	size_t num_bytes;
+	uint64_t results[CRC_ALGO_NUM];
 	int a;
-	int ch;
 	bool do_ascii;
 	bool do_hex;
-	FILE *fp;
+	bool valid;
 
 	do_ascii = false;
 	do_hex   = false;
@@ -88,7 +110,8 @@ int main( int argc, char *argv[] ) {
 		printf( "    -a Program asks for ASCII input. Following parameters ignored.\n" );
 		printf( "    -x Program asks for hexadecimal input. Following parameters ignored.\n" );
 		printf( "       All other parameters are treated like filenames. The CRC values\n" );
-		printf( "       for each separate file will be calculated.\n" );
+		printf( "       for each separate file will be calculated. The filename - reads\n" );
+		printf( "       the data from stdin.\n" );
 
 		exit( 0 );
 	}
@@ -102,6 +125,7 @@ int main( int argc, char *argv[] ) {
 		if( fgets( input_string, MAX_STRING_SIZE-1, stdin ) == NULL ){
                    // Print the error
                    perror("Error");
+                   input_string[0] = 0;
                 }
 	}
 
@@ -112,6 +136,8 @@ int main( int argc, char *argv[] ) {
 		*ptr = 0;
 	}
 
+	num_bytes = 0;
+
 	if ( do_hex ) {
 
 		ptr  = (unsigned char *) input_string;
@@ -126,149 +152,195 @@ int main( int argc, char *argv[] ) {
 			ptr++;
 		}
 
-		* dest    = '\x80';
-		*(dest+1) = '\x80';
+		ptr = (unsigned char *) input_string;
+
+		while ( ptr + 1 < dest ) {
+
+			input_string[num_bytes++] = (char) ( ( ptr[0] << 4 ) | ptr[1] );
+			ptr += 2;
+		}
+
+		if ( ptr < dest ) input_string[num_bytes++] = (char) ( ptr[0] << 4 );
 	}
 
 	a = 1;
 
 	do {
 
-		crc_16_val         = 0x0000;
-		crc_16_modbus_val  = 0xffff;
-		crc_dnp_val        = 0x0000;
-		crc_sick_val       = 0x0000;
-		crc_ccitt_0000_val = 0x0000;
-		crc_ccitt_ffff_val = 0xffff;
-		crc_ccitt_1d0f_val = 0x1d0f;
-		crc_kermit_val     = 0x0000;
-		crc_32_val         = 0xffffffffL;
+		valid = true;
 
+		if      ( do_ascii ) crc_multi( (unsigned char *) input_string, strlen( input_string ), TSTCRC_ALGOS, results );
 
+		else if ( do_hex ) {
 
-		if ( do_ascii ) {
+			crc_multi( (unsigned char *) input_string, num_bytes, TSTCRC_ALGOS, results );
+			input_string[0] = 0;
+		}
 
-			prev_byte = 0;
-			ptr       = (unsigned char *) input_string;
+		else if ( ! calc_file( argv[a], results ) ) {
 
-			while ( *ptr ) {
+			printf( "%s : cannot open file\n", argv[a] );
+			valid = false;
+		}
 
-				crc_16_val         = update_crc_16(     crc_16_val,         *ptr            );
-				crc_16_modbus_val  = update_crc_16(     crc_16_modbus_val,  *ptr            );
-				crc_dnp_val        = update_crc_dnp(    crc_dnp_val,        *ptr            );
-				crc_sick_val       = update_crc_sick(   crc_sick_val,       *ptr, prev_byte );
-				crc_ccitt_0000_val = update_crc_ccitt(  crc_ccitt_0000_val, *ptr            );
-				crc_ccitt_ffff_val = update_crc_ccitt(  crc_ccitt_ffff_val, *ptr            );
-				crc_ccitt_1d0f_val = update_crc_ccitt(  crc_ccitt_1d0f_val, *ptr            );
-				crc_kermit_val     = update_crc_kermit( crc_kermit_val,     *ptr            );
-				crc_32_val         = update_crc_32(     crc_32_val,         *ptr            );
+		if ( valid ) printf( "%s%s%s :\nCRC16              = 0x%04" PRIX64 "      /  %" PRIu64 "\n"
+					     "CRC16 (Modbus)     = 0x%04" PRIX64 "      /  %" PRIu64 "\n"
+					     "CRC16 (Sick)       = 0x%04" PRIX64 "      /  %" PRIu64 "\n"
+					     "CRC-CCITT (0x0000) = 0x%04" PRIX64 "      /  %" PRIu64 "\n"
+					     "CRC-CCITT (0xffff) = 0x%04" PRIX64 "      /  %" PRIu64 "\n"
+					     "CRC-CCITT (0x1d0f) = 0x%04" PRIX64 "      /  %" PRIu64 "\n"
+					     "CRC-CCITT (Kermit) = 0x%04" PRIX64 "      /  %" PRIu64 "\n"
+					     "CRC-DNP            = 0x%04" PRIX64 "      /  %" PRIu64 "\n"
+					     "CRC32              = 0x%08" PRIX64 "  /  %" PRIu64 "\n"
+				, (   do_ascii  ||    do_hex ) ? "\""    : ""
+				, ( ! do_ascii  &&  ! do_hex ) ? argv[a] : input_string
+				, (   do_ascii  ||    do_hex ) ? "\""    : ""
+				, results[CRC_ALGO_16],         results[CRC_ALGO_16]
+				, results[CRC_ALGO_MODBUS],     results[CRC_ALGO_MODBUS]
+				, results[CRC_ALGO_SICK],       results[CRC_ALGO_SICK]
+				, results[CRC_ALGO_XMODEM],     results[CRC_ALGO_XMODEM]
+				, results[CRC_ALGO_CCITT_FFFF], results[CRC_ALGO_CCITT_FFFF]
+				, results[CRC_ALGO_CCITT_1D0F], results[CRC_ALGO_CCITT_1D0F]
+				, results[CRC_ALGO_KERMIT],     results[CRC_ALGO_KERMIT]
+				, results[CRC_ALGO_DNP],        results[CRC_ALGO_DNP]
+				, results[CRC_ALGO_32],         results[CRC_ALGO_32]     );
 
-				prev_byte = *ptr;
-				ptr++;
-			}
-		}
+		a++;
 
-		else if ( do_hex ) {
+	} while ( a < argc );
 
-			prev_byte = 0;
-			ptr       = (unsigned char *) input_string;
+	return 0;
 
-			while ( *ptr != '\x80' ) {
+}  /* main (tstcrc.c) */
 
-				hex_val  = (unsigned char) ( ( * ptr     &  '\x0f' ) << 4 );
-				hex_val |= (unsigned char) ( ( *(ptr+1)  &  '\x0f' )      );
+/*
+ * static bool calc_file( const char *name, uint64_t results[CRC_ALGO_NUM] );
+ *
+ * The function calc_file() calculates the CRC values of the contents of a
+ * file. A regular file is mapped in memory with a hint to the kernel that it
+ * will be read sequentially, which lets the kernel read ahead aggressively.
+ * Pipes, devices and files which cannot be mapped are read in blocks. The
+ * name - stands for stdin. The function returns false if the file cannot be
+ * opened or read.
+ */
 
-				crc_16_val         = update_crc_16(     crc_16_val,         hex_val            );
-				crc_16_modbus_val  = update_crc_16(     crc_16_modbus_val,  hex_val            );
-				crc_dnp_val        = update_crc_dnp(    crc_dnp_val,        hex_val            );
-				crc_sick_val       = update_crc_sick(   crc_sick_val,       hex_val, prev_byte );
-				crc_ccitt_0000_val = update_crc_ccitt(  crc_ccitt_0000_val, hex_val            );
-				crc_ccitt_ffff_val = update_crc_ccitt(  crc_ccitt_ffff_val, hex_val            );
-				crc_ccitt_1d0f_val = update_crc_ccitt(  crc_ccitt_1d0f_val, hex_val            );
-				crc_kermit_val     = update_crc_kermit( crc_kermit_val,     hex_val            );
-				crc_32_val         = update_crc_32(     crc_32_val,         hex_val            );
+static bool calc_file( const char *name, uint64_t results[CRC_ALGO_NUM] ) {
 
-				prev_byte = hex_val;
-				ptr      += 2;
-			}
+	bool retval;
+#if defined(TSTCRC_HAVE_MMAP)
+	int fd;
+	size_t num_bytes;
+	void *map;
+	struct stat st;
 
-			input_string[0] = 0;
+	if ( ! strcmp( name, "-" ) ) fd = STDIN_FILENO;
+	else                         fd = open( name, O_RDONLY );
+
+	if ( fd < 0 ) return false;
+
+	if ( fstat( fd, & st ) == 0  &&  S_ISREG( st.st_mode )  &&  st.st_size > 0  &&  (uintmax_t) st.st_size <= (uintmax_t) SIZE_MAX ) {
+
+		num_bytes = (size_t) st.st_size;
+		map       = mmap( NULL, num_bytes, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+		if ( map != MAP_FAILED ) {
+
+#if defined(MADV_SEQUENTIAL)
+			madvise( map, num_bytes, MADV_SEQUENTIAL );
+#endif
+			crc_multi( (const unsigned char *) map, num_bytes, TSTCRC_ALGOS, results );
+			munmap( map, num_bytes );
+
+			if ( fd != STDIN_FILENO ) close( fd );
+
+			return true;
 		}
+	}
 
-		else {
+	retval = calc_read( NULL, fd, results );
+
+	if ( fd != STDIN_FILENO ) close( fd );
+#else
+	FILE *fp;
 
-			prev_byte = 0;
+	if ( ! strcmp( name, "-" ) ) fp = stdin;
+	else {
 #if defined(_MSC_VER)
-			fp = NULL;
-			fopen_s( & fp, argv[a], "rb" );
+		fp = NULL;
+		fopen_s( & fp, name, "rb" );
 #else
-			fp = fopen( argv[a], "rb" );
+		fp = fopen( name, "rb" );
 #endif
+	}
 
-			if ( fp != NULL ) {
+	if ( fp == NULL ) return false;
 
-				while( ( ch=fgetc( fp ) ) != EOF ) {
+	retval = calc_read( fp, -1, results );
 
-					crc_16_val         = update_crc_16(     crc_16_val,         (unsigned char) ch            );
-					crc_16_modbus_val  = update_crc_16(     crc_16_modbus_val,  (unsigned char) ch            );
-					crc_dnp_val        = update_crc_dnp(    crc_dnp_val,        (unsigned char) ch            );
-					crc_sick_val       = update_crc_sick(   crc_sick_val,       (unsigned char) ch, prev_byte );
-					crc_ccitt_0000_val = update_crc_ccitt(  crc_ccitt_0000_val, (unsigned char) ch            );
-					crc_ccitt_ffff_val = update_crc_ccitt(  crc_ccitt_ffff_val, (unsigned char) ch            );
-					crc_ccitt_1d0f_val = update_crc_ccitt(  crc_ccitt_1d0f_val, (unsigned char) ch            );
-					crc_kermit_val     = update_crc_kermit( crc_kermit_val,     (unsigned char) ch            );
-					crc_32_val         = update_crc_32(     crc_32_val,         (unsigned char) ch            );
+	if ( fp != stdin ) fclose( fp );
+#endif
 
-					prev_byte = (unsigned char) ch;
-				}
+	return retval;
 
-				fclose( fp );
-			}
+}  /* calc_file */
 
-			else printf( "%s : cannot open file\n", argv[a] );
-		}
+/*
+ * static bool calc_read( FILE *fp, int fd, uint64_t results[CRC_ALGO_NUM] );
+ *
+ * The function calc_read() reads a file in blocks and passes every block to
+ * the streaming routines of all algorithms before the next block is read.
+ * Where the POSIX interface is available the file descriptor fd is used,
+ * otherwise the stream fp.
+ */
 
-		crc_32_val        ^= 0xffffffffL;
-
-		crc_dnp_val    = ~crc_dnp_val;
-		low_byte       = (crc_dnp_val    & 0xff00) >> 8;
-		high_byte      = (crc_dnp_val    & 0x00ff) << 8;
-		crc_dnp_val    = low_byte | high_byte;
-
-		low_byte       = (crc_sick_val   & 0xff00) >> 8;
-		high_byte      = (crc_sick_val   & 0x00ff) << 8;
-		crc_sick_val   = low_byte | high_byte;
-
-		low_byte       = (crc_kermit_val & 0xff00) >> 8;
-		high_byte      = (crc_kermit_val & 0x00ff) << 8;
-		crc_kermit_val = low_byte | high_byte;
-
-		printf( "%s%s%s :\nCRC16              = 0x%04" PRIX16 "      /  %" PRIu16 "\n"
-				  "CRC16 (Modbus)     = 0x%04" PRIX16 "      /  %" PRIu16 "\n"
-				  "CRC16 (Sick)       = 0x%04" PRIX16 "      /  %" PRIu16 "\n"
-				  "CRC-CCITT (0x0000) = 0x%04" PRIX16 "      /  %" PRIu16 "\n"
-				  "CRC-CCITT (0xffff) = 0x%04" PRIX16 "      /  %" PRIu16 "\n"
-				  "CRC-CCITT (0x1d0f) = 0x%04" PRIX16 "      /  %" PRIu16 "\n"
-				  "CRC-CCITT (Kermit) = 0x%04" PRIX16 "      /  %" PRIu16 "\n"
-				  "CRC-DNP            = 0x%04" PRIX16 "      /  %" PRIu16 "\n"
-				  "CRC32              = 0x%08" PRIX32 "  /  %" PRIu32 "\n"
-				, (   do_ascii  ||    do_hex ) ? "\""    : ""
-				, ( ! do_ascii  &&  ! do_hex ) ? argv[a] : input_string
-				, (   do_ascii  ||    do_hex ) ? "\""    : ""
-				, crc_16_val,         crc_16_val
-				, crc_16_modbus_val,  crc_16_modbus_val
-				, crc_sick_val,       crc_sick_val
-				, crc_ccitt_0000_val, crc_ccitt_0000_val
-				, crc_ccitt_ffff_val, crc_ccitt_ffff_val
-				, crc_ccitt_1d0f_val, crc_ccitt_1d0f_val
-				, crc_kermit_val,     crc_kermit_val
-				, crc_dnp_val,        crc_dnp_val
-				, crc_32_val,         crc_32_val     );
+static bool calc_read( FILE *fp, int fd, uint64_t results[CRC_ALGO_NUM] ) {
 
-		a++;
+	int a;
+	int algo;
+	int num_algo;
+	size_t len;
+	unsigned char *buffer;
+	struct crc_ctx ctx[CRC_ALGO_NUM];
 
-	} while ( a < argc );
+	buffer = malloc( TSTCRC_READ_SIZE );
+	if ( buffer == NULL ) return false;
 
-	return 0;
+	num_algo = 0;
 
-}  /* main (tstcrc.c) */
+	for (algo=0; algo<CRC_ALGO_NUM; algo++) {
+
+		if ( TSTCRC_ALGOS & CRC_ALGO_MASK( algo ) ) crc_init( & ctx[num_algo++], (enum crc_algo) algo );
+	}
+
+	for (;;) {
+
+#if defined(TSTCRC_HAVE_MMAP)
+		ssize_t num_read;
+
+		(void) fp;
+
+		num_read = read( fd, buffer, TSTCRC_READ_SIZE );
+
+		if ( num_read < 0  &&  errno == EINTR ) continue;
+		if ( num_read < 0 ) { free( buffer ); return false; }
+
+		len = (size_t) num_read;
+#else
+		(void) fd;
+
+		len = fread( buffer, 1, TSTCRC_READ_SIZE, fp );
+
+		if ( len == 0  &&  ferror( fp ) ) { free( buffer ); return false; }
+#endif
+		if ( len == 0 ) break;
+
+		for (a=0; a<num_algo; a++) crc_update( & ctx[a], buffer, len );
+	}
+
+	for (a=0; a<num_algo; a++) results[ctx[a].algo] = crc_final( & ctx[a] );
+
+	free( buffer );
+
+	return true;
+
+}  /* calc_read */
@@ -34,6 +34,7 @@
 #ifndef DEF_LIBCRC_CHECKSUM_H
 #define DEF_LIBCRC_CHECKSUM_H
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -48,8 +49,13 @@ extern "C" {
  * known CRC calculations.
  */
 
+#define		CRC_POLY_8		0x31
+#define		CRC_POLY_8_AUTOSAR	0x2F
+#define		CRC_POLY_8_MAXIM	0x8C
+#define		CRC_POLY_8_SMBUS	0x07
 #define		CRC_POLY_16		0xA001
 #define		CRC_POLY_32		0xEDB88320ul
+#define		CRC_POLY_32C		0x82F63B78ul
 #define		CRC_POLY_64		0x42F0E1EBA9EA3693ull
 #define		CRC_POLY_CCITT		0x1021
 #define		CRC_POLY_DNP		0xA6BC
@@ -64,6 +70,9 @@ extern "C" {
  */
 
 #define		CRC_START_8		0x00
+#define		CRC_START_8_AUTOSAR	0xFF
+#define		CRC_START_8_MAXIM	0x00
+#define		CRC_START_8_SMBUS	0x00
 #define		CRC_START_16		0x0000
 #define		CRC_START_MODBUS	0xFFFF
 #define		CRC_START_XMODEM	0x0000
@@ -73,17 +82,107 @@ extern "C" {
 #define		CRC_START_SICK		0x0000
 #define		CRC_START_DNP		0x0000
 #define		CRC_START_32		0xFFFFFFFFul
+#define		CRC_START_32C		0xFFFFFFFFul
 #define		CRC_START_64_ECMA	0x0000000000000000ull
 #define		CRC_START_64_WE		0xFFFFFFFFFFFFFFFFull
 
+/*
+ * #define CRC_PARALLEL_MAX_THREADS
+ *
+ * The constant CRC_PARALLEL_MAX_THREADS is the maximum number of threads that
+ * the parallel CRC routines use for one calculation.
+ */
+
+#define		CRC_PARALLEL_MAX_THREADS	64
+
+/*
+ * enum crc_algo
+ *
+ * The enumeration crc_algo lists the CRC algorithms which can be calculated
+ * with the streaming interface crc_init(), crc_update() and crc_final().
+ */
+
+enum crc_algo {
+	CRC_ALGO_8,
+	CRC_ALGO_16,
+	CRC_ALGO_32,
+	CRC_ALGO_32C,
+	CRC_ALGO_64_ECMA,
+	CRC_ALGO_64_WE,
+	CRC_ALGO_CCITT_1D0F,
+	CRC_ALGO_CCITT_FFFF,
+	CRC_ALGO_DNP,
+	CRC_ALGO_KERMIT,
+	CRC_ALGO_MODBUS,
+	CRC_ALGO_SICK,
+	CRC_ALGO_XMODEM,
+	CRC_ALGO_8_AUTOSAR,
+	CRC_ALGO_8_MAXIM,
+	CRC_ALGO_8_SMBUS,
+	CRC_ALGO_NUM
+};
+
+/*
+ * #define CRC_ALGO_MASK, CRC_ALGO_ALL
+ *
+ * The macro CRC_ALGO_MASK() returns the bit which selects an algorithm in the
+ * algo_mask parameter of crc_multi(). The constant CRC_ALGO_ALL selects all
+ * algorithms.
+ */
+
+#define		CRC_ALGO_MASK(algo)		( ((uint32_t) 1) << (algo) )
+#define		CRC_ALGO_ALL			( CRC_ALGO_MASK(CRC_ALGO_NUM) - 1 )
+
+/*
+ * struct crc_ctx
+ *
+ * The structure crc_ctx holds the state of a streaming CRC calculation. The
+ * fields should only be accessed through the crc_init(), crc_update() and
+ * crc_final() functions.
+ */
+
+						/************************************************/
+struct crc_ctx {				/*						*/
+	enum crc_algo	algo;			/* The algorithm being calculated		*/
+	uint64_t	crc;			/* The CRC register before final processing	*/
+	unsigned char	prev_byte;		/* The last byte seen, used by the Sick CRC	*/
+};						/*						*/
+						/************************************************/
+
+/*
+ * struct crc_model
+ *
+ * The structure crc_model describes a CRC algorithm with the parameters of
+ * the Rocksoft model. The polynomial, start value and final XOR value are
+ * given in normal bit order, without the highest order term of the
+ * polynomial. The check value is the CRC of the ASCII string "123456789".
+ */
+
+						/************************************************/
+struct crc_model {				/*						*/
+	const char *	name;			/* Name of the algorithm			*/
+	int		width;			/* Number of bits of the CRC, 1 to 64		*/
+	uint64_t	poly;			/* Generator polynomial				*/
+	uint64_t	init;			/* Register value before the first byte	*/
+	bool		refin;			/* Bytes are processed LSB first		*/
+	bool		refout;			/* Register is reflected before the final XOR	*/
+	uint64_t	xorout;			/* Value XORed with the final register		*/
+	uint64_t	check;			/* CRC of the string "123456789"		*/
+};						/*						*/
+						/************************************************/
+
 /*
  * Prototype list of global functions
  */
 
 unsigned char *		checksum_NMEA(      const unsigned char *input_str, unsigned char *result  );
 uint8_t			crc_8(              const unsigned char *input_str, size_t num_bytes       );
+uint8_t			crc_8_autosar(      const unsigned char *input_str, size_t num_bytes       );
+uint8_t			crc_8_maxim(        const unsigned char *input_str, size_t num_bytes       );
+uint8_t			crc_8_smbus(        const unsigned char *input_str, size_t num_bytes       );
 uint16_t		crc_16(             const unsigned char *input_str, size_t num_bytes       );
 uint32_t		crc_32(             const unsigned char *input_str, size_t num_bytes       );
+uint32_t		crc_32c(            const unsigned char *input_str, size_t num_bytes       );
 uint64_t		crc_64_ecma(        const unsigned char *input_str, size_t num_bytes       );
 uint64_t		crc_64_we(          const unsigned char *input_str, size_t num_bytes       );
 uint16_t		crc_ccitt_1d0f(     const unsigned char *input_str, size_t num_bytes       );
@@ -93,10 +192,46 @@ uint16_t		crc_kermit(         const unsigned char *input_str, size_t num_bytes
 uint16_t		crc_modbus(         const unsigned char *input_str, size_t num_bytes       );
 uint16_t		crc_sick(           const unsigned char *input_str, size_t num_bytes       );
 uint16_t		crc_xmodem(         const unsigned char *input_str, size_t num_bytes       );
+uint8_t			crc_8_combine(          uint8_t  crc1, uint8_t  crc2, size_t len2 );
+uint16_t		crc_16_combine(         uint16_t crc1, uint16_t crc2, size_t len2 );
+uint32_t		crc_32_combine(         uint32_t crc1, uint32_t crc2, size_t len2 );
+uint32_t		crc_32c_combine(        uint32_t crc1, uint32_t crc2, size_t len2 );
+uint64_t		crc_64_ecma_combine(    uint64_t crc1, uint64_t crc2, size_t len2 );
+uint64_t		crc_64_we_combine(      uint64_t crc1, uint64_t crc2, size_t len2 );
+uint16_t		crc_ccitt_1d0f_combine( uint16_t crc1, uint16_t crc2, size_t len2 );
+uint16_t		crc_ccitt_ffff_combine( uint16_t crc1, uint16_t crc2, size_t len2 );
+uint16_t		crc_dnp_combine(        uint16_t crc1, uint16_t crc2, size_t len2 );
+uint16_t		crc_kermit_combine(     uint16_t crc1, uint16_t crc2, size_t len2 );
+uint16_t		crc_modbus_combine(     uint16_t crc1, uint16_t crc2, size_t len2 );
+uint16_t		crc_sick_combine(       uint16_t crc1, uint16_t crc2, size_t len2, unsigned char last_byte1 );
+uint16_t		crc_xmodem_combine(     uint16_t crc1, uint16_t crc2, size_t len2 );
+void			crc_16_batch(           const unsigned char *const bufs[], const size_t lens[], uint16_t out[], size_t n );
+void			crc_32_batch(           const unsigned char *const bufs[], const size_t lens[], uint32_t out[], size_t n );
+void			crc_32c_batch(          const unsigned char *const bufs[], const size_t lens[], uint32_t out[], size_t n );
+void			crc_64_ecma_batch(      const unsigned char *const bufs[], const size_t lens[], uint64_t out[], size_t n );
+void			crc_64_we_batch(        const unsigned char *const bufs[], const size_t lens[], uint64_t out[], size_t n );
+size_t			crc_8_verify(           const unsigned char *const msgs[], size_t num_bytes, const uint8_t  expected[], uint64_t failed[], size_t n );
+size_t			crc_modbus_verify(      const unsigned char *const msgs[], size_t num_bytes, const uint16_t expected[], uint64_t failed[], size_t n );
+bool			crc_multi(              const unsigned char *input_str, size_t num_bytes, uint32_t algo_mask, uint64_t results[CRC_ALGO_NUM] );
+uint32_t		crc_32_parallel(        const unsigned char *input_str, size_t num_bytes, int num_threads );
+uint64_t		crc_64_we_parallel(     const unsigned char *input_str, size_t num_bytes, int num_threads );
+uint64_t		crc_final(              const struct crc_ctx *ctx );
+uint64_t		crc_model_calc(         const struct crc_model *model, const unsigned char *input_str, size_t num_bytes );
+const struct crc_model *crc_model_find(         const char *name );
+const struct crc_model *crc_model_list(         size_t *num_models );
+uint64_t		crc_model_update(       const struct crc_model *model, uint64_t crc, const unsigned char *input_str, size_t num_bytes );
+bool			crc_init(               struct crc_ctx *ctx, enum crc_algo algo );
+void			crc_update(             struct crc_ctx *ctx, const unsigned char *input_str, size_t num_bytes );
+int			crc_parallel_split(     size_t num_bytes, int num_threads, size_t *chunk_bytes );
+void			crc_parallel_tune(      size_t min_chunk, int max_threads );
+bool			libcrc_autotune(        const char *cache_file );
+const char *		libcrc_get_impl(        void );
+bool			libcrc_set_impl(        const char *name );
 uint8_t			update_crc_8(       uint8_t  crc, unsigned char c                          );
 uint16_t		update_crc_16(      uint16_t crc, unsigned char c                          );
 uint32_t		update_crc_32(      uint32_t crc, unsigned char c                          );
-uint64_t		update_crc_64_ecma( uint64_t crc, unsigned char c                          );
+uint32_t		update_crc_32c(     uint32_t crc, unsigned char c                          );
+uint64_t		update_crc_64(      uint64_t crc, unsigned char c                          );
 uint16_t		update_crc_ccitt(   uint16_t crc, unsigned char c                          );
 uint16_t		update_crc_dnp(     uint16_t crc, unsigned char c                          );
 uint16_t		update_crc_kermit(  uint16_t crc, unsigned char c                          );
@@ -106,8 +241,18 @@ uint16_t		update_crc_sick(    uint16_t crc, unsigned char c, unsigned char prev_
  * Global CRC lookup tables
  */
 
+extern const uint8_t	crc_tab8[];
+extern const uint8_t	crc_tab8_autosar[];
+extern const uint8_t	crc_tab8_maxim[];
+extern const uint8_t	crc_tab8_smbus[];
+extern const uint16_t	crc_tab16[];
 extern const uint32_t	crc_tab32[];
+extern const uint32_t	crc_tab32c[];
 extern const uint64_t	crc_tab64[];
+extern const uint16_t	crc_tabccitt[];
+extern const uint16_t	crc_tabdnp[];
+extern const uint16_t	crc_tabkrmit[];
+extern const uint16_t	crc_tabsick[];
 
 #ifdef __cplusplus
 }// Extern C
@@ -0,0 +1,319 @@
+/*
+ * Library: libcrc
+ * File:    include/checksum.hpp
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2026 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The headerfile include/checksum.hpp contains a header-only C++ template for
+ * CRC calculations. The algorithm is selected with the template parameters of
+ * the Rocksoft model. The slicing-by-8 lookup tables are generated by the
+ * compiler, and all functions are constexpr, which allows the CRC of a string
+ * literal to be calculated during compilation. The header needs C++17. When
+ * it is compiled as C++20 the functions also accept a std::span.
+ */
+
+#ifndef DEF_LIBCRC_CHECKSUM_HPP
+#define DEF_LIBCRC_CHECKSUM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#if __cplusplus >= 202002L  &&  defined(__has_include)
+#if __has_include(<span>)
+#include <span>
+#define LIBCRC_HAVE_SPAN
+#endif
+#endif
+
+namespace libcrc {
+
+namespace detail {
+
+/*
+ * template <int Width> struct uint_for;
+ *
+ * The template uint_for selects the smallest unsigned integer type in which a
+ * CRC of the given number of bits fits.
+ */
+
+template <int Width> struct uint_for {
+	using type = std::conditional_t< ( Width <= 8 ), std::uint8_t,
+		     std::conditional_t< ( Width <= 16 ), std::uint16_t,
+		     std::conditional_t< ( Width <= 32 ), std::uint32_t, std::uint64_t > > >;
+};
+
+/*
+ * constexpr std::uint64_t reflect( std::uint64_t value, int bits );
+ *
+ * The function reflect() returns the lowest bits of a value in reversed bit
+ * order.
+ */
+
+constexpr std::uint64_t reflect( std::uint64_t value, int bits ) noexcept {
+
+	std::uint64_t result = 0;
+
+	for (int a=0; a<bits; a++) {
+
+		result = ( result << 1 ) | ( value & 1 );
+		value >>= 1;
+	}
+
+	return result;
+
+}  /* reflect */
+
+/*
+ * template <typename T> struct crc_tables;
+ *
+ * The structure crc_tables holds the eight lookup tables of the
+ * slicing-by-8 algorithm for one CRC register type.
+ */
+
+template <typename T> struct crc_tables {
+	T tab[8][256];
+};
+
+/*
+ * template <typename T, bool Reflected> constexpr crc_tables<T> make_tables( T poly );
+ *
+ * The function make_tables() generates the slicing-by-8 tables for a register
+ * of type T. A reflected register is kept in the low bits and shifts down, a
+ * non reflected register is aligned to the top bits and shifts up. Table 0 is
+ * the classic byte table, table k moves an entry of table k-1 over one more
+ * zero byte.
+ */
+
+template <typename T, bool Reflected> constexpr crc_tables<T> make_tables( T poly ) noexcept {
+
+	constexpr int bits = 8 * sizeof(T);
+	crc_tables<T> result{};
+
+	for (int i=0; i<256; i++) {
+
+		T crc = Reflected ? static_cast<T>( i ) : static_cast<T>( static_cast<std::uint64_t>( i ) << (bits-8) );
+
+		for (int b=0; b<8; b++) {
+
+			if ( Reflected ) crc = ( crc & 1 )                 ? static_cast<T>( ( crc >> 1 ) ^ poly ) : static_cast<T>( crc >> 1 );
+			else             crc = ( ( crc >> (bits-1) ) & 1 ) ? static_cast<T>( ( crc << 1 ) ^ poly ) : static_cast<T>( crc << 1 );
+		}
+
+		result.tab[0][i] = crc;
+	}
+
+	for (int a=1; a<8; a++) {
+
+		for (int i=0; i<256; i++) {
+
+			T crc = result.tab[a-1][i];
+
+			if ( Reflected ) result.tab[a][i] = static_cast<T>( ( crc >> 8 ) ^ result.tab[0][ crc & 0xFF ] );
+			else             result.tab[a][i] = static_cast<T>( static_cast<T>( crc << 8 ) ^ result.tab[0][ ( crc >> (bits-8) ) & 0xFF ] );
+		}
+	}
+
+	return result;
+
+}  /* make_tables */
+
+/*
+ * template <typename T, bool Reflected, T Poly> inline constexpr crc_tables<T> tables;
+ *
+ * One instance of the tables exists for each register type, bit order and
+ * polynomial, shared by all algorithms which only differ in their start
+ * value or final processing.
+ */
+
+template <typename T, bool Reflected, T Poly> inline constexpr crc_tables<T> tables = make_tables<T,Reflected>( Poly );
+
+/*
+ * template <typename Byte> constexpr std::uint64_t to_uint( Byte value );
+ *
+ * The function to_uint() converts a std::byte, char or unsigned char to an
+ * unsigned integer without sign extension.
+ */
+
+template <typename Byte> constexpr std::uint64_t to_uint( Byte value ) noexcept {
+
+	return static_cast<std::uint64_t>( static_cast<unsigned char>( value ) );
+
+}  /* to_uint */
+
+}  // namespace detail
+
+/*
+ * template <int Width, std::uint64_t Poly, std::uint64_t Init, bool RefIn, bool RefOut, std::uint64_t XorOut> class crc;
+ *
+ * The class template crc calculates a CRC of 1 to 64 bits described by the
+ * parameters of the Rocksoft model. The polynomial, start value and final XOR
+ * value are given in normal bit order, without the highest order term of the
+ * polynomial. The static member function compute() calculates the CRC of a
+ * buffer in one call. An object of the class holds the state of a streaming
+ * calculation which is fed with update() and read with value().
+ */
+
+template <int Width, std::uint64_t Poly, std::uint64_t Init, bool RefIn, bool RefOut, std::uint64_t XorOut>
+class crc {
+
+	static_assert( Width >= 1  &&  Width <= 64, "the width of a CRC must be between 1 and 64 bits" );
+
+public:
+	using value_type = typename detail::uint_for<Width>::type;
+
+	static constexpr int		width  = Width;
+	static constexpr std::uint64_t	poly   = Poly;
+	static constexpr std::uint64_t	init   = Init;
+	static constexpr bool		refin  = RefIn;
+	static constexpr bool		refout = RefOut;
+	static constexpr std::uint64_t	xorout = XorOut;
+
+	constexpr crc() noexcept : reg( start ) {}
+
+	constexpr void reset() noexcept { reg = start; }
+
+	constexpr crc & update( const std::byte *ptr, std::size_t num_bytes ) noexcept     { reg = block( reg, ptr, num_bytes ); return *this; }
+	constexpr crc & update( const unsigned char *ptr, std::size_t num_bytes ) noexcept { reg = block( reg, ptr, num_bytes ); return *this; }
+	constexpr crc & update( std::string_view str ) noexcept                            { reg = block( reg, str.data(), str.size() ); return *this; }
+
+	constexpr value_type value() const noexcept { return finish( reg ); }
+
+	static constexpr value_type compute( const std::byte *ptr, std::size_t num_bytes ) noexcept     { return finish( block( start, ptr, num_bytes ) ); }
+	static constexpr value_type compute( const unsigned char *ptr, std::size_t num_bytes ) noexcept { return finish( block( start, ptr, num_bytes ) ); }
+	static constexpr value_type compute( std::string_view str ) noexcept                            { return finish( block( start, str.data(), str.size() ) ); }
+
+#if defined(LIBCRC_HAVE_SPAN)
+	constexpr crc & update( std::span<const std::byte> data ) noexcept                { reg = block( reg, data.data(), data.size() ); return *this; }
+	static constexpr value_type compute( std::span<const std::byte> data ) noexcept   { return finish( block( start, data.data(), data.size() ) ); }
+#endif
+
+private:
+	static constexpr int		bits  = 8 * sizeof(value_type);
+	static constexpr std::uint64_t	mask  = 0xFFFFFFFFFFFFFFFFull >> (64 - Width);
+	static constexpr value_type	rpoly = RefIn ? static_cast<value_type>( detail::reflect( Poly & mask, Width ) )
+						      : static_cast<value_type>( ( Poly & mask ) << (bits - Width) );
+	static constexpr value_type	start = RefIn ? static_cast<value_type>( detail::reflect( Init & mask, Width ) )
+						      : static_cast<value_type>( ( Init & mask ) << (bits - Width) );
+
+	/*
+	 * template <typename Byte> static constexpr value_type block( value_type crc, const Byte *ptr, std::size_t num_bytes );
+	 *
+	 * The function block() updates the register with a buffer, eight bytes
+	 * at a time with the slicing-by-8 tables and the remaining bytes one at a
+	 * time. The bytes of a word are combined with shifts, which compilers
+	 * turn into a single load.
+	 */
+
+	template <typename Byte> static constexpr value_type block( value_type crc, const Byte *ptr, std::size_t num_bytes ) noexcept {
+
+		const auto &tab = detail::tables<value_type,RefIn,rpoly>.tab;
+
+		while ( num_bytes >= 8 ) {
+
+			if constexpr ( RefIn ) {
+
+				const std::uint64_t word = static_cast<std::uint64_t>( crc )
+				     ^ ( ( detail::to_uint( ptr[7] ) << 56 ) | ( detail::to_uint( ptr[6] ) << 48 ) | ( detail::to_uint( ptr[5] ) << 40 ) | ( detail::to_uint( ptr[4] ) << 32 )
+				     | ( detail::to_uint( ptr[3] ) << 24 ) | ( detail::to_uint( ptr[2] ) << 16 ) | ( detail::to_uint( ptr[1] ) <<  8 ) |   detail::to_uint( ptr[0] ) );
+
+				crc  = static_cast<value_type>( tab[7][  word        & 0xFF ] ^ tab[6][ (word >>  8) & 0xFF ]
+							  ^ tab[5][ (word >> 16) & 0xFF ] ^ tab[4][ (word >> 24) & 0xFF ]
+							  ^ tab[3][ (word >> 32) & 0xFF ] ^ tab[2][ (word >> 40) & 0xFF ]
+							  ^ tab[1][ (word >> 48) & 0xFF ] ^ tab[0][  word >> 56         ] );
+			}
+
+			else {
+
+				const std::uint64_t word = ( static_cast<std::uint64_t>( crc ) << (64 - bits) )
+				     ^ ( ( detail::to_uint( ptr[0] ) << 56 ) | ( detail::to_uint( ptr[1] ) << 48 ) | ( detail::to_uint( ptr[2] ) << 40 ) | ( detail::to_uint( ptr[3] ) << 32 )
+				     | ( detail::to_uint( ptr[4] ) << 24 ) | ( detail::to_uint( ptr[5] ) << 16 ) | ( detail::to_uint( ptr[6] ) <<  8 ) |   detail::to_uint( ptr[7] ) );
+
+				crc  = static_cast<value_type>( tab[7][  word >> 56         ] ^ tab[6][ (word >> 48) & 0xFF ]
+							  ^ tab[5][ (word >> 40) & 0xFF ] ^ tab[4][ (word >> 32) & 0xFF ]
+							  ^ tab[3][ (word >> 24) & 0xFF ] ^ tab[2][ (word >> 16) & 0xFF ]
+							  ^ tab[1][ (word >>  8) & 0xFF ] ^ tab[0][  word        & 0xFF ] );
+			}
+
+			ptr       += 8;
+			num_bytes -= 8;
+		}
+
+		while ( num_bytes-- > 0 ) {
+
+			if ( RefIn ) crc = static_cast<value_type>( ( static_cast<std::uint64_t>( crc ) >> 8 ) ^ tab[0][ ( crc ^ detail::to_uint( *ptr++ ) ) & 0xFF ] );
+			else         crc = static_cast<value_type>( ( static_cast<std::uint64_t>( crc ) << 8 ) ^ tab[0][ ( ( crc >> (bits-8) ) ^ detail::to_uint( *ptr++ ) ) & 0xFF ] );
+		}
+
+		return crc;
+
+	}  /* block */
+
+	/*
+	 * static constexpr value_type finish( value_type crc );
+	 *
+	 * The function finish() moves the register to the low bits, reflects it
+	 * when the input and output bit order differ and applies the final XOR.
+	 */
+
+	static constexpr value_type finish( value_type crc ) noexcept {
+
+		std::uint64_t result = RefIn ? static_cast<std::uint64_t>( crc ) : static_cast<std::uint64_t>( crc ) >> (bits - Width);
+
+		if ( RefIn != RefOut ) result = detail::reflect( result, Width );
+
+		return static_cast<value_type>( ( result ^ XorOut ) & mask );
+
+	}  /* finish */
+
+	value_type reg;
+};
+
+/*
+ * The algorithms of the C library which follow the Rocksoft model. The
+ * results are identical to those of the C functions with the same name.
+ * The C functions for DNP, Kermit and Sick return the CRC with the two bytes
+ * swapped and have no counterpart here.
+ */
+
+using crc8         = crc<  8, 0x31,               0x00,               false, false, 0x00               >;
+using crc8_autosar = crc<  8, 0x2F,               0xFF,               false, false, 0xFF               >;
+using crc8_maxim   = crc<  8, 0x31,               0x00,               true,  true,  0x00               >;
+using crc8_smbus   = crc<  8, 0x07,               0x00,               false, false, 0x00               >;
+using crc16        = crc< 16, 0x8005,             0x0000,             true,  true,  0x0000             >;
+using ccitt_1d0f   = crc< 16, 0x1021,             0x1D0F,             false, false, 0x0000             >;
+using ccitt_ffff   = crc< 16, 0x1021,             0xFFFF,             false, false, 0x0000             >;
+using modbus       = crc< 16, 0x8005,             0xFFFF,             true,  true,  0x0000             >;
+using xmodem       = crc< 16, 0x1021,             0x0000,             false, false, 0x0000             >;
+using crc32        = crc< 32, 0x04C11DB7,         0xFFFFFFFF,         true,  true,  0xFFFFFFFF         >;
+using crc32c       = crc< 32, 0x1EDC6F41,         0xFFFFFFFF,         true,  true,  0xFFFFFFFF         >;
+using crc64_ecma   = crc< 64, 0x42F0E1EBA9EA3693, 0x0000000000000000, false, false, 0x0000000000000000 >;
+using crc64_we     = crc< 64, 0x42F0E1EBA9EA3693, 0xFFFFFFFFFFFFFFFF, false, false, 0xFFFFFFFFFFFFFFFF >;
+
+}  // namespace libcrc
+
+#endif  // DEF_LIBCRC_CHECKSUM_HPP
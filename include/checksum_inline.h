@@ -0,0 +1,163 @@
+/*
+ * Library: libcrc
+ * File:    include/checksum_inline.h
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2026 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The optional headerfile include/checksum_inline.h contains static inline
+ * versions of the update_crc_xxx() routines. They index the exported lookup
+ * tables directly, which lets the compiler inline the calculation in a
+ * parsing loop instead of calling into the library for every byte. The
+ * functions have the suffix _inline and return the same values as the
+ * library routines without that suffix.
+ */
+
+#ifndef DEF_LIBCRC_CHECKSUM_INLINE_H
+#define DEF_LIBCRC_CHECKSUM_INLINE_H
+
+#include "checksum.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * static inline uint8_t update_crc_8_inline( uint8_t crc, unsigned char c );
+ *
+ * Inline version of update_crc_8().
+ */
+
+static inline uint8_t update_crc_8_inline( uint8_t crc, unsigned char c ) {
+
+	return crc_tab8[ c ^ crc ];
+
+}  /* update_crc_8_inline */
+
+/*
+ * static inline uint16_t update_crc_16_inline( uint16_t crc, unsigned char c );
+ *
+ * Inline version of update_crc_16().
+ */
+
+static inline uint16_t update_crc_16_inline( uint16_t crc, unsigned char c ) {
+
+	return (uint16_t) ( (crc >> 8) ^ crc_tab16[ (crc ^ (uint16_t) c) & 0x00FF ] );
+
+}  /* update_crc_16_inline */
+
+/*
+ * static inline uint32_t update_crc_32_inline( uint32_t crc, unsigned char c );
+ *
+ * Inline version of update_crc_32().
+ */
+
+static inline uint32_t update_crc_32_inline( uint32_t crc, unsigned char c ) {
+
+	return (crc >> 8) ^ crc_tab32[ (crc ^ (uint32_t) c) & 0x000000FFul ];
+
+}  /* update_crc_32_inline */
+
+/*
+ * static inline uint32_t update_crc_32c_inline( uint32_t crc, unsigned char c );
+ *
+ * Inline version of update_crc_32c().
+ */
+
+static inline uint32_t update_crc_32c_inline( uint32_t crc, unsigned char c ) {
+
+	return (crc >> 8) ^ crc_tab32c[ (crc ^ (uint32_t) c) & 0x000000FFul ];
+
+}  /* update_crc_32c_inline */
+
+/*
+ * static inline uint64_t update_crc_64_inline( uint64_t crc, unsigned char c );
+ *
+ * Inline version of update_crc_64().
+ */
+
+static inline uint64_t update_crc_64_inline( uint64_t crc, unsigned char c ) {
+
+	return (crc << 8) ^ crc_tab64[ ((crc >> 56) ^ (uint64_t) c) & 0x00000000000000FFull ];
+
+}  /* update_crc_64_inline */
+
+/*
+ * static inline uint16_t update_crc_ccitt_inline( uint16_t crc, unsigned char c );
+ *
+ * Inline version of update_crc_ccitt().
+ */
+
+static inline uint16_t update_crc_ccitt_inline( uint16_t crc, unsigned char c ) {
+
+	return (uint16_t) ( (crc << 8) ^ crc_tabccitt[ ((crc >> 8) ^ (uint16_t) c) & 0x00FF ] );
+
+}  /* update_crc_ccitt_inline */
+
+/*
+ * static inline uint16_t update_crc_dnp_inline( uint16_t crc, unsigned char c );
+ *
+ * Inline version of update_crc_dnp().
+ */
+
+static inline uint16_t update_crc_dnp_inline( uint16_t crc, unsigned char c ) {
+
+	return (uint16_t) ( (crc >> 8) ^ crc_tabdnp[ (crc ^ (uint16_t) c) & 0x00FF ] );
+
+}  /* update_crc_dnp_inline */
+
+/*
+ * static inline uint16_t update_crc_kermit_inline( uint16_t crc, unsigned char c );
+ *
+ * Inline version of update_crc_kermit().
+ */
+
+static inline uint16_t update_crc_kermit_inline( uint16_t crc, unsigned char c ) {
+
+	return (uint16_t) ( (crc >> 8) ^ crc_tabkrmit[ (crc ^ (uint16_t) c) & 0x00FF ] );
+
+}  /* update_crc_kermit_inline */
+
+/*
+ * static inline uint16_t update_crc_sick_inline( uint16_t crc, unsigned char c, unsigned char prev_byte );
+ *
+ * Inline version of update_crc_sick(). The Sick CRC shifts the register one
+ * bit per byte and needs no lookup table.
+ */
+
+static inline uint16_t update_crc_sick_inline( uint16_t crc, unsigned char c, unsigned char prev_byte ) {
+
+	if ( crc & 0x8000 ) crc = (uint16_t) ( ( crc << 1 ) ^ CRC_POLY_SICK );
+	else                crc = (uint16_t) (   crc << 1 );
+
+	return (uint16_t) ( crc ^ ( (uint16_t) c | ( (uint16_t) prev_byte << 8 ) ) );
+
+}  /* update_crc_sick_inline */
+
+#ifdef __cplusplus
+}// Extern C
+#endif
+
+#endif  // DEF_LIBCRC_CHECKSUM_INLINE_H
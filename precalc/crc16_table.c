@@ -0,0 +1,88 @@
+/*
+ * Library: libcrc
+ * File:    precalc/crc16_table.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2026 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file precalc/crc16_table.c contains the routines which are needed
+ * to generate the lookup tables for the 16 bit CRC calculations.
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include "checksum.h"
+#include "precalc.h"
+
+/*
+ * void init_crc16_tab( uint16_t poly, bool reflected );
+ *
+ * The function init_crc16_tab() calculates the lookup table for a 16 bit CRC.
+ * Reflected polynomials like those of CRC16, DNP and Kermit process the least
+ * significant bit first, the CCITT polynomial processes the most significant
+ * bit first.
+ */
+
+void init_crc16_tab( uint16_t poly, bool reflected ) {
+
+	uint16_t i;
+	uint16_t j;
+	uint16_t crc;
+	uint16_t c;
+
+	for (i=0; i<256; i++) {
+
+		crc = 0;
+
+		if ( reflected ) {
+
+			c = i;
+
+			for (j=0; j<8; j++) {
+
+				if ( (crc ^ c) & 0x0001 ) crc = ( crc >> 1 ) ^ poly;
+				else                      crc =   crc >> 1;
+
+				c = c >> 1;
+			}
+		}
+
+		else {
+
+			c = (uint16_t) ( i << 8 );
+
+			for (j=0; j<8; j++) {
+
+				if ( (crc ^ c) & 0x8000 ) crc = (uint16_t) ( ( crc << 1 ) ^ poly );
+				else                      crc = (uint16_t)   ( crc << 1 );
+
+				c = (uint16_t) ( c << 1 );
+			}
+		}
+
+		crc_tab_precalc[0][i] = crc;
+	}
+
+}  /* init_crc16_tab */
@@ -37,13 +37,15 @@
 #include "precalc.h"
 
 /*
- * void init_crc32_tab( void );
+ * void init_crc32_tab( uint32_t poly );
  *
  * For optimal speed, the CRC32 calculation uses a table with pre-calculated
- * bit patterns which are used in the XOR operations in the program.
+ * bit patterns which are used in the XOR operations in the program. The same
+ * routine is used for all reflected 32 bit polynomials, like CRC-32 and the
+ * Castagnoli CRC-32C.
  */
 
-void init_crc32_tab( void ) {
+void init_crc32_tab( uint32_t poly ) {
 
 	uint32_t i;
 	uint32_t j;
@@ -55,11 +57,11 @@ void init_crc32_tab( void ) {
 
 		for (j=0; j<8; j++) {
 
-			if ( crc & 0x00000001L ) crc = ( crc >> 1 ) ^ CRC_POLY_32;
+			if ( crc & 0x00000001L ) crc = ( crc >> 1 ) ^ poly;
 			else                     crc =   crc >> 1;
 		}
 
-		crc_tab_precalc[i] = crc;
+		crc_tab_precalc[0][i] = crc;
 	}
 
 }  /* init_crc32_tab */
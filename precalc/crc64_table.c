@@ -65,7 +65,7 @@ void init_crc64_tab( void ) {
 			c = c << 1;
 		}
 
-		crc_tab_precalc[i] = crc;
+		crc_tab_precalc[0][i] = crc;
 	}
 
 }  /* init_crc64_tab */
@@ -0,0 +1,88 @@
+/*
+ * Library: libcrc
+ * File:    precalc/crcn_table.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2026 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file precalc/crcn_table.c contains the routine which is needed
+ * to generate the lookup table for a CRC of any width between 8 and 64 bits.
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include "checksum.h"
+#include "precalc.h"
+
+/*
+ * void init_crcn_tab( int bits, uint64_t poly, bool reflected );
+ *
+ * The function init_crcn_tab() calculates the byte lookup table for a CRC of
+ * the given width and polynomial. The polynomial is passed in the bit order of
+ * the CRC register, i.e. reversed when the least significant bit is processed
+ * first.
+ */
+
+void init_crcn_tab( int bits, uint64_t poly, bool reflected ) {
+
+	int i;
+	int j;
+	uint64_t crc;
+	uint64_t top;
+	uint64_t mask;
+
+	if ( bits < 64 ) mask = ( 1ull << bits ) - 1;
+	else             mask = 0xFFFFFFFFFFFFFFFFull;
+
+	top = 1ull << (bits-1);
+
+	for (i=0; i<256; i++) {
+
+		if ( reflected ) {
+
+			crc = (uint64_t) i;
+
+			for (j=0; j<8; j++) {
+
+				if ( crc & 1 ) crc = ( crc >> 1 ) ^ poly;
+				else           crc =   crc >> 1;
+			}
+		}
+
+		else {
+
+			crc = ( (uint64_t) i ) << (bits-8);
+
+			for (j=0; j<8; j++) {
+
+				if ( crc & top ) crc = ( ( crc << 1 ) & mask ) ^ poly;
+				else             crc =   ( crc << 1 ) & mask;
+			}
+		}
+
+		crc_tab_precalc[0][i] = crc;
+	}
+
+}  /* init_crcn_tab */
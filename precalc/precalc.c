@@ -32,28 +32,85 @@
  * files which are then included by the CRC routine source files
  */
 
+#include <errno.h>
 #include <inttypes.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "checksum.h"
 #include "precalc.h"
 
 #define TYPE_CRC32		1
 #define TYPE_CRC64		2
+#define TYPE_CRC32C		3
+#define TYPE_COMBINE		4
+#define TYPE_CRC16		5
+#define TYPE_CCITT		6
+#define TYPE_DNP		7
+#define TYPE_KERMIT		8
+#define TYPE_CRC8		9
+#define TYPE_SICK		10
+#define TYPE_CUSTOM		11
+#define TYPE_CRC8_AUTOSAR	12
+#define TYPE_CRC8_MAXIM		13
+#define TYPE_CRC8_SMBUS		14
+
+/*
+ * #define CRC_32C_LONG, CRC_32C_SHORT
+ *
+ * The block sizes in bytes of the three interleaved streams in the hardware
+ * CRC-32C routine. Shift tables are generated for both block sizes.
+ */
+
+#define CRC_32C_LONG		8192
+#define CRC_32C_SHORT		256
+
+/*
+ * struct table_tp
+ *
+ * The structure table_tp describes the set of tables which is written to one
+ * include file.
+ */
+
+						/************************************************/
+struct table_tp {				/*						*/
+	int		type;			/* One of the TYPE_xxx constants		*/
+	const char *	tabname;		/* Name of the byte lookup table		*/
+	int		bits;			/* Width of the CRC in bits			*/
+	int		slices;			/* Number of slicing tables, 1 for none		*/
+	bool		reflected;		/* True if the least significant bit is first	*/
+	bool		fold;			/* Write carry-less multiplication constants	*/
+	bool		shift;			/* Write the CRC-32C stream merge tables	*/
+	bool		pair;			/* Write the Sick byte pair tables		*/
+	uint64_t	poly;			/* The polynomial in register bit order		*/
+};						/*						*/
+						/************************************************/
 
 /*
  * Functions in this source file with local scope
  */
 
 static int	generate_table( const char *typename, const char *filename );
+static int	generate_custom( char *argv[] );
+static int	write_file( const char *filename, const struct table_tp *table );
+static int	storage_bits( int bits );
+static void	init_slice_tabs( int bits, bool reflected, int slices );
+static void	write_table( FILE *fp, int bits, const uint64_t *tab );
+static void	write_fold( FILE *fp, const char *tabname, int bits, bool reflected, uint64_t poly );
+static void	write_pair( FILE *fp, const char *tabname, int bits, uint64_t poly );
+static void	write_shift( FILE *fp, const char *tabname, const char *suffix, int bits, size_t num_bytes );
+static uint64_t	xpow_mod( int n, int bits, uint64_t poly );
+static uint64_t	reflect( uint64_t value, int bits );
+static void	write_x2n( FILE *fp, const char *tabname, int bits, bool reflected, uint64_t poly );
+static uint64_t	mul_mod( uint64_t a, uint64_t b, int bits, bool reflected, uint64_t poly );
 
 /*
- * Internal table to store the CRC lookup table
+ * Internal table to store the CRC lookup tables
  */
 
-uint64_t	crc_tab_precalc[256];
+uint64_t	crc_tab_precalc[PRECALC_MAX_SLICES][256];
 
 /*
  * int main( int argc, char *argv[] );
@@ -70,16 +127,21 @@ int main( int argc, char *argv[] ) {
 
 	int retval;
 
-	if ( argc != 3 ) {
+	if      ( argc == 3                                      ) retval = generate_table( argv[1], argv[2] );
+	else if ( argc == 8  &&  ! strcmp( argv[1], "--custom" ) ) retval = generate_custom( argv );
+	else {
 
 		fprintf( stderr, "\nusage: precalc --type file\n" );
-		fprintf( stderr, "       where --type is any of --crc64\n\n" );
+		fprintf( stderr, "       where --type is any of --crc8, --crc8autosar, --crc8maxim, --crc8smbus,\n" );
+		fprintf( stderr, "       --crc16, --crc32, --crc32c, --crc64, --crcccitt, --crcdnp, --crckermit,\n" );
+		fprintf( stderr, "       --crcsick or --combine\n\n" );
+		fprintf( stderr, "   or: precalc --custom name bits poly lsb|msb slices file\n" );
+		fprintf( stderr, "       to generate the tables for any polynomial of 8 to 64 bits with\n" );
+		fprintf( stderr, "       1, 4, 8 or 16 slicing tables\n\n" );
 
 		exit( 1 );
 	}
 
-	retval = generate_table( argv[1], argv[2] );
-
 	exit( retval );
 
 }  /* main (libcrc precalc) */
@@ -95,11 +157,7 @@ int main( int argc, char *argv[] ) {
 
 static int generate_table( const char *typename, const char *filename ) {
 
-	int a;
-	int type;
-	int bits;
-	FILE *fp;
-	const char *tabname;
+	struct table_tp table;
 
 	if ( typename == NULL  ||  filename == NULL ) {
 
@@ -107,23 +165,143 @@ static int generate_table( const char *typename, const char *filename ) {
 		return 2;
 	}
 
-	if      ( ! strcmp( typename, "--crc64" ) ) type = TYPE_CRC64;
-	else if ( ! strcmp( typename, "--crc32" ) ) type = TYPE_CRC32;
+	memset( & table, 0, sizeof(table) );
+
+	if      ( ! strcmp( typename, "--crc8"        ) ) table.type = TYPE_CRC8;
+	else if ( ! strcmp( typename, "--crc8autosar" ) ) table.type = TYPE_CRC8_AUTOSAR;
+	else if ( ! strcmp( typename, "--crc8maxim"   ) ) table.type = TYPE_CRC8_MAXIM;
+	else if ( ! strcmp( typename, "--crc8smbus"   ) ) table.type = TYPE_CRC8_SMBUS;
+	else if ( ! strcmp( typename, "--crc16"       ) ) table.type = TYPE_CRC16;
+	else if ( ! strcmp( typename, "--crc32"       ) ) table.type = TYPE_CRC32;
+	else if ( ! strcmp( typename, "--crc32c"      ) ) table.type = TYPE_CRC32C;
+	else if ( ! strcmp( typename, "--crc64"       ) ) table.type = TYPE_CRC64;
+	else if ( ! strcmp( typename, "--crcccitt"    ) ) table.type = TYPE_CCITT;
+	else if ( ! strcmp( typename, "--crcdnp"      ) ) table.type = TYPE_DNP;
+	else if ( ! strcmp( typename, "--crckermit"   ) ) table.type = TYPE_KERMIT;
+	else if ( ! strcmp( typename, "--crcsick"     ) ) table.type = TYPE_SICK;
+	else if ( ! strcmp( typename, "--combine"     ) ) table.type = TYPE_COMBINE;
 	else {
 
 		fprintf( stderr, "\nprecalc: Unknown table type \"%s\" passed\n\n", typename );
 		return 3;
 	}
 
-	tabname = NULL;
-	bits    = 1;
+	table.slices = 1;
+
+	switch ( table.type ) {
+
+		case TYPE_CRC8         : table.tabname = "crc_tab8";         table.bits =  8; table.reflected = false; table.poly = CRC_POLY_8;         table.slices = 8; table.fold  = true; break;
+		case TYPE_CRC8_AUTOSAR : table.tabname = "crc_tab8_autosar"; table.bits =  8; table.reflected = false; table.poly = CRC_POLY_8_AUTOSAR; table.slices = 8; table.fold  = true; break;
+		case TYPE_CRC8_MAXIM   : table.tabname = "crc_tab8_maxim";   table.bits =  8; table.reflected = true;  table.poly = CRC_POLY_8_MAXIM;   table.slices = 8; table.fold  = true; break;
+		case TYPE_CRC8_SMBUS   : table.tabname = "crc_tab8_smbus";   table.bits =  8; table.reflected = false; table.poly = CRC_POLY_8_SMBUS;   table.slices = 8; table.fold  = true; break;
+		case TYPE_CRC16        : table.tabname = "crc_tab16";        table.bits = 16; table.reflected = true;  table.poly = CRC_POLY_16;        table.slices = 8; table.fold  = true; break;
+		case TYPE_CRC32        : table.tabname = "crc_tab32";        table.bits = 32; table.reflected = true;  table.poly = CRC_POLY_32;        table.slices = 8;                     break;
+		case TYPE_CRC32C       : table.tabname = "crc_tab32c";       table.bits = 32; table.reflected = true;  table.poly = CRC_POLY_32C;       table.slices = 8; table.shift = true; break;
+		case TYPE_CRC64        : table.tabname = "crc_tab64";        table.bits = 64; table.reflected = false; table.poly = CRC_POLY_64;        table.slices = 8; table.fold  = true; break;
+		case TYPE_CCITT        : table.tabname = "crc_tabccitt";     table.bits = 16; table.reflected = false; table.poly = CRC_POLY_CCITT;     table.slices = 8; table.fold  = true; break;
+		case TYPE_DNP          : table.tabname = "crc_tabdnp";       table.bits = 16; table.reflected = true;  table.poly = CRC_POLY_DNP;       table.slices = 8; table.fold  = true; break;
+		case TYPE_KERMIT       : table.tabname = "crc_tabkrmit";     table.bits = 16; table.reflected = true;  table.poly = CRC_POLY_KERMIT;    table.slices = 8; table.fold  = true; break;
+		case TYPE_SICK         : table.tabname = "crc_tabsick";      table.bits = 16; table.reflected = false; table.poly = CRC_POLY_SICK;                        table.pair  = true; break;
+	}
+
+	return write_file( filename, & table );
+
+}  /* generate_table */
+
+/*
+ * static int generate_custom( char *argv[] );
+ *
+ * The function generate_custom() generates the lookup tables for a CRC with a
+ * polynomial, width and bit order passed on the command line. The polynomial
+ * is given in hexadecimal in the bit order of the CRC register, i.e.
+ * reversed for an lsb first CRC. If the function succeeds the value 0 is
+ * returned. Invalid arguments return 3.
+ */
+
+static int generate_custom( char *argv[] ) {
+
+	char *end;
+	long value;
+	struct table_tp table;
+
+	memset( & table, 0, sizeof(table) );
+
+	table.type      = TYPE_CUSTOM;
+	table.tabname   = argv[2];
+	table.reflected = ! strcmp( argv[5], "lsb" );
+
+	value = strtol( argv[3], & end, 10 );
+
+	if ( end == argv[3]  ||  *end != 0  ||  value < 8  ||  value > 64 ) {
+
+		fprintf( stderr, "\nprecalc: The CRC width must be between 8 and 64 bits\n\n" );
+		return 3;
+	}
+
+	table.bits = (int) value;
+
+	errno      = 0;
+	table.poly = strtoull( argv[4], & end, 16 );
+
+	if ( end == argv[4]  ||  *end != 0  ||  errno != 0  ||  argv[4][0] == '-'  ||  table.poly == 0
+	  ||  ( table.bits < 64  &&  ( table.poly >> table.bits ) != 0 ) ) {
+
+		fprintf( stderr, "\nprecalc: The polynomial must be a non zero hexadecimal value of at most %d bits\n\n", table.bits );
+		return 3;
+	}
+
+	if ( strcmp( argv[5], "lsb" )  &&  strcmp( argv[5], "msb" ) ) {
+
+		fprintf( stderr, "\nprecalc: The bit order must be lsb or msb\n\n" );
+		return 3;
+	}
+
+	value = strtol( argv[6], & end, 10 );
+
+	if ( end == argv[6]  ||  *end != 0  ||  ( value != 1  &&  value != 4  &&  value != 8  &&  value != 16 ) ) {
+
+		fprintf( stderr, "\nprecalc: The number of slicing tables must be 1, 4, 8 or 16\n\n" );
+		return 3;
+	}
+
+	table.slices = (int) value;
+
+	return write_file( argv[7], & table );
+
+}  /* generate_custom */
+
+/*
+ * static int write_file( const char *filename, const struct table_tp *table );
+ *
+ * The function write_file() calculates the tables described by the table
+ * parameter and writes them to an include file. Every table is aligned on a
+ * cache line with the CRC_CACHE_ALIGN macro of src/crcint.h. If the function
+ * succeeds the value 0 is returned.
+ */
 
-	switch ( type ) {
+static int write_file( const char *filename, const struct table_tp *table ) {
 
-		case TYPE_CRC32 : init_crc32_tab(); tabname = "crc_tab32"; bits = 32; break;
-		case TYPE_CRC64 : init_crc64_tab(); tabname = "crc_tab64"; bits = 64; break;
+	int a;
+	int tbits;
+	FILE *fp;
+
+	tbits = storage_bits( table->bits );
+
+	switch ( table->type ) {
+
+		case TYPE_CRC16  :
+		case TYPE_CCITT  :
+		case TYPE_DNP    :
+		case TYPE_KERMIT : init_crc16_tab( (uint16_t) table->poly, table->reflected ); break;
+		case TYPE_CRC32  :
+		case TYPE_CRC32C : init_crc32_tab( (uint32_t) table->poly );                   break;
+		case TYPE_CRC64  : init_crc64_tab();                                           break;
+		case TYPE_COMBINE:                                                             break;
+		default          : init_crcn_tab( table->bits, table->poly, table->reflected ); break;
 	}
 
+	if ( table->type != TYPE_COMBINE ) init_slice_tabs( table->bits, table->reflected, table->slices );
+
 #if defined(_MSC_VER)
 	fp = NULL;
 	fopen_s( &fp, filename, "w" );
@@ -147,25 +325,401 @@ static int generate_table( const char *typename, const char *filename ) {
 	fprintf( fp, " * library is recompiled. All manually added changes will be lost in that case.\n" );
 	fprintf( fp, " */\n\n" );
 
-	fprintf( fp, "const uint%d_t %s[256] = {\n", bits, tabname );
+	fprintf( fp, "#ifndef CRC_CACHE_ALIGN\n" );
+	fprintf( fp, "#define CRC_CACHE_ALIGN\n" );
+	fprintf( fp, "#endif\n\n" );
 
-	for (a=0; a<256; a++) {
+	if ( table->type == TYPE_COMBINE ) {
 
-		switch ( bits ) {
+		write_x2n( fp, "crc_x2n_8",       8, false, CRC_POLY_8      );
+		write_x2n( fp, "crc_x2n_16",     16, true,  CRC_POLY_16     );
+		write_x2n( fp, "crc_x2n_32",     32, true,  CRC_POLY_32     );
+		write_x2n( fp, "crc_x2n_32c",    32, true,  CRC_POLY_32C    );
+		write_x2n( fp, "crc_x2n_64",     64, false, CRC_POLY_64     );
+		write_x2n( fp, "crc_x2n_ccitt",  16, false, CRC_POLY_CCITT  );
+		write_x2n( fp, "crc_x2n_dnp",    16, true,  CRC_POLY_DNP    );
+		write_x2n( fp, "crc_x2n_kermit", 16, true,  CRC_POLY_KERMIT );
+		write_x2n( fp, "crc_x2n_sick",   16, false, CRC_POLY_SICK   );
 
-			case  8 : fprintf( fp, "\t0x%02"  PRIX8  "\x75",   (uint8_t)  (crc_tab_precalc[a] & 0x00000000000000FFull) ); break;
-			case 16 : fprintf( fp, "\t0x%04"  PRIX16 "\x75",   (uint16_t) (crc_tab_precalc[a] & 0x000000000000FFFFull) ); break;
-			case 32 : fprintf( fp, "\t0x%08"  PRIX32 "\x75l",  (uint32_t) (crc_tab_precalc[a] & 0x00000000FFFFFFFFull) ); break;
-			case 64 : fprintf( fp, "\t0x%016" PRIX64 "\x75ll",             crc_tab_precalc[a]                          ); break;
+		fclose( fp );
+
+		return 0;
+	}
+
+	fprintf( fp, "CRC_CACHE_ALIGN const uint%d_t %s[256] = {\n", tbits, table->tabname );
+	write_table( fp, table->bits, crc_tab_precalc[0] );
+	fprintf( fp, "};\n\n" );
+
+	if ( table->slices > 1 ) {
+
+		fprintf( fp, "CRC_CACHE_ALIGN const uint%d_t %s_slice%d[%d][256] = {\n", tbits, table->tabname, table->slices, table->slices );
+
+		for (a=0; a<table->slices; a++) {
+
+			fprintf( fp, "    {\n" );
+			write_table( fp, table->bits, crc_tab_precalc[a] );
+			if ( a < table->slices-1 ) fprintf( fp, "    },\n" );
+			else                       fprintf( fp, "    }\n" );
 		}
+
+		fprintf( fp, "};\n\n" );
+	}
+
+	if ( table->fold ) write_fold( fp, table->tabname, table->bits, table->reflected, table->poly );
+
+	if ( table->pair ) write_pair( fp, table->tabname, table->bits, table->poly );
+
+	if ( table->shift ) {
+
+		write_shift( fp, table->tabname, "long",  table->bits, CRC_32C_LONG  );
+		write_shift( fp, table->tabname, "short", table->bits, CRC_32C_SHORT );
+	}
+
+	fclose( fp );
+
+	return 0;
+
+}  /* write_file */
+
+/*
+ * static int storage_bits( int bits );
+ *
+ * The function storage_bits() returns the number of bits of the smallest
+ * standard unsigned integer type which can hold a CRC of the given width.
+ */
+
+static int storage_bits( int bits ) {
+
+	if ( bits <=  8 ) return  8;
+	if ( bits <= 16 ) return 16;
+	if ( bits <= 32 ) return 32;
+
+	return 64;
+
+}  /* storage_bits */
+
+/*
+ * static void init_slice_tabs( int bits, bool reflected, int slices );
+ *
+ * The function init_slice_tabs() derives the additional lookup tables needed
+ * for slicing-by-n CRC calculations from the byte lookup table in slot 0. The
+ * entry i in table n is the CRC contribution of byte value i when that byte is
+ * followed by n other bytes. The tables are derived by feeding a zero byte
+ * through the ordinary byte-at-a-time algorithm.
+ */
+
+static void init_slice_tabs( int bits, bool reflected, int slices ) {
+
+	int a;
+	int i;
+	uint64_t crc;
+	uint64_t mask;
+
+	if ( bits < 64 ) mask = ( 1ull << bits ) - 1;
+	else             mask = 0xFFFFFFFFFFFFFFFFull;
+
+	for (a=1; a<slices; a++) {
+
+		for (i=0; i<256; i++) {
+
+			crc = crc_tab_precalc[a-1][i];
+
+			if ( reflected ) crc =   ( crc >> 8 )          ^ crc_tab_precalc[0][ crc & 0xFF ];
+			else             crc = ( ( crc << 8 ) & mask ) ^ crc_tab_precalc[0][ ( crc >> (bits-8) ) & 0xFF ];
+
+			crc_tab_precalc[a][i] = crc;
+		}
+	}
+
+}  /* init_slice_tabs */
+
+/*
+ * static void write_table( FILE *fp, int bits, const uint64_t *tab );
+ *
+ * The function write_table() writes the 256 values of one of the precalculated
+ * lookup tables to an include file.
+ */
+
+static void write_table( FILE *fp, int bits, const uint64_t *tab ) {
+
+	int a;
+	int tbits;
+	uint64_t mask;
+	const char *suffix;
+
+	tbits = storage_bits( bits );
+
+	if ( tbits < 64 ) mask = ( 1ull << tbits ) - 1;
+	else              mask = 0xFFFFFFFFFFFFFFFFull;
+
+	switch ( tbits ) {
+
+		case 32 : suffix = "ul";  break;
+		case 64 : suffix = "ull"; break;
+		default : suffix = "u";   break;
+	}
+
+	for (a=0; a<256; a++) {
+
+		fprintf( fp, "\t0x%0*" PRIX64 "%s", tbits/4, tab[a] & mask, suffix );
+
 		if ( a < 255 ) fprintf( fp, ",\n" );
 		else           fprintf( fp, "\n" );
 	}
 
+}  /* write_table */
+
+/*
+ * static void write_fold( FILE *fp, const char *tabname, int bits, bool reflected, uint64_t poly );
+ *
+ * The function write_fold() writes the constants for the carry-less
+ * multiplication folding kernels. The constants are the remainders of x^n
+ * modulo the polynomial for the folding distances of 512 and 128 bits. For a
+ * reflected CRC the constants are the reflected 64 bit remainders of x^(n-1)
+ * and the pairs are swapped, as expected by crc_fold_lsb(). The structure
+ * crc_fold_tp is defined in src/crcint.h.
+ */
+
+static void write_fold( FILE *fp, const char *tabname, int bits, bool reflected, uint64_t poly ) {
+
+	fprintf( fp, "CRC_CACHE_ALIGN const struct crc_fold_tp %s_fold = {\n", tabname );
+
+	if ( reflected ) {
+
+		poly = reflect( poly, bits );
+
+		fprintf( fp, "\t0x%016" PRIX64 "\x75ll,\n", reflect( xpow_mod( 512+64-1, bits, poly ), 64 ) );
+		fprintf( fp, "\t0x%016" PRIX64 "\x75ll,\n", reflect( xpow_mod( 512-1,    bits, poly ), 64 ) );
+		fprintf( fp, "\t0x%016" PRIX64 "\x75ll,\n", reflect( xpow_mod( 128+64-1, bits, poly ), 64 ) );
+		fprintf( fp, "\t0x%016" PRIX64 "\x75ll\n",  reflect( xpow_mod( 128-1,    bits, poly ), 64 ) );
+	}
+
+	else {
+
+		fprintf( fp, "\t0x%016" PRIX64 "\x75ll,\n", xpow_mod( 512,    bits, poly ) );
+		fprintf( fp, "\t0x%016" PRIX64 "\x75ll,\n", xpow_mod( 512+64, bits, poly ) );
+		fprintf( fp, "\t0x%016" PRIX64 "\x75ll,\n", xpow_mod( 128,    bits, poly ) );
+		fprintf( fp, "\t0x%016" PRIX64 "\x75ll\n",  xpow_mod( 128+64, bits, poly ) );
+	}
+
 	fprintf( fp, "};\n\n" );
 
-	fclose( fp );
+}  /* write_fold */
 
-	return 0;
+/*
+ * static void write_pair( FILE *fp, const char *tabname, int bits, uint64_t poly );
+ *
+ * The function write_pair() writes the tables for the block-wise Sick CRC
+ * calculation. The Sick algorithm shifts the register only one bit per byte
+ * and adds each byte twice, once in the low half of the register and once
+ * shifted 8 bits up together with the next byte. After 8 bytes the byte at
+ * position k of the block has therefore been multiplied with
+ * x^(7-k) + x^(14-k). Table 0 contains the contribution x^15 of the last byte
+ * of the previous block, tables 1 to 7 those of the bytes 0 to 6 of the
+ * block. Byte 7 is added unchanged and needs no table.
+ */
 
-}  /* generate_table */
+static void write_pair( FILE *fp, const char *tabname, int bits, uint64_t poly ) {
+
+	int a;
+	int i;
+	uint64_t mult;
+	uint64_t tab[256];
+
+	fprintf( fp, "CRC_CACHE_ALIGN const uint%d_t %s_pair[8][256] = {\n", bits, tabname );
+
+	for (a=0; a<8; a++) {
+
+		if ( a == 0 ) mult = xpow_mod( 15, bits, poly );
+		else          mult = xpow_mod( 8-a, bits, poly ) ^ xpow_mod( 15-a, bits, poly );
+
+		for (i=0; i<256; i++) tab[i] = mul_mod( (uint64_t) i, mult, bits, false, poly );
+
+		fprintf( fp, "    {\n" );
+		write_table( fp, bits, tab );
+		if ( a < 7 ) fprintf( fp, "    },\n" );
+		else         fprintf( fp, "    }\n" );
+	}
+
+	fprintf( fp, "};\n\n" );
+
+}  /* write_pair */
+
+/*
+ * static void write_shift( FILE *fp, const char *tabname, const char *suffix, int bits, size_t num_bytes );
+ *
+ * The function write_shift() writes four tables which together move the value
+ * of a reflected CRC register forward over a number of zero bytes. Entry i of
+ * table n is the register value after the zero bytes, when the register
+ * started with the value i in byte n and zeros in the other bytes. Because
+ * the operation is linear, the tables can be combined with XOR to shift any
+ * register value. The hardware CRC routines use these tables to merge the CRC
+ * values of streams which have been calculated in parallel.
+ */
+
+static void write_shift( FILE *fp, const char *tabname, const char *suffix, int bits, size_t num_bytes ) {
+
+	int a;
+	int i;
+	size_t b;
+	uint64_t crc;
+	uint64_t tab[256];
+
+	fprintf( fp, "CRC_CACHE_ALIGN const uint%d_t %s_%s[%d][256] = {\n", bits, tabname, suffix, bits/8 );
+
+	for (a=0; a<bits/8; a++) {
+
+		for (i=0; i<256; i++) {
+
+			crc = ( (uint64_t) i ) << (8*a);
+
+			for (b=0; b<num_bytes; b++) crc = ( crc >> 8 ) ^ crc_tab_precalc[0][ crc & 0xFF ];
+
+			tab[i] = crc;
+		}
+
+		fprintf( fp, "    {\n" );
+		write_table( fp, bits, tab );
+		if ( a < bits/8-1 ) fprintf( fp, "    },\n" );
+		else                fprintf( fp, "    }\n" );
+	}
+
+	fprintf( fp, "};\n\n" );
+
+}  /* write_shift */
+
+/*
+ * static uint64_t xpow_mod( int n, int bits, uint64_t poly );
+ *
+ * The function xpow_mod() calculates the remainder of x^n modulo a polynomial
+ * of the given order. The polynomial is passed without its highest order term
+ * and with the most significant bit representing the highest power of x.
+ */
+
+static uint64_t xpow_mod( int n, int bits, uint64_t poly ) {
+
+	int a;
+	uint64_t rem;
+	uint64_t top;
+	uint64_t mask;
+
+	if ( bits < 64 ) mask = ( 1ull << bits ) - 1;
+	else             mask = 0xFFFFFFFFFFFFFFFFull;
+
+	top = 1ull << (bits-1);
+	rem = 1;
+
+	for (a=0; a<n; a++) {
+
+		if ( rem & top ) rem = ( ( rem << 1 ) & mask ) ^ poly;
+		else             rem =   ( rem << 1 ) & mask;
+	}
+
+	return rem;
+
+}  /* xpow_mod */
+
+/*
+ * static uint64_t reflect( uint64_t value, int bits );
+ *
+ * The function reflect() returns the lowest bits of a value in reversed bit
+ * order.
+ */
+
+static uint64_t reflect( uint64_t value, int bits ) {
+
+	int a;
+	uint64_t result;
+
+	result = 0;
+
+	for (a=0; a<bits; a++) {
+
+		result = ( result << 1 ) | ( value & 1 );
+		value >>= 1;
+	}
+
+	return result;
+
+}  /* reflect */
+
+/*
+ * static void write_x2n( FILE *fp, const char *tabname, int bits, bool reflected, uint64_t poly );
+ *
+ * The function write_x2n() writes a table with the remainders of x^(2^k)
+ * modulo a CRC polynomial for k = 0 .. 66. With these values the remainder of
+ * any power of x can be calculated with at most one multiplication per bit in
+ * the exponent. This is used to combine the CRC values of separate blocks.
+ * The values are in the same bit order as the CRC register of the algorithm.
+ */
+
+static void write_x2n( FILE *fp, const char *tabname, int bits, bool reflected, uint64_t poly ) {
+
+	int a;
+	uint64_t val;
+
+	if      ( bits == 1 ) val = 1;
+	else if ( reflected ) val = 1ull << (bits-2);
+	else                  val = 2;
+
+	fprintf( fp, "CRC_CACHE_ALIGN const uint64_t %s[67] = {\n", tabname );
+
+	for (a=0; a<67; a++) {
+
+		fprintf( fp, "\t0x%016" PRIX64 "\x75ll", val );
+		if ( a < 66 ) fprintf( fp, ",\n" );
+		else          fprintf( fp, "\n" );
+
+		val = mul_mod( val, val, bits, reflected, poly );
+	}
+
+	fprintf( fp, "};\n\n" );
+
+}  /* write_x2n */
+
+/*
+ * static uint64_t mul_mod( uint64_t a, uint64_t b, int bits, bool reflected, uint64_t poly );
+ *
+ * The function mul_mod() multiplies two polynomials modulo a CRC polynomial.
+ * For reflected polynomials the most significant bit represents x^0, for the
+ * other polynomials the least significant bit represents x^0.
+ */
+
+static uint64_t mul_mod( uint64_t a, uint64_t b, int bits, bool reflected, uint64_t poly ) {
+
+	int i;
+	uint64_t top;
+	uint64_t mask;
+	uint64_t prod;
+
+	if ( bits < 64 ) mask = ( 1ull << bits ) - 1;
+	else             mask = 0xFFFFFFFFFFFFFFFFull;
+
+	top  = 1ull << (bits-1);
+	prod = 0;
+
+	if ( reflected ) {
+
+		for (i=0; i<bits; i++) {
+
+			if ( a & (top >> i) ) prod ^= b;
+
+			if ( b & 1 ) b = ( b >> 1 ) ^ poly;
+			else         b =   b >> 1;
+		}
+	}
+
+	else {
+
+		for (i=bits-1; i>=0; i--) {
+
+			if ( prod & top ) prod = ( ( prod << 1 ) & mask ) ^ poly;
+			else              prod =   ( prod << 1 ) & mask;
+
+			if ( ( a >> i ) & 1 ) prod ^= b;
+		}
+	}
+
+	return prod;
+
+}  /* mul_mod */
@@ -35,16 +35,28 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+/*
+ * #define PRECALC_MAX_SLICES
+ *
+ * The maximum number of slicing tables which can be generated for one CRC
+ * algorithm. Table 0 is the classic byte-at-a-time lookup table, table n
+ * contains the contribution of a byte which is followed by n other bytes.
+ */
+
+#define PRECALC_MAX_SLICES	16
+
 /*
  * Global functions used in the precalc program
  */
 
-void			init_crc32_tab( void );
+void			init_crc16_tab( uint16_t poly, bool reflected );
+void			init_crc32_tab( uint32_t poly );
 void			init_crc64_tab( void );
+void			init_crcn_tab( int bits, uint64_t poly, bool reflected );
 int			main( int argc, char *argv[] );
 
 /*
  * Global variables used in the precalc program
  */
 
-extern uint64_t		crc_tab_precalc[256];
+extern uint64_t		crc_tab_precalc[PRECALC_MAX_SLICES][256];
@@ -34,11 +34,16 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include "checksum.h"
+#include "crcint.h"
 
-static void             init_crc16_tab( void );
+static uint64_t		crc_16_batch_block( uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+static void		crc_16_lanes( uint64_t crc[CRC_BATCH_LANES], const unsigned char *ptr[CRC_BATCH_LANES], size_t num_bytes );
 
-static bool             crc_tab16_init          = false;
-static uint16_t         crc_tab16[256];
+/*
+ * Include the lookup table for the CRC16 calculation
+ */
+
+#include "../tab/gentab16.inc"
 
 /*
  * uint16_t crc_16( const unsigned char *input_str, size_t num_bytes );
@@ -52,18 +57,10 @@ static uint16_t         crc_tab16[256];
 uint16_t crc_16( const unsigned char *input_str, size_t num_bytes ) {
 
 	uint16_t crc;
-	const unsigned char *ptr;
-	size_t a;
-
-	if ( ! crc_tab16_init ) init_crc16_tab();
 
 	crc = CRC_START_16;
-	ptr = input_str;
-
-	if ( ptr != NULL ) for (a=0; a<num_bytes; a++) {
 
-		crc = (crc >> 8) ^ crc_tab16[ (crc ^ (uint16_t) *ptr++) & 0x00FF ];
-	}
+	if ( input_str != NULL ) crc = crc_16_block( crc, input_str, num_bytes );
 
 	return crc;
 
@@ -80,70 +77,90 @@ uint16_t crc_16( const unsigned char *input_str, size_t num_bytes ) {
 uint16_t crc_modbus( const unsigned char *input_str, size_t num_bytes ) {
 
 	uint16_t crc;
-	const unsigned char *ptr;
-	size_t a;
-
-	if ( ! crc_tab16_init ) init_crc16_tab();
 
 	crc = CRC_START_MODBUS;
-	ptr = input_str;
-
-	if ( ptr != NULL ) for (a=0; a<num_bytes; a++) {
 
-		crc = (crc >> 8) ^ crc_tab16[ (crc ^ (uint16_t) *ptr++) & 0x00FF ];
-	}
+	if ( input_str != NULL ) crc = crc_16_block( crc, input_str, num_bytes );
 
 	return crc;
 
 }  /* crc_modbus */
 
 /*
- * uint16_t update_crc_16( uint16_t crc, unsigned char c );
+ * uint16_t crc_16_block( uint16_t crc, const unsigned char *ptr, size_t num_bytes );
  *
- * The function update_crc_16() calculates a new CRC-16 value based on the
- * previous value of the CRC and the next byte of data to be checked.
+ * The function crc_16_block() updates a CRC16 or Modbus register with the
+ * contents of a byte buffer with the shared 16 bit kernels. It is used by
+ * the one-pass routines and by the streaming interface.
  */
 
-uint16_t update_crc_16( uint16_t crc, unsigned char c ) {
+uint16_t crc_16_block( uint16_t crc, const unsigned char *ptr, size_t num_bytes ) {
 
-	if ( ! crc_tab16_init ) init_crc16_tab();
+	return crc_16_lsb_update( crc, ptr, num_bytes, crc_tab16_slice8, & crc_tab16_fold );
 
-	return (crc >> 8) ^ crc_tab16[ (crc ^ (uint16_t) c) & 0x00FF ];
+}  /* crc_16_block */
 
-}  /* update_crc_16 */
+/*
+ * void crc_16_batch( const unsigned char *const bufs[], const size_t lens[], uint16_t out[], size_t n );
+ *
+ * The function crc_16_batch() calculates the CRC16 of n independent buffers
+ * and stores the results in the array out. The result for each buffer is the
+ * same as the result of crc_16() for that buffer. The short buffers are
+ * processed in an interleaved way, four at a time. Buffers long enough for
+ * the folding kernels are processed one at a time.
+ */
+
+void crc_16_batch( const unsigned char *const bufs[], const size_t lens[], uint16_t out[], size_t n ) {
+
+	struct crc_batch_tp batch;
+
+	batch.bits      = 16;
+	batch.start     = CRC_START_16;
+	batch.xor_out   = 0x0000;
+	batch.lanes_min = CRC_BATCH_MIN;
+	batch.solo_min  = crc_dispatch()->clmul_min_16;
+	batch.lanes     = crc_16_lanes;
+	batch.block     = crc_16_batch_block;
+
+	crc_batch_run( & batch, bufs, lens, out, n );
+
+}  /* crc_16_batch */
 
 /*
- * static void init_crc16_tab( void );
+ * static uint64_t crc_16_batch_block( uint64_t crc, const unsigned char *ptr, size_t num_bytes );
  *
- * For optimal performance uses the CRC16 routine a lookup table with values
- * that can be used directly in the XOR arithmetic in the algorithm. This
- * lookup table is calculated by the init_crc16_tab() routine, the first time
- * the CRC function is called.
+ * The function crc_16_batch_block() updates a CRC16 register with the
+ * contents of one buffer for the batch routines.
  */
 
-static void init_crc16_tab( void ) {
+static uint64_t crc_16_batch_block( uint64_t crc, const unsigned char *ptr, size_t num_bytes ) {
 
-	uint16_t i;
-	uint16_t j;
-	uint16_t crc;
-	uint16_t c;
+	return crc_16_block( (uint16_t) crc, ptr, num_bytes );
 
-	for (i=0; i<256; i++) {
+}  /* crc_16_batch_block */
 
-		crc = 0;
-		c   = i;
+/*
+ * static void crc_16_lanes( uint64_t crc[CRC_BATCH_LANES], const unsigned char *ptr[CRC_BATCH_LANES], size_t num_bytes );
+ *
+ * The function crc_16_lanes() updates the CRC16 registers of four buffers
+ * at once with the shared lane kernel of the reflected 16 bit CRCs.
+ */
 
-		for (j=0; j<8; j++) {
+static void crc_16_lanes( uint64_t crc[CRC_BATCH_LANES], const unsigned char *ptr[CRC_BATCH_LANES], size_t num_bytes ) {
 
-			if ( (crc ^ c) & 0x0001 ) crc = ( crc >> 1 ) ^ CRC_POLY_16;
-			else                      crc =   crc >> 1;
+	crc_16_lsb_lanes( crc, ptr, num_bytes, crc_tab16_slice8 );
 
-			c = c >> 1;
-		}
+}  /* crc_16_lanes */
 
-		crc_tab16[i] = crc;
-	}
+/*
+ * uint16_t update_crc_16( uint16_t crc, unsigned char c );
+ *
+ * The function update_crc_16() calculates a new CRC-16 value based on the
+ * previous value of the CRC and the next byte of data to be checked.
+ */
 
-	crc_tab16_init = true;
+uint16_t update_crc_16( uint16_t crc, unsigned char c ) {
+
+	return (crc >> 8) ^ crc_tab16[ (crc ^ (uint16_t) c) & 0x00FF ];
 
-}  /* init_crc16_tab */
+}  /* update_crc_16 */
@@ -32,11 +32,25 @@
  */
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include "checksum.h"
+#include "crcint.h"
+
+#if defined(LIBCRC_X86_64)
+#include <immintrin.h>
+#endif
+
+static uint64_t		crc_32_batch_block( uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+static void		crc_32_lanes( uint64_t crc[CRC_BATCH_LANES], const unsigned char *ptr[CRC_BATCH_LANES], size_t num_bytes );
+static uint32_t		crc_32_step8(  uint32_t crc, const unsigned char *ptr );
+static uint32_t		crc_32_slice8( uint32_t crc, const unsigned char *ptr, size_t num_bytes );
+#if defined(LIBCRC_X86_64)
+static uint32_t		crc_32_clmul(  uint32_t crc, const unsigned char *ptr, size_t num_bytes );
+#endif
 
 /*
- * Include the lookup table for the CRC 32 calculation
+ * Include the lookup tables for the CRC 32 calculation
  */
 
 #include "../tab/gentab32.inc"
@@ -52,20 +66,349 @@
 uint32_t crc_32( const unsigned char *input_str, size_t num_bytes ) {
 
 	uint32_t crc;
-	const unsigned char *ptr;
-	size_t a;
 
 	crc = CRC_START_32;
-	ptr = input_str;
 
-	if ( ptr != NULL ) for (a=0; a<num_bytes; a++) {
+	if ( input_str != NULL ) crc = crc_32_block( crc, input_str, num_bytes );
+
+	return (crc ^ 0xFFFFFFFFul);
+
+}  /* crc_32 */
+
+/*
+ * uint32_t crc_32_block( uint32_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crc_32_block() updates a CRC-32 register with the contents of a
+ * byte buffer with the kernels selected by the dispatch layer. Long buffers
+ * are folded with carry-less multiplication when that level is active, the
+ * remaining bytes are processed with slicing-by-8 or one byte at a time.
+ */
+
+uint32_t crc_32_block( uint32_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	const struct crc_dispatch_tp *disp;
+#if defined(LIBCRC_X86_64)
+	size_t num_fold;
+#endif
+
+	disp = crc_dispatch();
+
+#if defined(LIBCRC_X86_64)
+	if ( num_bytes >= disp->clmul_min_32 ) {
+
+		num_fold   = num_bytes & ~( (size_t) 0x0F );
+		crc        = crc_32_clmul( crc, ptr, num_fold );
+		ptr       += num_fold;
+		num_bytes -= num_fold;
+	}
+#endif
+
+	if ( disp->slice8 ) return crc_32_slice8( crc, ptr, num_bytes );
+
+	while ( num_bytes-- > 0 ) crc = (crc >> 8) ^ crc_tab32[ (crc ^ (uint32_t) *ptr++) & 0x000000FFul ];
+
+	return crc;
+
+}  /* crc_32_block */
+
+/*
+ * void crc_32_batch( const unsigned char *const bufs[], const size_t lens[], uint32_t out[], size_t n );
+ *
+ * The function crc_32_batch() calculates the CRC-32 of n independent
+ * buffers and stores the results in the array out. The result for each
+ * buffer is the same as the result of crc_32() for that buffer. The short
+ * buffers are processed in an interleaved way, four at a time. Buffers long
+ * enough for the folding kernels are processed one at a time.
+ */
+
+void crc_32_batch( const unsigned char *const bufs[], const size_t lens[], uint32_t out[], size_t n ) {
+
+	struct crc_batch_tp batch;
+
+	batch.bits      = 32;
+	batch.start     = CRC_START_32;
+	batch.xor_out   = 0xFFFFFFFFul;
+	batch.lanes_min = CRC_BATCH_MIN;
+	batch.solo_min  = crc_dispatch()->clmul_min_32;
+	batch.lanes     = crc_32_lanes;
+	batch.block     = crc_32_batch_block;
+
+	crc_batch_run( & batch, bufs, lens, out, n );
+
+}  /* crc_32_batch */
+
+/*
+ * static uint64_t crc_32_batch_block( uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crc_32_batch_block() updates a CRC-32 register with the
+ * contents of one buffer for the batch routines.
+ */
+
+static uint64_t crc_32_batch_block( uint64_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	return crc_32_block( (uint32_t) crc, ptr, num_bytes );
+
+}  /* crc_32_batch_block */
+
+/*
+ * static uint32_t crc_32_slice8( uint32_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crc_32_slice8() updates a CRC-32 value with the contents of a
+ * byte buffer using the slicing-by-8 algorithm. Eight bytes are processed per
+ * iteration with eight independent table lookups, which removes most of the
+ * serial dependency of the byte-at-a-time algorithm. Only the bytes before the
+ * first 8 byte boundary and the trailing bytes are processed one at a time.
+ * The words are assembled from single bytes, which makes the routine
+ * independent of the endianness and alignment requirements of the platform.
+ */
+
+static uint32_t crc_32_slice8( uint32_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	while ( num_bytes > 0  &&  ( (uintptr_t) ptr & 0x07 ) != 0 ) {
 
 		crc = (crc >> 8) ^ crc_tab32[ (crc ^ (uint32_t) *ptr++) & 0x000000FFul ];
+		num_bytes--;
 	}
 
-	return (crc ^ 0xFFFFFFFFul);
+	while ( num_bytes >= 8 ) {
 
-}  /* crc_32 */
+		crc        = crc_32_step8( crc, ptr );
+		ptr       += 8;
+		num_bytes -= 8;
+	}
+
+	while ( num_bytes > 0 ) {
+
+		crc = (crc >> 8) ^ crc_tab32[ (crc ^ (uint32_t) *ptr++) & 0x000000FFul ];
+		num_bytes--;
+	}
+
+	return crc;
+
+}  /* crc_32_slice8 */
+
+/*
+ * static uint32_t crc_32_step8( uint32_t crc, const unsigned char *ptr );
+ *
+ * The function crc_32_step8() processes one 8 byte word with the
+ * slicing-by-8 algorithm and returns the new register value. The word is
+ * assembled from single bytes, which makes the routine independent of the
+ * endianness and alignment requirements of the platform.
+ */
+
+static uint32_t crc_32_step8( uint32_t crc, const unsigned char *ptr ) {
+
+	uint32_t low;
+	uint32_t high;
+
+	low  = crc ^ ( (uint32_t) ptr[0] | ( (uint32_t) ptr[1] << 8 ) | ( (uint32_t) ptr[2] << 16 ) | ( (uint32_t) ptr[3] << 24 ) );
+	high =         (uint32_t) ptr[4] | ( (uint32_t) ptr[5] << 8 ) | ( (uint32_t) ptr[6] << 16 ) | ( (uint32_t) ptr[7] << 24 );
+
+	return crc_tab32_slice8[7][  low         & 0xFF ]
+	     ^ crc_tab32_slice8[6][ (low  >>  8) & 0xFF ]
+	     ^ crc_tab32_slice8[5][ (low  >> 16) & 0xFF ]
+	     ^ crc_tab32_slice8[4][  low  >> 24         ]
+	     ^ crc_tab32_slice8[3][  high        & 0xFF ]
+	     ^ crc_tab32_slice8[2][ (high >>  8) & 0xFF ]
+	     ^ crc_tab32_slice8[1][ (high >> 16) & 0xFF ]
+	     ^ crc_tab32_slice8[0][  high >> 24         ];
+
+}  /* crc_32_step8 */
+
+/*
+ * static void crc_32_lanes( uint64_t crc[CRC_BATCH_LANES], const unsigned char *ptr[CRC_BATCH_LANES], size_t num_bytes );
+ *
+ * The function crc_32_lanes() updates four CRC-32 registers, each with the
+ * next num_bytes bytes of its own buffer. The slicing-by-8 steps of the four
+ * buffers alternate, so the processor can overlap the table lookups of the
+ * independent dependency chains. The pointers are advanced past the
+ * processed bytes.
+ */
+
+static void crc_32_lanes( uint64_t crc[CRC_BATCH_LANES], const unsigned char *ptr[CRC_BATCH_LANES], size_t num_bytes ) {
+
+	uint32_t crc0;
+	uint32_t crc1;
+	uint32_t crc2;
+	uint32_t crc3;
+	const unsigned char *ptr0;
+	const unsigned char *ptr1;
+	const unsigned char *ptr2;
+	const unsigned char *ptr3;
+
+	crc0 = (uint32_t) crc[0];
+	crc1 = (uint32_t) crc[1];
+	crc2 = (uint32_t) crc[2];
+	crc3 = (uint32_t) crc[3];
+	ptr0 = ptr[0];
+	ptr1 = ptr[1];
+	ptr2 = ptr[2];
+	ptr3 = ptr[3];
+
+	while ( num_bytes >= 8 ) {
+
+		crc0 = crc_32_step8( crc0, ptr0 );
+		crc1 = crc_32_step8( crc1, ptr1 );
+		crc2 = crc_32_step8( crc2, ptr2 );
+		crc3 = crc_32_step8( crc3, ptr3 );
+
+		ptr0      += 8;
+		ptr1      += 8;
+		ptr2      += 8;
+		ptr3      += 8;
+		num_bytes -= 8;
+	}
+
+	while ( num_bytes > 0 ) {
+
+		crc0 = (crc0 >> 8) ^ crc_tab32[ (crc0 ^ (uint32_t) *ptr0++) & 0x000000FFul ];
+		crc1 = (crc1 >> 8) ^ crc_tab32[ (crc1 ^ (uint32_t) *ptr1++) & 0x000000FFul ];
+		crc2 = (crc2 >> 8) ^ crc_tab32[ (crc2 ^ (uint32_t) *ptr2++) & 0x000000FFul ];
+		crc3 = (crc3 >> 8) ^ crc_tab32[ (crc3 ^ (uint32_t) *ptr3++) & 0x000000FFul ];
+		num_bytes--;
+	}
+
+	crc[0] = crc0;
+	crc[1] = crc1;
+	crc[2] = crc2;
+	crc[3] = crc3;
+	ptr[0] = ptr0;
+	ptr[1] = ptr1;
+	ptr[2] = ptr2;
+	ptr[3] = ptr3;
+
+}  /* crc_32_lanes */
+
+#if defined(LIBCRC_X86_64)
+
+/*
+ * static uint32_t crc_32_clmul( uint32_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crc_32_clmul() updates a CRC-32 value with the contents of a
+ * byte buffer with the carry-less multiplication instruction PCLMULQDQ. The
+ * algorithm is described in the Intel white paper "Fast CRC Computation for
+ * Generic Polynomials Using PCLMULQDQ Instruction". Four 128 bit accumulators
+ * are folded forward over 64 byte blocks, then combined into one accumulator
+ * which is folded over the remaining 16 byte blocks. The 128 bit remainder is
+ * reduced to 64 bits and finally to the 32 bit CRC with a Barrett reduction.
+ *
+ * All constants are bit reflected powers of x modulo the CRC-32 polynomial.
+ * The number of bytes must be a multiple of 16 and at least 64. The caller
+ * must have verified that the processor supports PCLMULQDQ and SSE4.1.
+ */
+
+LIBCRC_TARGET("pclmul,sse4.1")
+static uint32_t crc_32_clmul( uint32_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	__m128i x0;
+	__m128i x1;
+	__m128i x2;
+	__m128i x3;
+	__m128i x4;
+	__m128i x5;
+	__m128i x6;
+	__m128i x7;
+	__m128i x8;
+	__m128i mask32;
+
+	x1 = _mm_loadu_si128( (const __m128i *) (ptr + 0x00) );
+	x2 = _mm_loadu_si128( (const __m128i *) (ptr + 0x10) );
+	x3 = _mm_loadu_si128( (const __m128i *) (ptr + 0x20) );
+	x4 = _mm_loadu_si128( (const __m128i *) (ptr + 0x30) );
+
+	x1 = _mm_xor_si128( x1, _mm_cvtsi32_si128( (int) crc ) );
+
+	ptr       += 64;
+	num_bytes -= 64;
+
+	/*
+	 * Fold 512 bits, x^(4*128+32) and x^(4*128-32)
+	 */
+
+	x0 = _mm_set_epi64x( 0x01C6E41596ll, 0x0154442BD4ll );
+
+	while ( num_bytes >= 64 ) {
+
+		x5 = _mm_clmulepi64_si128( x1, x0, 0x00 );
+		x6 = _mm_clmulepi64_si128( x2, x0, 0x00 );
+		x7 = _mm_clmulepi64_si128( x3, x0, 0x00 );
+		x8 = _mm_clmulepi64_si128( x4, x0, 0x00 );
+
+		x1 = _mm_clmulepi64_si128( x1, x0, 0x11 );
+		x2 = _mm_clmulepi64_si128( x2, x0, 0x11 );
+		x3 = _mm_clmulepi64_si128( x3, x0, 0x11 );
+		x4 = _mm_clmulepi64_si128( x4, x0, 0x11 );
+
+		x1 = _mm_xor_si128( _mm_xor_si128( x1, x5 ), _mm_loadu_si128( (const __m128i *) (ptr + 0x00) ) );
+		x2 = _mm_xor_si128( _mm_xor_si128( x2, x6 ), _mm_loadu_si128( (const __m128i *) (ptr + 0x10) ) );
+		x3 = _mm_xor_si128( _mm_xor_si128( x3, x7 ), _mm_loadu_si128( (const __m128i *) (ptr + 0x20) ) );
+		x4 = _mm_xor_si128( _mm_xor_si128( x4, x8 ), _mm_loadu_si128( (const __m128i *) (ptr + 0x30) ) );
+
+		ptr       += 64;
+		num_bytes -= 64;
+	}
+
+	/*
+	 * Fold 128 bits, x^(128+32) and x^(128-32)
+	 */
+
+	x0 = _mm_set_epi64x( 0x00CCAA009Ell, 0x01751997D0ll );
+
+	x5 = _mm_clmulepi64_si128( x1, x0, 0x00 );
+	x1 = _mm_clmulepi64_si128( x1, x0, 0x11 );
+	x1 = _mm_xor_si128( _mm_xor_si128( x1, x2 ), x5 );
+
+	x5 = _mm_clmulepi64_si128( x1, x0, 0x00 );
+	x1 = _mm_clmulepi64_si128( x1, x0, 0x11 );
+	x1 = _mm_xor_si128( _mm_xor_si128( x1, x3 ), x5 );
+
+	x5 = _mm_clmulepi64_si128( x1, x0, 0x00 );
+	x1 = _mm_clmulepi64_si128( x1, x0, 0x11 );
+	x1 = _mm_xor_si128( _mm_xor_si128( x1, x4 ), x5 );
+
+	while ( num_bytes >= 16 ) {
+
+		x5 = _mm_clmulepi64_si128( x1, x0, 0x00 );
+		x1 = _mm_clmulepi64_si128( x1, x0, 0x11 );
+		x1 = _mm_xor_si128( _mm_xor_si128( x1, x5 ), _mm_loadu_si128( (const __m128i *) ptr ) );
+
+		ptr       += 16;
+		num_bytes -= 16;
+	}
+
+	/*
+	 * Reduce 128 to 64 bits, x^64 and x^(64+32)
+	 */
+
+	mask32 = _mm_setr_epi32( -1, 0, -1, 0 );
+
+	x2 = _mm_clmulepi64_si128( x1, x0, 0x10 );
+	x1 = _mm_xor_si128( _mm_srli_si128( x1, 8 ), x2 );
+
+	x0 = _mm_set_epi64x( 0, 0x0163CD6124ll );
+
+	x2 = _mm_srli_si128( x1, 4 );
+	x1 = _mm_and_si128( x1, mask32 );
+	x1 = _mm_clmulepi64_si128( x1, x0, 0x00 );
+	x1 = _mm_xor_si128( x1, x2 );
+
+	/*
+	 * Barrett reduction to 32 bits with the polynomial P(x) and mu = x^64 / P(x)
+	 */
+
+	x0 = _mm_set_epi64x( 0x01F7011641ll, 0x01DB710641ll );
+
+	x2 = _mm_and_si128( x1, mask32 );
+	x2 = _mm_clmulepi64_si128( x2, x0, 0x10 );
+	x2 = _mm_and_si128( x2, mask32 );
+	x2 = _mm_clmulepi64_si128( x2, x0, 0x00 );
+	x1 = _mm_xor_si128( x1, x2 );
+
+	return (uint32_t) _mm_extract_epi32( x1, 1 );
+
+}  /* crc_32_clmul */
+
+#endif
 
 /*
  * uint32_t update_crc_32( uint32_t crc, unsigned char c );
@@ -0,0 +1,511 @@
+/*
+ * Library: libcrc
+ * File:    src/crc32c.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2026 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crc32c.c contains the routines which are needed to
+ * calculate the 32 bit Castagnoli CRC-32C value of a sequence of bytes. This
+ * CRC is used in iSCSI, SCTP, ext4, Btrfs and many storage protocols.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "checksum.h"
+#include "crcint.h"
+
+#if defined(LIBCRC_X86_64)
+#include <immintrin.h>
+#endif
+
+/*
+ * #define CRC_32C_LONG, CRC_32C_SHORT
+ *
+ * The hardware CRC-32C routine splits the buffer in three streams of equal
+ * length which are calculated in parallel. This hides the latency of three
+ * clock cycles of the crc32 instruction. The stream lengths are CRC_32C_LONG
+ * bytes for large buffers and CRC_32C_SHORT bytes for the remainder. The
+ * precalc program generates the tables to merge streams of these lengths.
+ */
+
+#define CRC_32C_LONG		8192
+#define CRC_32C_SHORT		256
+
+/*
+ * #define CRC_32C_BATCH_MIN
+ *
+ * The three stream hardware routine already hides most of the latency of
+ * the crc32 instruction. The batch routine therefore only interleaves
+ * buffers of at least CRC_32C_BATCH_MIN bytes when the instruction is
+ * available.
+ */
+
+#define CRC_32C_BATCH_MIN	512
+
+static uint64_t		crc_32c_batch_block( uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+static void		crc_32c_lanes( uint64_t crc[CRC_BATCH_LANES], const unsigned char *ptr[CRC_BATCH_LANES], size_t num_bytes );
+static uint32_t		crc_32c_step8(  uint32_t crc, const unsigned char *ptr );
+static uint32_t		crc_32c_slice8( uint32_t crc, const unsigned char *ptr, size_t num_bytes );
+#if defined(LIBCRC_X86_64)
+static void		crc_32c_lanes_sse42( uint64_t crc[CRC_BATCH_LANES], const unsigned char *ptr[CRC_BATCH_LANES], size_t num_bytes );
+static uint32_t		crc_32c_sse42(  uint32_t crc, const unsigned char *ptr, size_t num_bytes );
+#endif
+
+/*
+ * Include the lookup tables for the CRC 32C calculation
+ */
+
+#include "../tab/gentab32c.inc"
+
+/*
+ * uint32_t crc_32c( const unsigned char *input_str, size_t num_bytes );
+ *
+ * The function crc_32c() calculates in one pass the Castagnoli 32 bit CRC
+ * value for a byte string that is passed to the function together with a
+ * parameter indicating the length. On x86-64 processors with SSE4.2 the crc32
+ * instruction is used, otherwise the calculation is done with slicing-by-8.
+ */
+
+uint32_t crc_32c( const unsigned char *input_str, size_t num_bytes ) {
+
+	uint32_t crc;
+
+	crc = CRC_START_32C;
+
+	if ( input_str != NULL ) crc = crc_32c_block( crc, input_str, num_bytes );
+
+	return (crc ^ 0xFFFFFFFFul);
+
+}  /* crc_32c */
+
+/*
+ * uint32_t crc_32c_block( uint32_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crc_32c_block() updates a CRC-32C register with the contents
+ * of a byte buffer with the kernel selected by the dispatch layer: the crc32
+ * instruction, slicing-by-8 or the byte-at-a-time loop.
+ */
+
+uint32_t crc_32c_block( uint32_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	const struct crc_dispatch_tp *disp;
+
+	disp = crc_dispatch();
+
+#if defined(LIBCRC_X86_64)
+	if ( disp->sse42 ) return crc_32c_sse42( crc, ptr, num_bytes );
+#endif
+
+	if ( disp->slice8 ) return crc_32c_slice8( crc, ptr, num_bytes );
+
+	while ( num_bytes-- > 0 ) crc = (crc >> 8) ^ crc_tab32c[ (crc ^ (uint32_t) *ptr++) & 0x000000FFul ];
+
+	return crc;
+
+}  /* crc_32c_block */
+
+/*
+ * void crc_32c_batch( const unsigned char *const bufs[], const size_t lens[], uint32_t out[], size_t n );
+ *
+ * The function crc_32c_batch() calculates the CRC-32C of n independent
+ * buffers and stores the results in the array out. The result for each
+ * buffer is the same as the result of crc_32c() for that buffer. Buffers of
+ * medium length are processed in an interleaved way, four at a time. With
+ * the crc32 instruction four instructions of different buffers are then in
+ * flight at the same time.
+ */
+
+void crc_32c_batch( const unsigned char *const bufs[], const size_t lens[], uint32_t out[], size_t n ) {
+
+	struct crc_batch_tp batch;
+
+	batch.bits      = 32;
+	batch.start     = CRC_START_32C;
+	batch.xor_out   = 0xFFFFFFFFul;
+	batch.lanes_min = CRC_BATCH_MIN;
+	batch.solo_min  = SIZE_MAX;
+	batch.lanes     = crc_32c_lanes;
+	batch.block     = crc_32c_batch_block;
+
+#if defined(LIBCRC_X86_64)
+	if ( crc_dispatch()->sse42 ) {
+
+		batch.lanes_min = CRC_32C_BATCH_MIN;
+		batch.lanes     = crc_32c_lanes_sse42;
+	}
+#endif
+
+	crc_batch_run( & batch, bufs, lens, out, n );
+
+}  /* crc_32c_batch */
+
+/*
+ * static uint64_t crc_32c_batch_block( uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crc_32c_batch_block() updates a CRC-32C register with the
+ * contents of one buffer for the batch routines.
+ */
+
+static uint64_t crc_32c_batch_block( uint64_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	return crc_32c_block( (uint32_t) crc, ptr, num_bytes );
+
+}  /* crc_32c_batch_block */
+
+/*
+ * uint32_t update_crc_32c( uint32_t crc, unsigned char c );
+ *
+ * The function update_crc_32c() calculates a new CRC-32C value based on the
+ * previous value of the CRC and the next byte of the data to be checked.
+ */
+
+uint32_t update_crc_32c( uint32_t crc, unsigned char c ) {
+
+	return (crc >> 8) ^ crc_tab32c[ (crc ^ (uint32_t) c) & 0x000000FFul ];
+
+}  /* update_crc_32c */
+
+/*
+ * static uint32_t crc_32c_slice8( uint32_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crc_32c_slice8() updates a CRC-32C value with the contents of
+ * a byte buffer using the slicing-by-8 algorithm. It is the portable version
+ * of the calculation.
+ */
+
+static uint32_t crc_32c_slice8( uint32_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	while ( num_bytes > 0  &&  ( (uintptr_t) ptr & 0x07 ) != 0 ) {
+
+		crc = (crc >> 8) ^ crc_tab32c[ (crc ^ (uint32_t) *ptr++) & 0x000000FFul ];
+		num_bytes--;
+	}
+
+	while ( num_bytes >= 8 ) {
+
+		crc        = crc_32c_step8( crc, ptr );
+		ptr       += 8;
+		num_bytes -= 8;
+	}
+
+	while ( num_bytes > 0 ) {
+
+		crc = (crc >> 8) ^ crc_tab32c[ (crc ^ (uint32_t) *ptr++) & 0x000000FFul ];
+		num_bytes--;
+	}
+
+	return crc;
+
+}  /* crc_32c_slice8 */
+
+/*
+ * static uint32_t crc_32c_step8( uint32_t crc, const unsigned char *ptr );
+ *
+ * The function crc_32c_step8() processes one 8 byte word with the
+ * slicing-by-8 algorithm and returns the new register value. The word is
+ * assembled from single bytes, which makes the routine independent of the
+ * endianness and alignment requirements of the platform.
+ */
+
+static uint32_t crc_32c_step8( uint32_t crc, const unsigned char *ptr ) {
+
+	uint32_t low;
+	uint32_t high;
+
+	low  = crc ^ ( (uint32_t) ptr[0] | ( (uint32_t) ptr[1] << 8 ) | ( (uint32_t) ptr[2] << 16 ) | ( (uint32_t) ptr[3] << 24 ) );
+	high =         (uint32_t) ptr[4] | ( (uint32_t) ptr[5] << 8 ) | ( (uint32_t) ptr[6] << 16 ) | ( (uint32_t) ptr[7] << 24 );
+
+	return crc_tab32c_slice8[7][  low         & 0xFF ]
+	     ^ crc_tab32c_slice8[6][ (low  >>  8) & 0xFF ]
+	     ^ crc_tab32c_slice8[5][ (low  >> 16) & 0xFF ]
+	     ^ crc_tab32c_slice8[4][  low  >> 24         ]
+	     ^ crc_tab32c_slice8[3][  high        & 0xFF ]
+	     ^ crc_tab32c_slice8[2][ (high >>  8) & 0xFF ]
+	     ^ crc_tab32c_slice8[1][ (high >> 16) & 0xFF ]
+	     ^ crc_tab32c_slice8[0][  high >> 24         ];
+
+}  /* crc_32c_step8 */
+
+/*
+ * static void crc_32c_lanes( uint64_t crc[CRC_BATCH_LANES], const unsigned char *ptr[CRC_BATCH_LANES], size_t num_bytes );
+ *
+ * The function crc_32c_lanes() is the table driven lane kernel of the batch
+ * routine. It updates four CRC-32C registers with num_bytes bytes of their
+ * buffers, alternating between the buffers after every 8 byte step. The
+ * pointers are advanced past the processed bytes.
+ */
+
+static void crc_32c_lanes( uint64_t crc[CRC_BATCH_LANES], const unsigned char *ptr[CRC_BATCH_LANES], size_t num_bytes ) {
+
+	uint32_t crc0;
+	uint32_t crc1;
+	uint32_t crc2;
+	uint32_t crc3;
+	const unsigned char *ptr0;
+	const unsigned char *ptr1;
+	const unsigned char *ptr2;
+	const unsigned char *ptr3;
+
+	crc0 = (uint32_t) crc[0];
+	crc1 = (uint32_t) crc[1];
+	crc2 = (uint32_t) crc[2];
+	crc3 = (uint32_t) crc[3];
+	ptr0 = ptr[0];
+	ptr1 = ptr[1];
+	ptr2 = ptr[2];
+	ptr3 = ptr[3];
+
+	while ( num_bytes >= 8 ) {
+
+		crc0 = crc_32c_step8( crc0, ptr0 );
+		crc1 = crc_32c_step8( crc1, ptr1 );
+		crc2 = crc_32c_step8( crc2, ptr2 );
+		crc3 = crc_32c_step8( crc3, ptr3 );
+
+		ptr0      += 8;
+		ptr1      += 8;
+		ptr2      += 8;
+		ptr3      += 8;
+		num_bytes -= 8;
+	}
+
+	while ( num_bytes > 0 ) {
+
+		crc0 = (crc0 >> 8) ^ crc_tab32c[ (crc0 ^ (uint32_t) *ptr0++) & 0x000000FFul ];
+		crc1 = (crc1 >> 8) ^ crc_tab32c[ (crc1 ^ (uint32_t) *ptr1++) & 0x000000FFul ];
+		crc2 = (crc2 >> 8) ^ crc_tab32c[ (crc2 ^ (uint32_t) *ptr2++) & 0x000000FFul ];
+		crc3 = (crc3 >> 8) ^ crc_tab32c[ (crc3 ^ (uint32_t) *ptr3++) & 0x000000FFul ];
+		num_bytes--;
+	}
+
+	crc[0] = crc0;
+	crc[1] = crc1;
+	crc[2] = crc2;
+	crc[3] = crc3;
+	ptr[0] = ptr0;
+	ptr[1] = ptr1;
+	ptr[2] = ptr2;
+	ptr[3] = ptr3;
+
+}  /* crc_32c_lanes */
+
+#if defined(LIBCRC_X86_64)
+
+/*
+ * static uint32_t crc_32c_shift( const uint32_t shift_tab[4][256], uint32_t crc );
+ *
+ * The function crc_32c_shift() moves a CRC-32C register value forward over the
+ * number of zero bytes for which the shift tables have been generated.
+ */
+
+static inline uint32_t crc_32c_shift( const uint32_t shift_tab[4][256], uint32_t crc ) {
+
+	return shift_tab[0][  crc        & 0xFF ]
+	     ^ shift_tab[1][ (crc >>  8) & 0xFF ]
+	     ^ shift_tab[2][ (crc >> 16) & 0xFF ]
+	     ^ shift_tab[3][  crc >> 24         ];
+
+}  /* crc_32c_shift */
+
+/*
+ * static uint32_t crc_32c_sse42( uint32_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crc_32c_sse42() updates a CRC-32C value with the crc32
+ * instruction of SSE4.2. The instruction has a latency of three clock cycles,
+ * but a new instruction can be started every cycle. The buffer is therefore
+ * processed as three streams of equal length. The streams are calculated
+ * independently and their CRC values are merged afterwards with the shift
+ * tables: the CRC of the concatenation of A and B is the CRC of A shifted over
+ * the length of B, XORed with the CRC of B calculated from a zero register.
+ */
+
+LIBCRC_TARGET("sse4.2")
+static uint32_t crc_32c_sse42( uint32_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	uint64_t crc0;
+	uint64_t crc1;
+	uint64_t crc2;
+	uint64_t word0;
+	uint64_t word1;
+	uint64_t word2;
+	const unsigned char *end;
+
+	crc0 = crc;
+
+	while ( num_bytes > 0  &&  ( (uintptr_t) ptr & 0x07 ) != 0 ) {
+
+		crc0 = _mm_crc32_u8( (uint32_t) crc0, *ptr++ );
+		num_bytes--;
+	}
+
+	while ( num_bytes >= 3*CRC_32C_LONG ) {
+
+		crc1 = 0;
+		crc2 = 0;
+		end  = ptr + CRC_32C_LONG;
+
+		do {
+			memcpy( & word0, ptr,                  8 );
+			memcpy( & word1, ptr +   CRC_32C_LONG, 8 );
+			memcpy( & word2, ptr + 2*CRC_32C_LONG, 8 );
+
+			crc0 = _mm_crc32_u64( crc0, word0 );
+			crc1 = _mm_crc32_u64( crc1, word1 );
+			crc2 = _mm_crc32_u64( crc2, word2 );
+
+			ptr += 8;
+
+		} while ( ptr < end );
+
+		crc0 = crc_32c_shift( crc_tab32c_long, (uint32_t) crc0 ) ^ crc1;
+		crc0 = crc_32c_shift( crc_tab32c_long, (uint32_t) crc0 ) ^ crc2;
+
+		ptr       += 2*CRC_32C_LONG;
+		num_bytes -= 3*CRC_32C_LONG;
+	}
+
+	while ( num_bytes >= 3*CRC_32C_SHORT ) {
+
+		crc1 = 0;
+		crc2 = 0;
+		end  = ptr + CRC_32C_SHORT;
+
+		do {
+			memcpy( & word0, ptr,                   8 );
+			memcpy( & word1, ptr +   CRC_32C_SHORT, 8 );
+			memcpy( & word2, ptr + 2*CRC_32C_SHORT, 8 );
+
+			crc0 = _mm_crc32_u64( crc0, word0 );
+			crc1 = _mm_crc32_u64( crc1, word1 );
+			crc2 = _mm_crc32_u64( crc2, word2 );
+
+			ptr += 8;
+
+		} while ( ptr < end );
+
+		crc0 = crc_32c_shift( crc_tab32c_short, (uint32_t) crc0 ) ^ crc1;
+		crc0 = crc_32c_shift( crc_tab32c_short, (uint32_t) crc0 ) ^ crc2;
+
+		ptr       += 2*CRC_32C_SHORT;
+		num_bytes -= 3*CRC_32C_SHORT;
+	}
+
+	while ( num_bytes >= 8 ) {
+
+		memcpy( & word0, ptr, 8 );
+		crc0       = _mm_crc32_u64( crc0, word0 );
+		ptr       += 8;
+		num_bytes -= 8;
+	}
+
+	while ( num_bytes > 0 ) {
+
+		crc0 = _mm_crc32_u8( (uint32_t) crc0, *ptr++ );
+		num_bytes--;
+	}
+
+	return (uint32_t) crc0;
+
+}  /* crc_32c_sse42 */
+
+/*
+ * static void crc_32c_lanes_sse42( uint64_t crc[CRC_BATCH_LANES], const unsigned char *ptr[CRC_BATCH_LANES], size_t num_bytes );
+ *
+ * The function crc_32c_lanes_sse42() updates the CRC-32C registers of four
+ * independent buffers with the same number of bytes of each buffer with the
+ * crc32 instruction. The instruction has a latency of three cycles but can
+ * start every cycle, which the four independent registers exploit. The
+ * pointers are advanced past the processed bytes. The caller must have
+ * verified that the processor supports SSE4.2.
+ */
+
+LIBCRC_TARGET("sse4.2")
+static void crc_32c_lanes_sse42( uint64_t crc[CRC_BATCH_LANES], const unsigned char *ptr[CRC_BATCH_LANES], size_t num_bytes ) {
+
+	uint64_t crc0;
+	uint64_t crc1;
+	uint64_t crc2;
+	uint64_t crc3;
+	uint64_t word0;
+	uint64_t word1;
+	uint64_t word2;
+	uint64_t word3;
+	const unsigned char *ptr0;
+	const unsigned char *ptr1;
+	const unsigned char *ptr2;
+	const unsigned char *ptr3;
+
+	crc0 = crc[0];
+	crc1 = crc[1];
+	crc2 = crc[2];
+	crc3 = crc[3];
+	ptr0 = ptr[0];
+	ptr1 = ptr[1];
+	ptr2 = ptr[2];
+	ptr3 = ptr[3];
+
+	while ( num_bytes >= 8 ) {
+
+		memcpy( & word0, ptr0, 8 );
+		memcpy( & word1, ptr1, 8 );
+		memcpy( & word2, ptr2, 8 );
+		memcpy( & word3, ptr3, 8 );
+
+		crc0 = _mm_crc32_u64( crc0, word0 );
+		crc1 = _mm_crc32_u64( crc1, word1 );
+		crc2 = _mm_crc32_u64( crc2, word2 );
+		crc3 = _mm_crc32_u64( crc3, word3 );
+
+		ptr0      += 8;
+		ptr1      += 8;
+		ptr2      += 8;
+		ptr3      += 8;
+		num_bytes -= 8;
+	}
+
+	while ( num_bytes > 0 ) {
+
+		crc0 = _mm_crc32_u8( (uint32_t) crc0, *ptr0++ );
+		crc1 = _mm_crc32_u8( (uint32_t) crc1, *ptr1++ );
+		crc2 = _mm_crc32_u8( (uint32_t) crc2, *ptr2++ );
+		crc3 = _mm_crc32_u8( (uint32_t) crc3, *ptr3++ );
+		num_bytes--;
+	}
+
+	crc[0] = crc0;
+	crc[1] = crc1;
+	crc[2] = crc2;
+	crc[3] = crc3;
+	ptr[0] = ptr0;
+	ptr[1] = ptr1;
+	ptr[2] = ptr2;
+	ptr[3] = ptr3;
+
+}  /* crc_32c_lanes_sse42 */
+
+#endif
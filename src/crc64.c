@@ -32,11 +32,17 @@
  */
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include "checksum.h"
+#include "crcint.h"
+
+static void		crc_64_lanes( uint64_t crc[CRC_BATCH_LANES], const unsigned char *ptr[CRC_BATCH_LANES], size_t num_bytes );
+static uint64_t		crc_64_step8(  uint64_t crc, const unsigned char *ptr );
+static uint64_t		crc_64_slice8( uint64_t crc, const unsigned char *ptr, size_t num_bytes );
 
 /*
- * Include the lookup table for the CRC 64 calculation
+ * Include the lookup tables for the CRC 64 calculation
  */
 
 #include "../tab/gentab64.inc"
@@ -52,16 +58,10 @@
 uint64_t crc_64_ecma( const unsigned char *input_str, size_t num_bytes ) {
 
 	uint64_t crc;
-	const unsigned char *ptr;
-	size_t a;
 
 	crc = CRC_START_64_ECMA;
-	ptr = input_str;
-
-	if ( ptr != NULL ) for (a=0; a<num_bytes; a++) {
 
-		crc = (crc << 8) ^ crc_tab64[ ((crc >> 56) ^ (uint64_t) *ptr++) & 0x00000000000000FFull ];
-	}
+	if ( input_str != NULL ) crc = crc_64_block( crc, input_str, num_bytes );
 
 	return crc;
 
@@ -78,16 +78,10 @@ uint64_t crc_64_ecma( const unsigned char *input_str, size_t num_bytes ) {
 uint64_t crc_64_we( const unsigned char *input_str, size_t num_bytes ) {
 
 	uint64_t crc;
-	const unsigned char *ptr;
-	size_t a;
 
 	crc = CRC_START_64_WE;
-	ptr = input_str;
 
-	if ( ptr != NULL ) for (a=0; a<num_bytes; a++) {
-
-		crc = (crc << 8) ^ crc_tab64[ ((crc >> 56) ^ (uint64_t) *ptr++) & 0x00000000000000FFull ];
-	}
+	if ( input_str != NULL ) crc = crc_64_block( crc, input_str, num_bytes );
 
 	return crc ^ 0xFFFFFFFFFFFFFFFFull;
 
@@ -105,3 +99,216 @@ uint64_t update_crc_64( uint64_t crc, unsigned char c ) {
 	return (crc << 8) ^ crc_tab64[ ((crc >> 56) ^ (uint64_t) c) & 0x00000000000000FFull ];
 
 }  /* update_crc_64 */
+
+/*
+ * uint64_t crc_64_block( uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crc_64_block() updates a CRC-64 register with the contents of a
+ * byte buffer with the kernels selected by the dispatch layer. Long buffers
+ * are folded with carry-less multiplication when that level is active. The
+ * 128 bit remainder of the folding kernel is then processed with
+ * slicing-by-8, the remaining bytes with slicing-by-8 or one byte at a time.
+ */
+
+uint64_t crc_64_block( uint64_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	const struct crc_dispatch_tp *disp;
+#if defined(LIBCRC_X86_64)
+	size_t num_fold;
+	unsigned char remainder[16];
+#endif
+
+	disp = crc_dispatch();
+
+#if defined(LIBCRC_X86_64)
+	if ( num_bytes >= disp->clmul_min_64 ) {
+
+		num_fold = num_bytes & ~( (size_t) 0x0F );
+
+		crc_fold_msb( ptr, num_fold, crc, & crc_tab64_fold, remainder );
+
+		crc        = crc_64_slice8( 0, remainder, 16 );
+		ptr       += num_fold;
+		num_bytes -= num_fold;
+	}
+#endif
+
+	if ( disp->slice8 ) return crc_64_slice8( crc, ptr, num_bytes );
+
+	while ( num_bytes-- > 0 ) crc = (crc << 8) ^ crc_tab64[ ((crc >> 56) ^ (uint64_t) *ptr++) & 0x00000000000000FFull ];
+
+	return crc;
+
+}  /* crc_64_block */
+
+/*
+ * void crc_64_ecma_batch( const unsigned char *const bufs[], const size_t lens[], uint64_t out[], size_t n );
+ *
+ * The function crc_64_ecma_batch() calculates the ECMA 64 bit CRC of n
+ * independent buffers and stores the results in the array out. The result
+ * for each buffer is the same as the result of crc_64_ecma() for that
+ * buffer. The short buffers are processed in an interleaved way, four at a
+ * time. Buffers long enough for the folding kernels are processed one at a
+ * time.
+ */
+
+void crc_64_ecma_batch( const unsigned char *const bufs[], const size_t lens[], uint64_t out[], size_t n ) {
+
+	struct crc_batch_tp batch;
+
+	batch.bits      = 64;
+	batch.start     = CRC_START_64_ECMA;
+	batch.xor_out   = 0x0000000000000000ull;
+	batch.lanes_min = CRC_BATCH_MIN;
+	batch.solo_min  = crc_dispatch()->clmul_min_64;
+	batch.lanes     = crc_64_lanes;
+	batch.block     = crc_64_block;
+
+	crc_batch_run( & batch, bufs, lens, out, n );
+
+}  /* crc_64_ecma_batch */
+
+/*
+ * void crc_64_we_batch( const unsigned char *const bufs[], const size_t lens[], uint64_t out[], size_t n );
+ *
+ * The function crc_64_we_batch() calculates the CRC64-WE 64 bit CRC of n
+ * independent buffers and stores the results in the array out. The result
+ * for each buffer is the same as the result of crc_64_we() for that buffer.
+ */
+
+void crc_64_we_batch( const unsigned char *const bufs[], const size_t lens[], uint64_t out[], size_t n ) {
+
+	struct crc_batch_tp batch;
+
+	batch.bits      = 64;
+	batch.start     = CRC_START_64_WE;
+	batch.xor_out   = 0xFFFFFFFFFFFFFFFFull;
+	batch.lanes_min = CRC_BATCH_MIN;
+	batch.solo_min  = crc_dispatch()->clmul_min_64;
+	batch.lanes     = crc_64_lanes;
+	batch.block     = crc_64_block;
+
+	crc_batch_run( & batch, bufs, lens, out, n );
+
+}  /* crc_64_we_batch */
+
+/*
+ * static uint64_t crc_64_slice8( uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crc_64_slice8() updates a CRC-64 register with the contents of
+ * a byte buffer using the slicing-by-8 algorithm. Because the CRC is
+ * calculated with the most significant bit first, the eight bytes are combined
+ * in big endian order with the register before the table lookups.
+ */
+
+static uint64_t crc_64_slice8( uint64_t crc, const unsigned char *ptr, size_t num_bytes ) {
+
+	while ( num_bytes > 0  &&  ( (uintptr_t) ptr & 0x07 ) != 0 ) {
+
+		crc = (crc << 8) ^ crc_tab64[ ((crc >> 56) ^ (uint64_t) *ptr++) & 0x00000000000000FFull ];
+		num_bytes--;
+	}
+
+	while ( num_bytes >= 8 ) {
+
+		crc        = crc_64_step8( crc, ptr );
+		ptr       += 8;
+		num_bytes -= 8;
+	}
+
+	while ( num_bytes > 0 ) {
+
+		crc = (crc << 8) ^ crc_tab64[ ((crc >> 56) ^ (uint64_t) *ptr++) & 0x00000000000000FFull ];
+		num_bytes--;
+	}
+
+	return crc;
+
+}  /* crc_64_slice8 */
+
+/*
+ * static uint64_t crc_64_step8( uint64_t crc, const unsigned char *ptr );
+ *
+ * The function crc_64_step8() processes one 8 byte word with the
+ * slicing-by-8 algorithm and returns the new register value. The bytes are
+ * combined in big endian order with the register before the table lookups.
+ */
+
+static uint64_t crc_64_step8( uint64_t crc, const unsigned char *ptr ) {
+
+	crc ^= ( (uint64_t) ptr[0] << 56 ) | ( (uint64_t) ptr[1] << 48 ) | ( (uint64_t) ptr[2] << 40 ) | ( (uint64_t) ptr[3] << 32 )
+	     | ( (uint64_t) ptr[4] << 24 ) | ( (uint64_t) ptr[5] << 16 ) | ( (uint64_t) ptr[6] <<  8 ) |   (uint64_t) ptr[7];
+
+	return crc_tab64_slice8[7][  crc >> 56         ]
+	     ^ crc_tab64_slice8[6][ (crc >> 48) & 0xFF ]
+	     ^ crc_tab64_slice8[5][ (crc >> 40) & 0xFF ]
+	     ^ crc_tab64_slice8[4][ (crc >> 32) & 0xFF ]
+	     ^ crc_tab64_slice8[3][ (crc >> 24) & 0xFF ]
+	     ^ crc_tab64_slice8[2][ (crc >> 16) & 0xFF ]
+	     ^ crc_tab64_slice8[1][ (crc >>  8) & 0xFF ]
+	     ^ crc_tab64_slice8[0][  crc        & 0xFF ];
+
+}  /* crc_64_step8 */
+
+/*
+ * static void crc_64_lanes( uint64_t crc[CRC_BATCH_LANES], const unsigned char *ptr[CRC_BATCH_LANES], size_t num_bytes );
+ *
+ * The function crc_64_lanes() updates four CRC-64 registers with num_bytes
+ * bytes of four buffers. It is shared by the ECMA and WE variants, which only
+ * differ in start value and final XOR. The slicing-by-8 steps of the buffers
+ * are interleaved and the pointers are advanced past the processed bytes.
+ */
+
+static void crc_64_lanes( uint64_t crc[CRC_BATCH_LANES], const unsigned char *ptr[CRC_BATCH_LANES], size_t num_bytes ) {
+
+	uint64_t crc0;
+	uint64_t crc1;
+	uint64_t crc2;
+	uint64_t crc3;
+	const unsigned char *ptr0;
+	const unsigned char *ptr1;
+	const unsigned char *ptr2;
+	const unsigned char *ptr3;
+
+	crc0 = crc[0];
+	crc1 = crc[1];
+	crc2 = crc[2];
+	crc3 = crc[3];
+	ptr0 = ptr[0];
+	ptr1 = ptr[1];
+	ptr2 = ptr[2];
+	ptr3 = ptr[3];
+
+	while ( num_bytes >= 8 ) {
+
+		crc0 = crc_64_step8( crc0, ptr0 );
+		crc1 = crc_64_step8( crc1, ptr1 );
+		crc2 = crc_64_step8( crc2, ptr2 );
+		crc3 = crc_64_step8( crc3, ptr3 );
+
+		ptr0      += 8;
+		ptr1      += 8;
+		ptr2      += 8;
+		ptr3      += 8;
+		num_bytes -= 8;
+	}
+
+	while ( num_bytes > 0 ) {
+
+		crc0 = (crc0 << 8) ^ crc_tab64[ ((crc0 >> 56) ^ (uint64_t) *ptr0++) & 0x00000000000000FFull ];
+		crc1 = (crc1 << 8) ^ crc_tab64[ ((crc1 >> 56) ^ (uint64_t) *ptr1++) & 0x00000000000000FFull ];
+		crc2 = (crc2 << 8) ^ crc_tab64[ ((crc2 >> 56) ^ (uint64_t) *ptr2++) & 0x00000000000000FFull ];
+		crc3 = (crc3 << 8) ^ crc_tab64[ ((crc3 >> 56) ^ (uint64_t) *ptr3++) & 0x00000000000000FFull ];
+		num_bytes--;
+	}
+
+	crc[0] = crc0;
+	crc[1] = crc1;
+	crc[2] = crc2;
+	crc[3] = crc3;
+	ptr[0] = ptr0;
+	ptr[1] = ptr1;
+	ptr[2] = ptr2;
+	ptr[3] = ptr3;
+
+}  /* crc_64_lanes */
@@ -0,0 +1,152 @@
+/*
+ * Library: libcrc
+ * File:    src/crcbatch.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2026 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crcbatch.c contains the common part of the routines
+ * which calculate the CRC of many independent buffers in one call. The CRC
+ * of a single short buffer is one long chain of dependent table lookups, of
+ * which the processor can only execute a few at the same time. The batch
+ * routines keep CRC_BATCH_LANES buffers in flight and advance them together,
+ * which gives the processor independent work to overlap. A lane which
+ * reaches the end of its buffer is refilled with the next buffer, so
+ * buffers of different lengths keep all lanes busy.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "checksum.h"
+#include "crcint.h"
+
+static void		store_result( const struct crc_batch_tp *batch, void *out, size_t index, uint64_t crc );
+
+/*
+ * void crc_batch_run( const struct crc_batch_tp *batch, const unsigned char *const bufs[], const size_t lens[], void *out, size_t n );
+ *
+ * The function crc_batch_run() calculates the CRC of n buffers with the
+ * algorithm described by batch and stores the results in the array out,
+ * which has elements of the width of the CRC. NULL buffers, buffers which
+ * are long enough for the folding kernels and buffers too short to gain from
+ * the interleave are handled on their own. The other buffers are distributed
+ * over the lanes, which are advanced by the largest multiple of 8 bytes which
+ * all of them still have. The last bytes of a buffer, and the rest of each
+ * buffer when fewer buffers remain than there are lanes, are processed with
+ * the block routine. With the generic implementation level all buffers are
+ * processed one at a time.
+ */
+
+void crc_batch_run( const struct crc_batch_tp *batch, const unsigned char *const bufs[], const size_t lens[], void *out, size_t n ) {
+
+	int lane;
+	int active;
+	size_t next;
+	size_t step;
+	size_t solo_min;
+	size_t index[CRC_BATCH_LANES];
+	size_t left[CRC_BATCH_LANES];
+	const unsigned char *ptr[CRC_BATCH_LANES];
+	uint64_t crc[CRC_BATCH_LANES];
+
+	solo_min = ( crc_dispatch()->slice8 ) ? batch->solo_min : 0;
+	active   = 0;
+	next     = 0;
+
+	for (;;) {
+
+		while ( active < CRC_BATCH_LANES  &&  next < n ) {
+
+			if ( bufs[next] == NULL ) store_result( batch, out, next, batch->start );
+
+			else if ( lens[next] < batch->lanes_min  ||  lens[next] >= solo_min ) store_result( batch, out, next, batch->block( batch->start, bufs[next], lens[next] ) );
+
+			else {
+				index[active] = next;
+				ptr[active]   = bufs[next];
+				left[active]  = lens[next];
+				crc[active]   = batch->start;
+				active++;
+			}
+
+			next++;
+		}
+
+		if ( active < CRC_BATCH_LANES ) break;
+
+		/*
+		 * Lanes with less than one 8 byte word left are finished with the
+		 * block routine and replaced by the last active lane. Walking
+		 * backwards guarantees that the moved lane was already checked.
+		 */
+
+		for (lane=CRC_BATCH_LANES-1; lane>=0; lane--) {
+
+			if ( left[lane] >= 8 ) continue;
+
+			store_result( batch, out, index[lane], batch->block( crc[lane], ptr[lane], left[lane] ) );
+
+			active--;
+			index[lane] = index[active];
+			ptr[lane]   = ptr[active];
+			left[lane]  = left[active];
+			crc[lane]   = crc[active];
+		}
+
+		if ( active < CRC_BATCH_LANES ) continue;
+
+		step = left[0];
+		for (lane=1; lane<CRC_BATCH_LANES; lane++) if ( left[lane] < step ) step = left[lane];
+		step &= ~( (size_t) 0x07 );
+
+		batch->lanes( crc, ptr, step );
+
+		for (lane=0; lane<CRC_BATCH_LANES; lane++) left[lane] -= step;
+	}
+
+	for (lane=0; lane<active; lane++) store_result( batch, out, index[lane], batch->block( crc[lane], ptr[lane], left[lane] ) );
+
+}  /* crc_batch_run */
+
+/*
+ * static void store_result( const struct crc_batch_tp *batch, void *out, size_t index, uint64_t crc );
+ *
+ * The function store_result() applies the final XOR to a CRC register and
+ * stores the value in the output array of the batch routine.
+ */
+
+static void store_result( const struct crc_batch_tp *batch, void *out, size_t index, uint64_t crc ) {
+
+	crc ^= batch->xor_out;
+
+	switch ( batch->bits ) {
+
+		case 16 : ((uint16_t *) out)[index] = (uint16_t) crc; break;
+		case 32 : ((uint32_t *) out)[index] = (uint32_t) crc; break;
+		default : ((uint64_t *) out)[index] =            crc; break;
+	}
+
+}  /* store_result */
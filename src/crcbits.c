@@ -0,0 +1,451 @@
+/*
+ * Library: libcrc
+ * File:    src/crcbits.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2026 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crcbits.c contains a bit-sliced CRC engine which checks
+ * up to 64 messages of equal length at once. Bit m of every message byte and
+ * of every CRC register is kept in bit plane m, a 64 bit word in which bit j
+ * belongs to message j. One step of the CRC then consists only of XOR
+ * operations on whole planes, which calculate the CRC of all 64 messages
+ * together without any table lookups. The messages are converted to bit
+ * planes eight bytes at a time with a transposition of 64 by 64 bits. This is
+ * efficient for large numbers of short frames, where the call overhead of
+ * the table driven routines for each single message dominates.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "checksum.h"
+#include "crcint.h"
+
+/*
+ * #define CRC_VERIFY_LANES
+ *
+ * The number of messages which the bit-sliced engine processes at the same
+ * time. This equals the number of bits in a bit plane.
+ */
+
+#define CRC_VERIFY_LANES	64
+
+/*
+ * #define CRC_VERIFY_MAX
+ *
+ * The transposition of the messages to bit planes costs about as much as
+ * the slicing-by-8 calculation of one message byte. For messages longer
+ * than CRC_VERIFY_MAX bytes the table driven routine is therefore used for
+ * each message and the bit-sliced engine only for shorter messages.
+ */
+
+#define CRC_VERIFY_MAX		16
+
+static void		expected_planes( const uint64_t word[8], uint64_t plane[8] );
+static void		load_words(      const unsigned char *const msgs[], size_t pos, size_t len, size_t num_msgs, uint64_t word[CRC_VERIFY_LANES] );
+static size_t		store_failures(  const uint64_t crc[], const uint64_t expect[], int num_planes, size_t num_msgs, uint64_t *failed );
+static void		step_crc_8(      uint64_t crc[8], const uint64_t data[8] );
+static void		step_crc_16_lsb( uint64_t crc[16], const uint64_t data[8] );
+static void		transpose_64x64( uint64_t word[CRC_VERIFY_LANES] );
+static void		transpose_round( uint64_t word[CRC_VERIFY_LANES], int j, uint64_t mask );
+static uint64_t		transpose_8x8(   uint64_t x );
+
+/*
+ * size_t crc_8_verify( const unsigned char *const msgs[], size_t num_bytes, const uint8_t expected[], uint64_t failed[], size_t n );
+ *
+ * The function crc_8_verify() calculates the crc_8() value of n messages of
+ * num_bytes bytes each and compares them with the values in expected. Bit
+ * i % 64 of failed[i / 64] is set when message i has a different CRC and
+ * cleared otherwise. The function returns the number of failed messages.
+ * Messages longer than CRC_VERIFY_MAX bytes are checked one at a time with
+ * the table driven routine.
+ */
+
+size_t crc_8_verify( const unsigned char *const msgs[], size_t num_bytes, const uint8_t expected[], uint64_t failed[], size_t n ) {
+
+	int b;
+	size_t a;
+	size_t q;
+	size_t base;
+	size_t pos;
+	size_t len;
+	size_t num_msgs;
+	size_t errors;
+	uint64_t word[CRC_VERIFY_LANES];
+	uint64_t crc[8];
+	uint64_t expect[8];
+
+	errors = 0;
+
+	if ( num_bytes > CRC_VERIFY_MAX ) {
+
+		for (a=0; a<n; a++) {
+
+			if ( a % CRC_VERIFY_LANES == 0 ) failed[a/CRC_VERIFY_LANES] = 0;
+
+			if ( crc_8( msgs[a], num_bytes ) != expected[a] ) {
+
+				failed[a/CRC_VERIFY_LANES] |= 1ull << (a%CRC_VERIFY_LANES);
+				errors++;
+			}
+		}
+
+		return errors;
+	}
+
+	for (base=0; base<n; base+=CRC_VERIFY_LANES) {
+
+		num_msgs = ( n - base < CRC_VERIFY_LANES ) ? n - base : CRC_VERIFY_LANES;
+
+		for (b=0; b<8; b++) crc[b] = ( CRC_START_8 & (1u << b) ) ? ~0ull : 0;
+
+		for (pos=0; pos<num_bytes; pos+=len) {
+
+			len = ( num_bytes - pos < 8 ) ? num_bytes - pos : 8;
+
+			load_words( msgs + base, pos, len, num_msgs, word );
+			transpose_64x64( word );
+
+			for (q=0; q<len; q++) step_crc_8( crc, word + 8*q );
+		}
+
+		for (a=0; a<8; a++) word[a] = 0;
+		for (a=0; a<num_msgs; a++) word[a/8] |= (uint64_t) expected[base+a] << ( 8 * (a%8) );
+		expected_planes( word, expect );
+
+		errors += store_failures( crc, expect, 8, num_msgs, failed + base / CRC_VERIFY_LANES );
+	}
+
+	return errors;
+
+}  /* crc_8_verify */
+
+/*
+ * size_t crc_modbus_verify( const unsigned char *const msgs[], size_t num_bytes, const uint16_t expected[], uint64_t failed[], size_t n );
+ *
+ * The function crc_modbus_verify() checks the crc_modbus() value of n
+ * messages of num_bytes bytes each against the values in expected in the
+ * same way as crc_8_verify() does for the 8 bit CRC.
+ */
+
+size_t crc_modbus_verify( const unsigned char *const msgs[], size_t num_bytes, const uint16_t expected[], uint64_t failed[], size_t n ) {
+
+	int b;
+	size_t a;
+	size_t q;
+	size_t base;
+	size_t pos;
+	size_t len;
+	size_t num_msgs;
+	size_t errors;
+	uint64_t word[CRC_VERIFY_LANES];
+	uint64_t crc[16];
+	uint64_t expect[16];
+
+	errors = 0;
+
+	if ( num_bytes > CRC_VERIFY_MAX ) {
+
+		for (a=0; a<n; a++) {
+
+			if ( a % CRC_VERIFY_LANES == 0 ) failed[a/CRC_VERIFY_LANES] = 0;
+
+			if ( crc_modbus( msgs[a], num_bytes ) != expected[a] ) {
+
+				failed[a/CRC_VERIFY_LANES] |= 1ull << (a%CRC_VERIFY_LANES);
+				errors++;
+			}
+		}
+
+		return errors;
+	}
+
+	for (base=0; base<n; base+=CRC_VERIFY_LANES) {
+
+		num_msgs = ( n - base < CRC_VERIFY_LANES ) ? n - base : CRC_VERIFY_LANES;
+
+		for (b=0; b<16; b++) crc[b] = ( CRC_START_MODBUS & (1u << b) ) ? ~0ull : 0;
+
+		for (pos=0; pos<num_bytes; pos+=len) {
+
+			len = ( num_bytes - pos < 8 ) ? num_bytes - pos : 8;
+
+			load_words( msgs + base, pos, len, num_msgs, word );
+			transpose_64x64( word );
+
+			for (q=0; q<len; q++) step_crc_16_lsb( crc, word + 8*q );
+		}
+
+		for (a=0; a<16; a++) word[a] = 0;
+
+		for (a=0; a<num_msgs; a++) {
+
+			word[a/8  ] |= (uint64_t) ( expected[base+a] & 0x00FF ) << ( 8 * (a%8) );
+			word[a/8+8] |= (uint64_t) ( expected[base+a] >> 8     ) << ( 8 * (a%8) );
+		}
+
+		expected_planes( word,     expect     );
+		expected_planes( word + 8, expect + 8 );
+
+		errors += store_failures( crc, expect, 16, num_msgs, failed + base / CRC_VERIFY_LANES );
+	}
+
+	return errors;
+
+}  /* crc_modbus_verify */
+
+/*
+ * static void step_crc_8( uint64_t crc[8], const uint64_t data[8] );
+ *
+ * The function step_crc_8() adds one byte of every message to the bit-sliced
+ * registers of the CRC-8 calculation with polynomial 0x31. The lookup table
+ * of the CRC is linear, so the new register is the XOR of the table values
+ * of the single bits of the register XORed with the data byte. These values
+ * are 0x31, 0x62, 0xC4, 0xB9, 0x43, 0x86, 0x3D and 0x7A for bits 0 to 7,
+ * which results in the equations below.
+ */
+
+static void step_crc_8( uint64_t crc[8], const uint64_t data[8] ) {
+
+	int m;
+	uint64_t x[8];
+
+	for (m=0; m<8; m++) x[m] = crc[m] ^ data[m];
+
+	crc[0]  = x[0] ^ x[3] ^ x[4] ^ x[6];
+	crc[1]  = x[1] ^ x[4] ^ x[5] ^ x[7];
+	crc[2]  = x[2] ^ x[5] ^ x[6];
+	crc[3]  = x[3] ^ x[6] ^ x[7];
+	crc[4]  = x[0] ^ x[3] ^ x[6] ^ x[7];
+	crc[5]  = x[0] ^ x[1] ^ x[3] ^ x[6] ^ x[7];
+	crc[6]  = x[1] ^ x[2] ^ x[4] ^ x[7];
+	crc[7]  = x[2] ^ x[3] ^ x[5];
+
+}  /* step_crc_8 */
+
+/*
+ * static void step_crc_16_lsb( uint64_t crc[16], const uint64_t data[8] );
+ *
+ * The function step_crc_16_lsb() adds one byte of every message to the
+ * bit-sliced registers of the reflected 16 bit CRC with polynomial 0xA001.
+ * The high byte of the register moves to the low byte, and the table values
+ * 0xC0C1, 0xC181, 0xC301, 0xC601, 0xCC01, 0xD801, 0xF001 and 0xA001 of the
+ * bits of the low byte XORed with the data are added.
+ */
+
+static void step_crc_16_lsb( uint64_t crc[16], const uint64_t data[8] ) {
+
+	int m;
+	uint64_t x[8];
+
+	for (m=0; m<8; m++) x[m] = crc[m] ^ data[m];
+
+	crc[0]  = crc[8] ^ x[0] ^ x[1] ^ x[2] ^ x[3] ^ x[4] ^ x[5] ^ x[6] ^ x[7];
+	crc[1]  = crc[9];
+	crc[2]  = crc[10];
+	crc[3]  = crc[11];
+	crc[4]  = crc[12];
+	crc[5]  = crc[13];
+	crc[6]  = crc[14] ^ x[0];
+	crc[7]  = crc[15] ^ x[0] ^ x[1];
+	crc[8]  = x[1] ^ x[2];
+	crc[9]  = x[2] ^ x[3];
+	crc[10] = x[3] ^ x[4];
+	crc[11] = x[4] ^ x[5];
+	crc[12] = x[5] ^ x[6];
+	crc[13] = x[6] ^ x[7];
+	crc[14] = x[0] ^ x[1] ^ x[2] ^ x[3] ^ x[4] ^ x[5] ^ x[6];
+	crc[15] = x[0] ^ x[1] ^ x[2] ^ x[3] ^ x[4] ^ x[5] ^ x[6] ^ x[7];
+
+}  /* step_crc_16_lsb */
+
+/*
+ * static void expected_planes( const uint64_t word[8], uint64_t plane[8] );
+ *
+ * The function expected_planes() converts one byte of the expected CRC value
+ * of 64 messages to eight bit planes. Word g holds the bytes of messages 8g
+ * to 8g+7. After transposing the bits of word g, byte b of that word holds
+ * bit b of these messages. This is cheaper than a full transposition of 64
+ * words when only one byte per message is needed.
+ */
+
+static void expected_planes( const uint64_t word[8], uint64_t plane[8] ) {
+
+	int b;
+	int g;
+	uint64_t t;
+
+	for (b=0; b<8; b++) plane[b] = 0;
+
+	for (g=0; g<8; g++) {
+
+		t = transpose_8x8( word[g] );
+		for (b=0; b<8; b++) plane[b] |= ( ( t >> (8*b) ) & 0xFF ) << (8*g);
+	}
+
+}  /* expected_planes */
+
+/*
+ * static void load_words( const unsigned char *const msgs[], size_t pos, size_t len, size_t num_msgs, uint64_t word[CRC_VERIFY_LANES] );
+ *
+ * The function load_words() loads len bytes from offset pos of up to 64
+ * messages. Word j receives the bytes of message j, the first byte in the
+ * lowest eight bits. Bytes past len and the words of missing messages are
+ * zero. When the messages are at least 8 bytes long, the last 8 bytes up to
+ * pos+len are loaded and shifted, which avoids a loop over single bytes for
+ * the tail of the messages.
+ */
+
+static void load_words( const unsigned char *const msgs[], size_t pos, size_t len, size_t num_msgs, uint64_t word[CRC_VERIFY_LANES] ) {
+
+	size_t a;
+	size_t q;
+	const unsigned char *ptr;
+
+	if ( pos + len >= 8 ) {
+
+		for (a=0; a<num_msgs; a++) {
+
+			ptr     = msgs[a] + pos + len - 8;
+			word[a] = ( (uint64_t) ptr[0]        | ( (uint64_t) ptr[1] <<  8 ) | ( (uint64_t) ptr[2] << 16 ) | ( (uint64_t) ptr[3] << 24 )
+				| ( (uint64_t) ptr[4] << 32 ) | ( (uint64_t) ptr[5] << 40 ) | ( (uint64_t) ptr[6] << 48 ) | ( (uint64_t) ptr[7] << 56 ) ) >> ( 64 - 8*len );
+		}
+	}
+
+	else {
+		for (a=0; a<num_msgs; a++) {
+
+			word[a] = 0;
+			for (q=0; q<len; q++) word[a] |= (uint64_t) msgs[a][pos+q] << (8*q);
+		}
+	}
+
+	for (a=num_msgs; a<CRC_VERIFY_LANES; a++) word[a] = 0;
+
+}  /* load_words */
+
+/*
+ * static void transpose_64x64( uint64_t word[CRC_VERIFY_LANES] );
+ *
+ * The function transpose_64x64() transposes a matrix of 64 by 64 bits in
+ * place, so that bit i of word j moves to bit j of word i. After loading the
+ * messages with load_words(), word 8q+b is the bit plane of bit b of byte q.
+ * The matrix is transposed in six rounds which swap blocks of 32, 16, 8, 4,
+ * 2 and 1 bits around the diagonal. Each round is a separate call with
+ * constant arguments, which lets the compiler unroll it.
+ */
+
+static void transpose_64x64( uint64_t word[CRC_VERIFY_LANES] ) {
+
+	transpose_round( word, 32, 0x00000000FFFFFFFFull );
+	transpose_round( word, 16, 0x0000FFFF0000FFFFull );
+	transpose_round( word,  8, 0x00FF00FF00FF00FFull );
+	transpose_round( word,  4, 0x0F0F0F0F0F0F0F0Full );
+	transpose_round( word,  2, 0x3333333333333333ull );
+	transpose_round( word,  1, 0x5555555555555555ull );
+
+}  /* transpose_64x64 */
+
+/*
+ * static void transpose_round( uint64_t word[CRC_VERIFY_LANES], int j, uint64_t mask );
+ *
+ * The function transpose_round() performs one round of the transposition.
+ * The bits selected by mask in the high part of word k are exchanged with
+ * the bits in the low part of word k+j, for all k with bit j cleared. The
+ * inner loop runs over consecutive words, which the compiler can vectorize.
+ */
+
+static void transpose_round( uint64_t word[CRC_VERIFY_LANES], int j, uint64_t mask ) {
+
+	int b;
+	int k;
+	uint64_t t;
+
+	for (b=0; b<CRC_VERIFY_LANES; b+=2*j) for (k=b; k<b+j; k++) {
+
+		t          = ( (word[k] >> j) ^ word[k+j] ) & mask;
+		word[k]   ^= t << j;
+		word[k+j] ^= t;
+	}
+
+}  /* transpose_round */
+
+/*
+ * static uint64_t transpose_8x8( uint64_t x );
+ *
+ * The function transpose_8x8() transposes a matrix of 8 by 8 bits, where byte
+ * i is row i and bit j of a byte is column j. It works in the same way as
+ * transpose_64x64(), with rounds of 4, 2 and 1 bits.
+ */
+
+static uint64_t transpose_8x8( uint64_t x ) {
+
+	uint64_t t;
+
+	t = ( x ^ (x >>  7) ) & 0x00AA00AA00AA00AAull;
+	x =   x ^ t ^ (t <<  7);
+	t = ( x ^ (x >> 14) ) & 0x0000CCCC0000CCCCull;
+	x =   x ^ t ^ (t << 14);
+	t = ( x ^ (x >> 28) ) & 0x00000000F0F0F0F0ull;
+	x =   x ^ t ^ (t << 28);
+
+	return x;
+
+}  /* transpose_8x8 */
+
+/*
+ * static size_t store_failures( const uint64_t crc[], const uint64_t expect[], int num_planes, size_t num_msgs, uint64_t *failed );
+ *
+ * The function store_failures() compares the bit planes of the calculated
+ * and expected CRC values. A bit is set in the failure mask for every message
+ * where any of the planes differ. The function stores the mask and returns
+ * the number of bits set in it.
+ */
+
+static size_t store_failures( const uint64_t crc[], const uint64_t expect[], int num_planes, size_t num_msgs, uint64_t *failed ) {
+
+	int b;
+	size_t count;
+	uint64_t diff;
+
+	diff = 0;
+	for (b=0; b<num_planes; b++) diff |= crc[b] ^ expect[b];
+
+	if ( num_msgs < CRC_VERIFY_LANES ) diff &= ( 1ull << num_msgs ) - 1;
+
+	*failed = diff;
+
+	count = 0;
+
+	while ( diff != 0 ) {
+
+		diff &= diff - 1;
+		count++;
+	}
+
+	return count;
+
+}  /* store_failures */
@@ -34,12 +34,15 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include "checksum.h"
+#include "crcint.h"
 
 static uint16_t		crc_ccitt_generic( const unsigned char *input_str, size_t num_bytes, uint16_t start_value );
-static void             init_crcccitt_tab( void );
 
-static bool             crc_tabccitt_init       = false;
-static uint16_t         crc_tabccitt[256];
+/*
+ * Include the lookup table for the CCITT calculation
+ */
+
+#include "../tab/gentabcc.inc"
 
 /*
  * uint16_t crc_xmodem( const unsigned char *input_str, size_t num_bytes );
@@ -93,70 +96,38 @@ uint16_t crc_ccitt_ffff( const unsigned char *input_str, size_t num_bytes ) {
 static uint16_t crc_ccitt_generic( const unsigned char *input_str, size_t num_bytes, uint16_t start_value ) {
 
 	uint16_t crc;
-	const unsigned char *ptr;
-	size_t a;
-
-	if ( ! crc_tabccitt_init ) init_crcccitt_tab();
 
 	crc = start_value;
-	ptr = input_str;
 
-	if ( ptr != NULL ) for (a=0; a<num_bytes; a++) {
-
-		crc = (crc << 8) ^ crc_tabccitt[ ((crc >> 8) ^ (uint16_t) *ptr++) & 0x00FF ];
-	}
+	if ( input_str != NULL ) crc = crc_ccitt_block( crc, input_str, num_bytes );
 
 	return crc;
 
 }  /* crc_ccitt_generic */
 
 /*
- * uint16_t update_crc_ccitt( uint16_t crc, unsigned char c );
+ * uint16_t crc_ccitt_block( uint16_t crc, const unsigned char *ptr, size_t num_bytes );
  *
- * The function update_crc_ccitt() calculates a new CRC-CCITT value based on
- * the previous value of the CRC and the next byte of the data to be checked.
+ * The function crc_ccitt_block() updates a CCITT register with the contents
+ * of a byte buffer with the shared 16 bit kernels. It is used by the
+ * one-pass routines and by the streaming interface.
  */
 
-uint16_t update_crc_ccitt( uint16_t crc, unsigned char c ) {
-
-	if ( ! crc_tabccitt_init ) init_crcccitt_tab();
+uint16_t crc_ccitt_block( uint16_t crc, const unsigned char *ptr, size_t num_bytes ) {
 
-	return (crc << 8) ^ crc_tabccitt[ ((crc >> 8) ^ (uint16_t) c) & 0x00FF ];
+	return crc_16_msb_update( crc, ptr, num_bytes, crc_tabccitt_slice8, & crc_tabccitt_fold );
 
-}  /* update_crc_ccitt */
+}  /* crc_ccitt_block */
 
 /*
- * static void init_crcccitt_tab( void );
+ * uint16_t update_crc_ccitt( uint16_t crc, unsigned char c );
  *
- * For optimal performance, the routine to calculate the CRC-CCITT uses a
- * lookup table with pre-compiled values that can be directly applied in the
- * XOR action. This table is created at the first call of the function by the
- * init_crcccitt_tab() routine.
+ * The function update_crc_ccitt() calculates a new CRC-CCITT value based on
+ * the previous value of the CRC and the next byte of the data to be checked.
  */
 
-static void init_crcccitt_tab( void ) {
-
-	uint16_t i;
-	uint16_t j;
-	uint16_t crc;
-	uint16_t c;
-
-	for (i=0; i<256; i++) {
-
-		crc = 0;
-		c   = i << 8;
-
-		for (j=0; j<8; j++) {
-
-			if ( (crc ^ c) & 0x8000 ) crc = ( crc << 1 ) ^ CRC_POLY_CCITT;
-			else                      crc =   crc << 1;
-
-			c = c << 1;
-		}
-
-		crc_tabccitt[i] = crc;
-	}
+uint16_t update_crc_ccitt( uint16_t crc, unsigned char c ) {
 
-	crc_tabccitt_init = true;
+	return (crc << 8) ^ crc_tabccitt[ ((crc >> 8) ^ (uint16_t) c) & 0x00FF ];
 
-}  /* init_crcccitt_tab */
+}  /* update_crc_ccitt */
@@ -0,0 +1,372 @@
+/*
+ * Library: libcrc
+ * File:    src/crccomb.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2026 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crccomb.c contains routines to combine the CRC values
+ * of two adjacent blocks of data into the CRC value of the concatenation of
+ * these blocks. This makes it possible to calculate the CRC of parts of a
+ * buffer independently, for example in different threads or on different
+ * machines, and merge the results afterwards.
+ *
+ * Appending a block B of n bytes to a block A changes the CRC register of A
+ * in the same way as appending n zero bytes does, after which the register
+ * value of B calculated from a zero register is added. Appending n zero bytes
+ * is equal to a multiplication with x^(8n) modulo the CRC polynomial. This
+ * multiplication is done with a table of the remainders of x^(2^k) which is
+ * generated by the precalc program, which takes O(log n) time.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "checksum.h"
+#include "crcint.h"
+
+/*
+ * Include the tables with powers of x modulo the CRC polynomials
+ */
+
+#include "../tab/gencomb.inc"
+
+static const struct crc_poly_tp	poly_8		= {  8, false, CRC_POLY_8,      crc_x2n_8      };
+static const struct crc_poly_tp	poly_16		= { 16, true,  CRC_POLY_16,     crc_x2n_16     };
+static const struct crc_poly_tp	poly_32		= { 32, true,  CRC_POLY_32,     crc_x2n_32     };
+static const struct crc_poly_tp	poly_32c	= { 32, true,  CRC_POLY_32C,    crc_x2n_32c    };
+static const struct crc_poly_tp	poly_64		= { 64, false, CRC_POLY_64,     crc_x2n_64     };
+static const struct crc_poly_tp	poly_ccitt	= { 16, false, CRC_POLY_CCITT,  crc_x2n_ccitt  };
+static const struct crc_poly_tp	poly_dnp	= { 16, true,  CRC_POLY_DNP,    crc_x2n_dnp    };
+static const struct crc_poly_tp	poly_kermit	= { 16, true,  CRC_POLY_KERMIT, crc_x2n_kermit };
+static const struct crc_poly_tp	poly_sick	= { 16, false, CRC_POLY_SICK,   crc_x2n_sick   };
+
+static uint16_t		swap_bytes( uint16_t crc );
+
+/*
+ * uint8_t crc_8_combine( uint8_t crc1, uint8_t crc2, size_t len2 );
+ *
+ * The function crc_8_combine() returns the CRC-8 value of the concatenation of
+ * two blocks of data, given the CRC-8 values of both blocks and the length of
+ * the second block.
+ */
+
+uint8_t crc_8_combine( uint8_t crc1, uint8_t crc2, size_t len2 ) {
+
+	return (uint8_t) ( crc_poly_shift( & poly_8, crc1 ^ CRC_START_8, len2 ) ^ crc2 );
+
+}  /* crc_8_combine */
+
+/*
+ * uint16_t crc_16_combine( uint16_t crc1, uint16_t crc2, size_t len2 );
+ *
+ * The function crc_16_combine() returns the CRC-16 value of the concatenation
+ * of two blocks of data, given the CRC-16 values of both blocks and the length
+ * of the second block.
+ */
+
+uint16_t crc_16_combine( uint16_t crc1, uint16_t crc2, size_t len2 ) {
+
+	return (uint16_t) ( crc_poly_shift( & poly_16, crc1 ^ CRC_START_16, len2 ) ^ crc2 );
+
+}  /* crc_16_combine */
+
+/*
+ * uint32_t crc_32_combine( uint32_t crc1, uint32_t crc2, size_t len2 );
+ *
+ * The function crc_32_combine() returns the CRC-32 value of the concatenation
+ * of two blocks of data, given the CRC-32 values of both blocks and the length
+ * of the second block.
+ */
+
+uint32_t crc_32_combine( uint32_t crc1, uint32_t crc2, size_t len2 ) {
+
+	return (uint32_t) ( crc_poly_shift( & poly_32, crc1 ^ 0xFFFFFFFFul ^ CRC_START_32, len2 ) ^ crc2 );
+
+}  /* crc_32_combine */
+
+/*
+ * uint32_t crc_32c_combine( uint32_t crc1, uint32_t crc2, size_t len2 );
+ *
+ * The function crc_32c_combine() returns the CRC-32C value of the
+ * concatenation of two blocks of data, given the CRC-32C values of both blocks
+ * and the length of the second block.
+ */
+
+uint32_t crc_32c_combine( uint32_t crc1, uint32_t crc2, size_t len2 ) {
+
+	return (uint32_t) ( crc_poly_shift( & poly_32c, crc1 ^ 0xFFFFFFFFul ^ CRC_START_32C, len2 ) ^ crc2 );
+
+}  /* crc_32c_combine */
+
+/*
+ * uint64_t crc_64_ecma_combine( uint64_t crc1, uint64_t crc2, size_t len2 );
+ *
+ * The function crc_64_ecma_combine() returns the CRC-64 ECMA value of the
+ * concatenation of two blocks of data, given the CRC values of both blocks and
+ * the length of the second block.
+ */
+
+uint64_t crc_64_ecma_combine( uint64_t crc1, uint64_t crc2, size_t len2 ) {
+
+	return crc_poly_shift( & poly_64, crc1 ^ CRC_START_64_ECMA, len2 ) ^ crc2;
+
+}  /* crc_64_ecma_combine */
+
+/*
+ * uint64_t crc_64_we_combine( uint64_t crc1, uint64_t crc2, size_t len2 );
+ *
+ * The function crc_64_we_combine() returns the CRC-64 WE value of the
+ * concatenation of two blocks of data, given the CRC values of both blocks and
+ * the length of the second block.
+ */
+
+uint64_t crc_64_we_combine( uint64_t crc1, uint64_t crc2, size_t len2 ) {
+
+	return crc_poly_shift( & poly_64, crc1 ^ 0xFFFFFFFFFFFFFFFFull ^ CRC_START_64_WE, len2 ) ^ crc2;
+
+}  /* crc_64_we_combine */
+
+/*
+ * uint16_t crc_ccitt_1d0f_combine( uint16_t crc1, uint16_t crc2, size_t len2 );
+ *
+ * The function crc_ccitt_1d0f_combine() returns the CCITT CRC with start value
+ * 0x1D0F of the concatenation of two blocks of data, given the CRC values of
+ * both blocks and the length of the second block.
+ */
+
+uint16_t crc_ccitt_1d0f_combine( uint16_t crc1, uint16_t crc2, size_t len2 ) {
+
+	return (uint16_t) ( crc_poly_shift( & poly_ccitt, crc1 ^ CRC_START_CCITT_1D0F, len2 ) ^ crc2 );
+
+}  /* crc_ccitt_1d0f_combine */
+
+/*
+ * uint16_t crc_ccitt_ffff_combine( uint16_t crc1, uint16_t crc2, size_t len2 );
+ *
+ * The function crc_ccitt_ffff_combine() returns the CCITT CRC with start value
+ * 0xFFFF of the concatenation of two blocks of data, given the CRC values of
+ * both blocks and the length of the second block.
+ */
+
+uint16_t crc_ccitt_ffff_combine( uint16_t crc1, uint16_t crc2, size_t len2 ) {
+
+	return (uint16_t) ( crc_poly_shift( & poly_ccitt, crc1 ^ CRC_START_CCITT_FFFF, len2 ) ^ crc2 );
+
+}  /* crc_ccitt_ffff_combine */
+
+/*
+ * uint16_t crc_dnp_combine( uint16_t crc1, uint16_t crc2, size_t len2 );
+ *
+ * The function crc_dnp_combine() returns the DNP CRC of the concatenation of
+ * two blocks of data, given the DNP CRC values of both blocks and the length
+ * of the second block. The complement and byte swap which crc_dnp() applies
+ * to its result are undone before, and applied again after the combination.
+ */
+
+uint16_t crc_dnp_combine( uint16_t crc1, uint16_t crc2, size_t len2 ) {
+
+	uint16_t reg1;
+	uint16_t reg2;
+	uint16_t crc;
+
+	reg1 = (uint16_t) ~swap_bytes( crc1 );
+	reg2 = (uint16_t) ~swap_bytes( crc2 );
+	crc  = (uint16_t) ( crc_poly_shift( & poly_dnp, reg1 ^ CRC_START_DNP, len2 ) ^ reg2 );
+
+	return swap_bytes( (uint16_t) ~crc );
+
+}  /* crc_dnp_combine */
+
+/*
+ * uint16_t crc_kermit_combine( uint16_t crc1, uint16_t crc2, size_t len2 );
+ *
+ * The function crc_kermit_combine() returns the Kermit CRC of the
+ * concatenation of two blocks of data, given the Kermit CRC values of both
+ * blocks and the length of the second block.
+ */
+
+uint16_t crc_kermit_combine( uint16_t crc1, uint16_t crc2, size_t len2 ) {
+
+	uint16_t crc;
+
+	crc = (uint16_t) ( crc_poly_shift( & poly_kermit, swap_bytes( crc1 ) ^ CRC_START_KERMIT, len2 ) ^ swap_bytes( crc2 ) );
+
+	return swap_bytes( crc );
+
+}  /* crc_kermit_combine */
+
+/*
+ * uint16_t crc_modbus_combine( uint16_t crc1, uint16_t crc2, size_t len2 );
+ *
+ * The function crc_modbus_combine() returns the Modbus CRC of the
+ * concatenation of two blocks of data, given the Modbus CRC values of both
+ * blocks and the length of the second block.
+ */
+
+uint16_t crc_modbus_combine( uint16_t crc1, uint16_t crc2, size_t len2 ) {
+
+	return (uint16_t) ( crc_poly_shift( & poly_16, crc1 ^ CRC_START_MODBUS, len2 ) ^ crc2 );
+
+}  /* crc_modbus_combine */
+
+/*
+ * uint16_t crc_sick_combine( uint16_t crc1, uint16_t crc2, size_t len2, unsigned char last_byte1 );
+ *
+ * The function crc_sick_combine() returns the Sick CRC of the concatenation of
+ * two blocks of data, given the Sick CRC values of both blocks and the length
+ * of the second block. Because the Sick algorithm mixes the previous byte into
+ * the calculation of each byte, the last byte of the first block must be
+ * passed as well. The Sick algorithm shifts the CRC register only one bit per
+ * byte, so the register of the first block is multiplied by x^n instead of
+ * x^(8n).
+ */
+
+uint16_t crc_sick_combine( uint16_t crc1, uint16_t crc2, size_t len2, unsigned char last_byte1 ) {
+
+	uint64_t crc;
+
+	if ( len2 == 0 ) return crc1;
+
+	crc  = crc_poly_mulmod( & poly_sick, crc_poly_xpow( & poly_sick, len2,   0 ), swap_bytes( crc1 ) ^ CRC_START_SICK );
+	crc ^= crc_poly_mulmod( & poly_sick, crc_poly_xpow( & poly_sick, len2-1, 0 ), ( (uint16_t) last_byte1 ) << 8       );
+	crc ^= swap_bytes( crc2 );
+
+	return swap_bytes( (uint16_t) crc );
+
+}  /* crc_sick_combine */
+
+/*
+ * uint16_t crc_xmodem_combine( uint16_t crc1, uint16_t crc2, size_t len2 );
+ *
+ * The function crc_xmodem_combine() returns the XModem CRC of the
+ * concatenation of two blocks of data, given the XModem CRC values of both
+ * blocks and the length of the second block.
+ */
+
+uint16_t crc_xmodem_combine( uint16_t crc1, uint16_t crc2, size_t len2 ) {
+
+	return (uint16_t) ( crc_poly_shift( & poly_ccitt, crc1 ^ CRC_START_XMODEM, len2 ) ^ crc2 );
+
+}  /* crc_xmodem_combine */
+
+/*
+ * uint64_t crc_poly_mulmod( const struct crc_poly_tp *poly, uint64_t a, uint64_t b );
+ *
+ * The function crc_poly_mulmod() multiplies two polynomials modulo a CRC
+ * polynomial. The polynomials are in the bit order of the CRC register.
+ */
+
+uint64_t crc_poly_mulmod( const struct crc_poly_tp *poly, uint64_t a, uint64_t b ) {
+
+	int i;
+	uint64_t top;
+	uint64_t mask;
+	uint64_t prod;
+
+	if ( poly->bits < 64 ) mask = ( 1ull << poly->bits ) - 1;
+	else                   mask = 0xFFFFFFFFFFFFFFFFull;
+
+	top  = 1ull << (poly->bits-1);
+	prod = 0;
+
+	if ( poly->reflected ) {
+
+		for (i=0; i<poly->bits; i++) {
+
+			if ( a & (top >> i) ) prod ^= b;
+
+			if ( b & 1 ) b = ( b >> 1 ) ^ poly->poly;
+			else         b =   b >> 1;
+		}
+	}
+
+	else {
+
+		for (i=poly->bits-1; i>=0; i--) {
+
+			if ( prod & top ) prod = ( ( prod << 1 ) & mask ) ^ poly->poly;
+			else              prod =   ( prod << 1 ) & mask;
+
+			if ( ( a >> i ) & 1 ) prod ^= b;
+		}
+	}
+
+	return prod;
+
+}  /* crc_poly_mulmod */
+
+/*
+ * uint64_t crc_poly_xpow( const struct crc_poly_tp *poly, size_t n, int k );
+ *
+ * The function crc_poly_xpow() returns the remainder of x^(n * 2^k) modulo the
+ * CRC polynomial. One multiplication is needed for every bit set in n.
+ */
+
+uint64_t crc_poly_xpow( const struct crc_poly_tp *poly, size_t n, int k ) {
+
+	uint64_t result;
+
+	if ( poly->reflected ) result = 1ull << (poly->bits-1);
+	else                   result = 1;
+
+	while ( n > 0 ) {
+
+		if ( n & 1 ) result = crc_poly_mulmod( poly, poly->x2n[k], result );
+
+		n >>= 1;
+		k++;
+	}
+
+	return result;
+
+}  /* crc_poly_xpow */
+
+/*
+ * uint64_t crc_poly_shift( const struct crc_poly_tp *poly, uint64_t crc, size_t num_bytes );
+ *
+ * The function crc_poly_shift() returns the value of a CRC register after a
+ * number of zero bytes have been fed into it.
+ */
+
+uint64_t crc_poly_shift( const struct crc_poly_tp *poly, uint64_t crc, size_t num_bytes ) {
+
+	if ( num_bytes == 0 ) return crc;
+
+	return crc_poly_mulmod( poly, crc_poly_xpow( poly, num_bytes, 3 ), crc );
+
+}  /* crc_poly_shift */
+
+/*
+ * static uint16_t swap_bytes( uint16_t crc );
+ *
+ * The function swap_bytes() swaps the low and high byte of a 16 bit value.
+ */
+
+static uint16_t swap_bytes( uint16_t crc ) {
+
+	return (uint16_t) ( ( crc >> 8 ) | ( crc << 8 ) );
+
+}  /* swap_bytes */
@@ -0,0 +1,193 @@
+/*
+ * Library: libcrc
+ * File:    src/crccpu.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2026 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crccpu.c contains the routines which determine at
+ * runtime which processor extensions are available for the accelerated CRC
+ * calculation kernels.
+ */
+
+#include <stdlib.h>
+#include "checksum.h"
+#include "crcint.h"
+
+#if defined(LIBCRC_X86_64)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+static unsigned int	detect_cpu_features( void );
+
+static int		cpu_features		= -1;
+
+/*
+ * unsigned int crc_cpu_features( void );
+ *
+ * The function crc_cpu_features() returns a bit mask with CRC_CPU_xxxx flags
+ * of the processor extensions which can be used on the current machine. The
+ * processor is only queried at the first call. Concurrent first calls are
+ * harmless because every thread stores the same value.
+ */
+
+unsigned int crc_cpu_features( void ) {
+
+	int features;
+
+	features = CRC_ATOMIC_LOAD( & cpu_features );
+
+	if ( features < 0 ) {
+
+		features = (int) detect_cpu_features();
+		CRC_ATOMIC_STORE( & cpu_features, features );
+	}
+
+	return (unsigned int) features;
+
+}  /* crc_cpu_features */
+
+/*
+ * unsigned long crc_cpu_signature( void );
+ *
+ * The function crc_cpu_signature() returns the processor signature with the
+ * family, model and stepping as reported by cpuid leaf 1. It distinguishes
+ * micro-architectures which support the same extensions but not at the same
+ * speed. On other architectures than x86-64 the function returns 0.
+ */
+
+unsigned long crc_cpu_signature( void ) {
+
+#if defined(LIBCRC_X86_64)
+#if defined(_MSC_VER)
+	int regs[4];
+
+	__cpuid( regs, 1 );
+
+	return (unsigned long) (unsigned int) regs[0];
+#else
+	unsigned int eax;
+	unsigned int ebx;
+	unsigned int ecx;
+	unsigned int edx;
+
+	if ( ! __get_cpuid( 1, & eax, & ebx, & ecx, & edx ) ) return 0;
+
+	return (unsigned long) eax;
+#endif
+#else
+	return 0;
+#endif
+
+}  /* crc_cpu_signature */
+
+/*
+ * static unsigned int detect_cpu_features( void );
+ *
+ * The function detect_cpu_features() queries the processor with the cpuid
+ * instruction for the extensions used by the library. The AVX2 and AVX-512
+ * extensions are only reported when the operating system saves the wider
+ * registers on a context switch, which is checked with the xgetbv
+ * instruction. On other architectures than x86-64 no extensions are
+ * reported.
+ */
+
+static unsigned int detect_cpu_features( void ) {
+
+	unsigned int features;
+#if defined(LIBCRC_X86_64)
+	unsigned int max_leaf;
+	unsigned int ebx7;
+	unsigned int ecx7;
+	unsigned int ecx;
+	uint64_t xcr0;
+#if defined(_MSC_VER)
+	int regs[4];
+
+	__cpuid( regs, 0 );
+	max_leaf = (unsigned int) regs[0];
+
+	__cpuid( regs, 1 );
+	ecx = (unsigned int) regs[2];
+
+	ebx7 = 0;
+	ecx7 = 0;
+
+	if ( max_leaf >= 7 ) {
+
+		__cpuidex( regs, 7, 0 );
+		ebx7 = (unsigned int) regs[1];
+		ecx7 = (unsigned int) regs[2];
+	}
+
+	xcr0 = ( ecx & (1u << 27) ) ? (uint64_t) _xgetbv( 0 ) : 0;
+#else
+	unsigned int eax;
+	unsigned int ebx;
+	unsigned int edx;
+
+	max_leaf = __get_cpuid_max( 0, NULL );
+
+	if ( ! __get_cpuid( 1, & eax, & ebx, & ecx, & edx ) ) return 0;
+
+	ebx7 = 0;
+	ecx7 = 0;
+
+	if ( max_leaf >= 7 ) __cpuid_count( 7, 0, eax, ebx7, ecx7, edx );
+
+	xcr0 = 0;
+
+	if ( ecx & (1u << 27) ) {
+
+		__asm__ ( "xgetbv" : "=a" (eax), "=d" (edx) : "c" (0) );
+		xcr0 = ( (uint64_t) edx << 32 ) | eax;
+	}
+#endif
+#endif
+
+	features = 0;
+
+#if defined(LIBCRC_X86_64)
+	if ( ecx & (1u <<  9) ) features |= CRC_CPU_SSSE3;
+	if ( ecx & (1u << 19) ) features |= CRC_CPU_SSE41;
+	if ( ecx & (1u << 20) ) features |= CRC_CPU_SSE42;
+	if ( ecx & (1u <<  1) ) features |= CRC_CPU_PCLMUL;
+
+	if ( ( xcr0 & 0x06 ) == 0x06 ) {
+
+		if ( ebx7 & (1u <<  5) ) features |= CRC_CPU_AVX2;
+		if ( ecx7 & (1u << 10) ) features |= CRC_CPU_VPCLMUL;
+
+		if ( ( xcr0 & 0xE0 ) == 0xE0  &&  ( ebx7 & (1u << 16) ) ) features |= CRC_CPU_AVX512;
+	}
+#endif
+
+	return features;
+
+}  /* detect_cpu_features */
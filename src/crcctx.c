@@ -0,0 +1,161 @@
+/*
+ * Library: libcrc
+ * File:    src/crcctx.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2026 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crcctx.c contains the streaming interface of the
+ * library. A calculation is started with crc_init(), the data is passed in
+ * one or more ranges of bytes to crc_update() and the resulting CRC value is
+ * returned by crc_final(). Each range is processed with the same block
+ * routines as the one-pass functions use, and the start value, final
+ * complement and byte swap of every algorithm are handled by the interface.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "checksum.h"
+#include "crcint.h"
+
+static uint16_t		swap_bytes( uint16_t crc );
+
+/*
+ * bool crc_init( struct crc_ctx *ctx, enum crc_algo algo );
+ *
+ * The function crc_init() prepares a context for the calculation of a CRC
+ * with the algorithm algo. The function returns false if the context is NULL
+ * or the algorithm is unknown.
+ */
+
+bool crc_init( struct crc_ctx *ctx, enum crc_algo algo ) {
+
+	if ( ctx == NULL ) return false;
+
+	switch ( algo ) {
+
+		case CRC_ALGO_8           : ctx->crc = CRC_START_8;          break;
+		case CRC_ALGO_16          : ctx->crc = CRC_START_16;         break;
+		case CRC_ALGO_32          : ctx->crc = CRC_START_32;         break;
+		case CRC_ALGO_32C         : ctx->crc = CRC_START_32C;        break;
+		case CRC_ALGO_64_ECMA     : ctx->crc = CRC_START_64_ECMA;    break;
+		case CRC_ALGO_64_WE       : ctx->crc = CRC_START_64_WE;      break;
+		case CRC_ALGO_CCITT_1D0F  : ctx->crc = CRC_START_CCITT_1D0F; break;
+		case CRC_ALGO_CCITT_FFFF  : ctx->crc = CRC_START_CCITT_FFFF; break;
+		case CRC_ALGO_DNP         : ctx->crc = CRC_START_DNP;        break;
+		case CRC_ALGO_KERMIT      : ctx->crc = CRC_START_KERMIT;     break;
+		case CRC_ALGO_MODBUS      : ctx->crc = CRC_START_MODBUS;     break;
+		case CRC_ALGO_SICK        : ctx->crc = CRC_START_SICK;       break;
+		case CRC_ALGO_XMODEM      : ctx->crc = CRC_START_XMODEM;     break;
+		case CRC_ALGO_8_AUTOSAR   : ctx->crc = CRC_START_8_AUTOSAR;  break;
+		case CRC_ALGO_8_MAXIM     : ctx->crc = CRC_START_8_MAXIM;    break;
+		case CRC_ALGO_8_SMBUS     : ctx->crc = CRC_START_8_SMBUS;    break;
+		default                   : return false;
+	}
+
+	ctx->algo      = algo;
+	ctx->prev_byte = 0;
+
+	return true;
+
+}  /* crc_init */
+
+/*
+ * void crc_update( struct crc_ctx *ctx, const unsigned char *input_str, size_t num_bytes );
+ *
+ * The function crc_update() adds a range of bytes to a streaming CRC
+ * calculation. The function can be called any number of times, and the
+ * result is the same as if all ranges had been passed at once to the
+ * one-pass function of the algorithm.
+ */
+
+void crc_update( struct crc_ctx *ctx, const unsigned char *input_str, size_t num_bytes ) {
+
+	if ( ctx == NULL  ||  input_str == NULL  ||  num_bytes == 0 ) return;
+
+	switch ( ctx->algo ) {
+
+		case CRC_ALGO_8           : ctx->crc = crc_8_block(      (uint8_t)  ctx->crc, input_str, num_bytes ); break;
+		case CRC_ALGO_16          :
+		case CRC_ALGO_MODBUS      : ctx->crc = crc_16_block(     (uint16_t) ctx->crc, input_str, num_bytes ); break;
+		case CRC_ALGO_32          : ctx->crc = crc_32_block(     (uint32_t) ctx->crc, input_str, num_bytes ); break;
+		case CRC_ALGO_32C         : ctx->crc = crc_32c_block(    (uint32_t) ctx->crc, input_str, num_bytes ); break;
+		case CRC_ALGO_64_ECMA     :
+		case CRC_ALGO_64_WE       : ctx->crc = crc_64_block(                ctx->crc, input_str, num_bytes ); break;
+		case CRC_ALGO_CCITT_1D0F  :
+		case CRC_ALGO_CCITT_FFFF  :
+		case CRC_ALGO_XMODEM      : ctx->crc = crc_ccitt_block(  (uint16_t) ctx->crc, input_str, num_bytes ); break;
+		case CRC_ALGO_DNP         : ctx->crc = crc_dnp_block(    (uint16_t) ctx->crc, input_str, num_bytes ); break;
+		case CRC_ALGO_KERMIT      : ctx->crc = crc_kermit_block( (uint16_t) ctx->crc, input_str, num_bytes ); break;
+		case CRC_ALGO_SICK        : ctx->crc = crc_sick_block(   (uint16_t) ctx->crc, ctx->prev_byte, input_str, num_bytes ); break;
+		case CRC_ALGO_8_AUTOSAR   : ctx->crc = crc_8_autosar_block( (uint8_t) ctx->crc, input_str, num_bytes ); break;
+		case CRC_ALGO_8_MAXIM     : ctx->crc = crc_8_maxim_block(   (uint8_t) ctx->crc, input_str, num_bytes ); break;
+		case CRC_ALGO_8_SMBUS     : ctx->crc = crc_8_smbus_block(   (uint8_t) ctx->crc, input_str, num_bytes ); break;
+		default                   : return;
+	}
+
+	ctx->prev_byte = input_str[num_bytes-1];
+
+}  /* crc_update */
+
+/*
+ * uint64_t crc_final( const struct crc_ctx *ctx );
+ *
+ * The function crc_final() returns the CRC value of all bytes passed to the
+ * context so far. The final complement or byte swap of the algorithm is
+ * applied to the returned value, but the context is not changed. More data
+ * may therefore be added after the call.
+ */
+
+uint64_t crc_final( const struct crc_ctx *ctx ) {
+
+	if ( ctx == NULL ) return 0;
+
+	switch ( ctx->algo ) {
+
+		case CRC_ALGO_32          :
+		case CRC_ALGO_32C         : return ctx->crc ^ 0xFFFFFFFFul;
+		case CRC_ALGO_64_WE       : return ctx->crc ^ 0xFFFFFFFFFFFFFFFFull;
+		case CRC_ALGO_8_AUTOSAR   : return ctx->crc ^ 0xFF;
+		case CRC_ALGO_DNP         : return swap_bytes( (uint16_t) ~ctx->crc );
+		case CRC_ALGO_KERMIT      :
+		case CRC_ALGO_SICK        : return swap_bytes( (uint16_t) ctx->crc );
+		default                   : return ctx->crc;
+	}
+
+}  /* crc_final */
+
+/*
+ * static uint16_t swap_bytes( uint16_t crc );
+ *
+ * The function swap_bytes() swaps the low and high byte of a 16 bit value.
+ */
+
+static uint16_t swap_bytes( uint16_t crc ) {
+
+	return (uint16_t) ( ( crc >> 8 ) | ( crc << 8 ) );
+
+}  /* swap_bytes */
@@ -0,0 +1,205 @@
+/*
+ * Library: libcrc
+ * File:    src/crcdisp.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2026 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crcdisp.c contains the runtime dispatch layer which
+ * selects the calculation kernels used by the block routines. The selection
+ * is made once, at the first CRC calculation, from the processor extensions
+ * reported by crc_cpu_features(). It can be overruled with the environment
+ * variable LIBCRC_IMPL or with a call to libcrc_set_impl(), for example to
+ * compare the kernels with each other on the same machine.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "checksum.h"
+#include "crcint.h"
+
+/*
+ * #define CRC_xx_CLMUL_MIN
+ *
+ * The minimum number of bytes for which the carry-less multiplication kernels
+ * are used. Below these sizes the setup and the final reduction of the
+ * folding algorithm cost more than slicing-by-8 does. The reduction of the 8
+ * and 16 bit CRCs is cheaper, which lowers their break even point.
+ */
+
+#define CRC_8_CLMUL_MIN		128
+#define CRC_16_CLMUL_MIN	128
+#define CRC_32_CLMUL_MIN	256
+#define CRC_64_CLMUL_MIN	256
+
+#define CRC_CLMUL_NEVER		SIZE_MAX
+
+static int			find_impl( const char *name );
+
+/*
+ * The implementation levels in order of increasing speed. The automatic
+ * selection picks the last level which the processor supports. The minimum
+ * sizes for folding can be adjusted by libcrc_autotune().
+ */
+
+static struct crc_dispatch_tp	dispatch_tab[] = {
+
+	{ "generic", 0,                                                              false, false, CRC_CLMUL_NEVER, CRC_CLMUL_NEVER,  CRC_CLMUL_NEVER,  CRC_CLMUL_NEVER  },
+	{ "slice8",  0,                                                              true,  false, CRC_CLMUL_NEVER, CRC_CLMUL_NEVER,  CRC_CLMUL_NEVER,  CRC_CLMUL_NEVER  },
+#if defined(LIBCRC_X86_64)
+	{ "sse42",   CRC_CPU_SSE42,                                                  true,  true,  CRC_CLMUL_NEVER, CRC_CLMUL_NEVER,  CRC_CLMUL_NEVER,  CRC_CLMUL_NEVER  },
+	{ "clmul",   CRC_CPU_SSSE3 | CRC_CPU_SSE41 | CRC_CPU_SSE42 | CRC_CPU_PCLMUL, true,  true,  CRC_8_CLMUL_MIN, CRC_16_CLMUL_MIN, CRC_32_CLMUL_MIN, CRC_64_CLMUL_MIN },
+#endif
+};
+
+#define CRC_DISPATCH_NUM	( (int) ( sizeof(dispatch_tab) / sizeof(dispatch_tab[0]) ) )
+
+static int			dispatch_index		= -1;
+
+/*
+ * const struct crc_dispatch_tp *crc_dispatch( void );
+ *
+ * The function crc_dispatch() returns the implementation level used by the
+ * block routines. At the first call the level named in the environment
+ * variable LIBCRC_IMPL is selected, or the fastest level the processor
+ * supports when the variable is not set or names an unusable level. Later
+ * calls only cost one load of the cached index.
+ */
+
+const struct crc_dispatch_tp *crc_dispatch( void ) {
+
+	int index;
+
+	index = CRC_ATOMIC_LOAD( & dispatch_index );
+
+	if ( index < 0 ) {
+
+		index = find_impl( getenv( "LIBCRC_IMPL" ) );
+		if ( index < 0 ) index = find_impl( NULL );
+
+		CRC_ATOMIC_STORE( & dispatch_index, index );
+	}
+
+	return & dispatch_tab[index];
+
+}  /* crc_dispatch */
+
+/*
+ * bool libcrc_set_impl( const char *name );
+ *
+ * The function libcrc_set_impl() selects the calculation kernels used by the
+ * library. The name is one of "generic", "slice8", "sse42" or "clmul", or
+ * "auto" or NULL for the fastest level the processor supports. The function
+ * returns false and leaves the selection unchanged when the name is unknown
+ * or when the processor lacks the extensions of the level. It should not be
+ * called while other threads calculate CRC values.
+ */
+
+bool libcrc_set_impl( const char *name ) {
+
+	int index;
+
+	index = find_impl( name );
+	if ( index < 0 ) return false;
+
+	CRC_ATOMIC_STORE( & dispatch_index, index );
+
+	return true;
+
+}  /* libcrc_set_impl */
+
+/*
+ * const char *libcrc_get_impl( void );
+ *
+ * The function libcrc_get_impl() returns the name of the implementation level
+ * which is currently used for the CRC calculations.
+ */
+
+const char *libcrc_get_impl( void ) {
+
+	return crc_dispatch()->name;
+
+}  /* libcrc_get_impl */
+
+/*
+ * struct crc_dispatch_tp *crc_dispatch_level( const char *name );
+ *
+ * The function crc_dispatch_level() returns a modifiable pointer to the entry
+ * of an implementation level in the dispatch table, or NULL when the level is
+ * unknown or not supported by the processor. It is used by the auto-tuner to
+ * adjust the minimum sizes for folding.
+ */
+
+struct crc_dispatch_tp *crc_dispatch_level( const char *name ) {
+
+	int index;
+
+	index = find_impl( name );
+	if ( index < 0 ) return NULL;
+
+	return & dispatch_tab[index];
+
+}  /* crc_dispatch_level */
+
+/*
+ * static int find_impl( const char *name );
+ *
+ * The function find_impl() returns the index of the implementation level with
+ * the given name in the dispatch table, or -1 when the name is unknown or the
+ * processor does not support the level. An empty name, "auto" and NULL select
+ * the fastest supported level.
+ */
+
+static int find_impl( const char *name ) {
+
+	int a;
+	unsigned int features;
+
+	features = crc_cpu_features();
+
+	if ( name == NULL  ||  name[0] == '\0'  ||  strcmp( name, "auto" ) == 0 ) {
+
+		for (a=CRC_DISPATCH_NUM-1; a>0; a--) {
+
+			if ( ( dispatch_tab[a].features & features ) == dispatch_tab[a].features ) return a;
+		}
+
+		return 0;
+	}
+
+	for (a=0; a<CRC_DISPATCH_NUM; a++) {
+
+		if ( strcmp( name, dispatch_tab[a].name ) != 0 ) continue;
+
+		if ( ( dispatch_tab[a].features & features ) != dispatch_tab[a].features ) return -1;
+
+		return a;
+	}
+
+	return -1;
+
+}  /* find_impl */
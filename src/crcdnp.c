@@ -36,11 +36,13 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include "checksum.h"
+#include "crcint.h"
 
-static void             init_crcdnp_tab( void );
+/*
+ * Include the lookup table for the DNP calculation
+ */
 
-static bool             crc_tabdnp_init         = false;
-static uint16_t         crc_tabdnp[256];
+#include "../tab/gentabdnp.inc"
 
 /*
  * uint16_t crc_dnp( const unsigned char* input_str, size_t num_bytes );
@@ -54,18 +56,10 @@ uint16_t crc_dnp( const unsigned char *input_str, size_t num_bytes ) {
 	uint16_t crc;
 	uint16_t low_byte;
 	uint16_t high_byte;
-	const unsigned char *ptr;
-	size_t a;
-
-	if ( ! crc_tabdnp_init ) init_crcdnp_tab();
 
 	crc = CRC_START_DNP;
-	ptr = input_str;
-
-	if ( ptr != NULL ) for (a=0; a<num_bytes; a++) {
 
-		crc = (crc >> 8) ^ crc_tabdnp[ (crc ^ (uint16_t) *ptr++) & 0x00FF ];
-	}
+	if ( input_str != NULL ) crc = crc_dnp_block( crc, input_str, num_bytes );
 
 	crc       = ~crc;
 	low_byte  = (crc & 0xff00) >> 8;
@@ -77,52 +71,28 @@ uint16_t crc_dnp( const unsigned char *input_str, size_t num_bytes ) {
 }  /* crc_dnp */
 
 /*
- * uint16_t update_crc_dnp( uint16_t crc, unsigned char c );
+ * uint16_t crc_dnp_block( uint16_t crc, const unsigned char *ptr, size_t num_bytes );
  *
- * The function update_crc_dnp() is called for every new byte in a row that
- * must be feeded tot the CRC-DNP routine to calculate the DNP CRC.
+ * The function crc_dnp_block() updates a DNP register with the contents of a
+ * byte buffer. The complement and byte swap of the final DNP CRC value are
+ * not applied.
  */
 
-uint16_t update_crc_dnp( uint16_t crc, unsigned char c ) {
-
-	if ( ! crc_tabdnp_init ) init_crcdnp_tab();
+uint16_t crc_dnp_block( uint16_t crc, const unsigned char *ptr, size_t num_bytes ) {
 
-	return (crc >> 8) ^ crc_tabdnp[ (crc ^ (uint16_t) c) & 0x00FF ];
+	return crc_16_lsb_update( crc, ptr, num_bytes, crc_tabdnp_slice8, & crc_tabdnp_fold );
 
-}  /* update_crc_dnp */
+}  /* crc_dnp_block */
 
 /*
- * static void init_crcdnp_tab( void );
+ * uint16_t update_crc_dnp( uint16_t crc, unsigned char c );
  *
- * For better performance, the DNP CRC calculation uses a precompiled list with
- * bit patterns that are used in the XOR operation in the main routine. This
- * table is calculated once at the start of the program by the
- * init_crcdnp_tab() routine.
+ * The function update_crc_dnp() is called for every new byte in a row that
+ * must be feeded tot the CRC-DNP routine to calculate the DNP CRC.
  */
 
-static void init_crcdnp_tab( void ) {
-
-	int i;
-	int j;
-	uint16_t crc;
-	uint16_t c;
-
-	for (i=0; i<256; i++) {
-
-		crc = 0;
-		c   = (uint16_t) i;
-
-		for (j=0; j<8; j++) {
-
-			if ( (crc ^ c) & 0x0001 ) crc = ( crc >> 1 ) ^ CRC_POLY_DNP;
-			else                      crc =   crc >> 1;
-
-			c = c >> 1;
-		}
-
-		crc_tabdnp[i] = crc;
-	}
+uint16_t update_crc_dnp( uint16_t crc, unsigned char c ) {
 
-	crc_tabdnp_init = true;
+	return (crc >> 8) ^ crc_tabdnp[ (crc ^ (uint16_t) c) & 0x00FF ];
 
-}  /* init_crcdnp_tab */
+}  /* update_crc_dnp */
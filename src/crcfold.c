@@ -0,0 +1,199 @@
+/*
+ * Library: libcrc
+ * File:    src/crcfold.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2026 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crcfold.c contains the generic carry-less multiplication
+ * kernels which fold a byte buffer into a 128 bit remainder. The kernels are
+ * shared by the CRC algorithms of different widths. The final reduction of the
+ * remainder is done by the caller with its own lookup tables.
+ */
+
+#include <stdlib.h>
+#include "checksum.h"
+#include "crcint.h"
+
+#if defined(LIBCRC_X86_64)
+#include <immintrin.h>
+
+/*
+ * void crc_fold_msb( const unsigned char *ptr, size_t num_bytes, uint64_t init, const struct crc_fold_tp *fold, unsigned char result[16] );
+ *
+ * The function crc_fold_msb() folds a byte buffer for a CRC which is
+ * calculated with the most significant bit first. The buffer is treated as
+ * one big polynomial with the first byte as the highest order term. The value
+ * init is added to the first 64 bits of the buffer. This is how the starting
+ * value of a CRC register enters the calculation, after it has been shifted
+ * to the top of the 64 bit word.
+ *
+ * The function stores a 128 bit remainder in big endian byte order in result.
+ * This remainder has the same CRC as the buffer itself. Passing the remainder
+ * through the byte-at-a-time algorithm with a CRC register of zero therefore
+ * gives the CRC register value after the buffer. The same kernel can be used
+ * for every CRC polynomial up to order 64.
+ *
+ * The number of bytes must be a multiple of 16 and at least 64. The caller
+ * must have verified that the processor supports PCLMULQDQ and SSSE3.
+ */
+
+LIBCRC_TARGET("pclmul,ssse3")
+void crc_fold_msb( const unsigned char *ptr, size_t num_bytes, uint64_t init, const struct crc_fold_tp *fold, unsigned char result[16] ) {
+
+	__m128i swap;
+	__m128i k;
+	__m128i x1;
+	__m128i x2;
+	__m128i x3;
+	__m128i x4;
+
+	swap = _mm_set_epi8( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 );
+
+	x1 = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i *) (ptr + 0x00) ), swap );
+	x2 = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i *) (ptr + 0x10) ), swap );
+	x3 = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i *) (ptr + 0x20) ), swap );
+	x4 = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i *) (ptr + 0x30) ), swap );
+
+	x1 = _mm_xor_si128( x1, _mm_set_epi64x( (long long) init, 0 ) );
+
+	ptr       += 64;
+	num_bytes -= 64;
+
+	k = _mm_set_epi64x( (long long) fold->fold512_hi, (long long) fold->fold512_lo );
+
+	while ( num_bytes >= 64 ) {
+
+		x1 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x1, k, 0x00 ), _mm_clmulepi64_si128( x1, k, 0x11 ) ),
+				    _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i *) (ptr + 0x00) ), swap ) );
+		x2 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x2, k, 0x00 ), _mm_clmulepi64_si128( x2, k, 0x11 ) ),
+				    _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i *) (ptr + 0x10) ), swap ) );
+		x3 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x3, k, 0x00 ), _mm_clmulepi64_si128( x3, k, 0x11 ) ),
+				    _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i *) (ptr + 0x20) ), swap ) );
+		x4 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x4, k, 0x00 ), _mm_clmulepi64_si128( x4, k, 0x11 ) ),
+				    _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i *) (ptr + 0x30) ), swap ) );
+
+		ptr       += 64;
+		num_bytes -= 64;
+	}
+
+	k = _mm_set_epi64x( (long long) fold->fold128_hi, (long long) fold->fold128_lo );
+
+	x1 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x1, k, 0x00 ), _mm_clmulepi64_si128( x1, k, 0x11 ) ), x2 );
+	x1 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x1, k, 0x00 ), _mm_clmulepi64_si128( x1, k, 0x11 ) ), x3 );
+	x1 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x1, k, 0x00 ), _mm_clmulepi64_si128( x1, k, 0x11 ) ), x4 );
+
+	while ( num_bytes >= 16 ) {
+
+		x1 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x1, k, 0x00 ), _mm_clmulepi64_si128( x1, k, 0x11 ) ),
+				    _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i *) ptr ), swap ) );
+
+		ptr       += 16;
+		num_bytes -= 16;
+	}
+
+	_mm_storeu_si128( (__m128i *) result, _mm_shuffle_epi8( x1, swap ) );
+
+}  /* crc_fold_msb */
+
+/*
+ * void crc_fold_lsb( const unsigned char *ptr, size_t num_bytes, uint64_t init, const struct crc_fold_tp *fold, unsigned char result[16] );
+ *
+ * The function crc_fold_lsb() folds a byte buffer for a reflected CRC, which
+ * is calculated with the least significant bit first. The bytes are used in
+ * memory order, and the value of the CRC register is added to the first 64
+ * bits of the buffer without shifting.
+ *
+ * A carry-less multiplication of two reflected 64 bit values returns the
+ * product multiplied by x. The folding constants of reflected polynomials are
+ * therefore the remainders of x^(n-1) instead of x^n. The low half of the
+ * accumulator holds the highest order terms, which is why the constant to
+ * fold it is stored in the low half of each pair.
+ *
+ * The 128 bit remainder is stored in memory order in result. Passing it
+ * through the byte-at-a-time algorithm with a CRC register of zero gives the
+ * CRC register value after the buffer. The kernel can be used for every
+ * reflected CRC polynomial up to order 64.
+ *
+ * The number of bytes must be a multiple of 16 and at least 64. The caller
+ * must have verified that the processor supports PCLMULQDQ.
+ */
+
+LIBCRC_TARGET("pclmul")
+void crc_fold_lsb( const unsigned char *ptr, size_t num_bytes, uint64_t init, const struct crc_fold_tp *fold, unsigned char result[16] ) {
+
+	__m128i k;
+	__m128i x1;
+	__m128i x2;
+	__m128i x3;
+	__m128i x4;
+
+	x1 = _mm_loadu_si128( (const __m128i *) (ptr + 0x00) );
+	x2 = _mm_loadu_si128( (const __m128i *) (ptr + 0x10) );
+	x3 = _mm_loadu_si128( (const __m128i *) (ptr + 0x20) );
+	x4 = _mm_loadu_si128( (const __m128i *) (ptr + 0x30) );
+
+	x1 = _mm_xor_si128( x1, _mm_set_epi64x( 0, (long long) init ) );
+
+	ptr       += 64;
+	num_bytes -= 64;
+
+	k = _mm_set_epi64x( (long long) fold->fold512_hi, (long long) fold->fold512_lo );
+
+	while ( num_bytes >= 64 ) {
+
+		x1 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x1, k, 0x00 ), _mm_clmulepi64_si128( x1, k, 0x11 ) ),
+				    _mm_loadu_si128( (const __m128i *) (ptr + 0x00) ) );
+		x2 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x2, k, 0x00 ), _mm_clmulepi64_si128( x2, k, 0x11 ) ),
+				    _mm_loadu_si128( (const __m128i *) (ptr + 0x10) ) );
+		x3 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x3, k, 0x00 ), _mm_clmulepi64_si128( x3, k, 0x11 ) ),
+				    _mm_loadu_si128( (const __m128i *) (ptr + 0x20) ) );
+		x4 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x4, k, 0x00 ), _mm_clmulepi64_si128( x4, k, 0x11 ) ),
+				    _mm_loadu_si128( (const __m128i *) (ptr + 0x30) ) );
+
+		ptr       += 64;
+		num_bytes -= 64;
+	}
+
+	k = _mm_set_epi64x( (long long) fold->fold128_hi, (long long) fold->fold128_lo );
+
+	x1 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x1, k, 0x00 ), _mm_clmulepi64_si128( x1, k, 0x11 ) ), x2 );
+	x1 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x1, k, 0x00 ), _mm_clmulepi64_si128( x1, k, 0x11 ) ), x3 );
+	x1 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x1, k, 0x00 ), _mm_clmulepi64_si128( x1, k, 0x11 ) ), x4 );
+
+	while ( num_bytes >= 16 ) {
+
+		x1 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x1, k, 0x00 ), _mm_clmulepi64_si128( x1, k, 0x11 ) ),
+				    _mm_loadu_si128( (const __m128i *) ptr ) );
+
+		ptr       += 16;
+		num_bytes -= 16;
+	}
+
+	_mm_storeu_si128( (__m128i *) result, x1 );
+
+}  /* crc_fold_lsb */
+
+#endif
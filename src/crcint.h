@@ -0,0 +1,258 @@
+/*
+ * Library: libcrc
+ * File:    src/crcint.h
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2026 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The header file src/crcint.h contains definitions and prototypes which are
+ * shared between the source files of the library, but which are not part of
+ * the public API of the library.
+ */
+
+#ifndef DEF_LIBCRC_CRCINT_H
+#define DEF_LIBCRC_CRCINT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * #define LIBCRC_X86_64
+ *
+ * The macro LIBCRC_X86_64 is defined when the library is compiled for the
+ * x86-64 architecture with a compiler that supports the intrinsics needed for
+ * the hardware accelerated CRC kernels. The accelerated kernels are compiled
+ * with a target attribute and only called after a runtime CPU check. The
+ * library itself therefore still runs on every x86-64 processor.
+ */
+
+#if defined(__x86_64__)  ||  defined(_M_X64)
+#if defined(__GNUC__)  ||  defined(__clang__)  ||  defined(_MSC_VER)
+#define LIBCRC_X86_64
+#endif
+#endif
+
+#if defined(__GNUC__)  ||  defined(__clang__)
+#define LIBCRC_TARGET(x)	__attribute__((target(x)))
+#else
+#define LIBCRC_TARGET(x)
+#endif
+
+/*
+ * #define CRC_CACHE_ALIGN
+ *
+ * The lookup tables generated by the precalc program are aligned on a cache
+ * line boundary with the CRC_CACHE_ALIGN macro. A 256 entry table of 32 bit
+ * values then occupies exactly 16 cache lines.
+ */
+
+#if defined(_MSC_VER)
+#define CRC_CACHE_ALIGN		__declspec(align(64))
+#elif defined(__GNUC__)  ||  defined(__clang__)
+#define CRC_CACHE_ALIGN		__attribute__((aligned(64)))
+#else
+#define CRC_CACHE_ALIGN
+#endif
+
+/*
+ * #define CRC_ATOMIC_xxxx
+ *
+ * Values which are shared between threads and initialized on first use are
+ * read and written with the CRC_ATOMIC_LOAD() and CRC_ATOMIC_STORE() macros.
+ * Shared pointers use the CRC_ATOMIC_LOAD_PTR() and CRC_ATOMIC_STORE_PTR()
+ * variants.
+ */
+
+#if defined(__GNUC__)  ||  defined(__clang__)
+#define CRC_ATOMIC_LOAD(p)	__atomic_load_n( (p), __ATOMIC_ACQUIRE )
+#define CRC_ATOMIC_STORE(p,v)	__atomic_store_n( (p), (v), __ATOMIC_RELEASE )
+#define CRC_ATOMIC_LOAD_PTR(p)	__atomic_load_n( (p), __ATOMIC_ACQUIRE )
+#define CRC_ATOMIC_STORE_PTR(p,v) __atomic_store_n( (p), (v), __ATOMIC_RELEASE )
+#else
+#define CRC_ATOMIC_LOAD(p)	(*(volatile const int *)(p))
+#define CRC_ATOMIC_STORE(p,v)	(*(volatile int *)(p) = (v))
+#define CRC_ATOMIC_LOAD_PTR(p)	(*(void *volatile const *)(p))
+#define CRC_ATOMIC_STORE_PTR(p,v) (*(void *volatile *)(p) = (v))
+#endif
+
+/*
+ * #define CRC_CPU_xxxx
+ *
+ * The constants of the form CRC_CPU_xxxx are the bits returned by the function
+ * crc_cpu_features() for the processor extensions used by the library.
+ */
+
+#define		CRC_CPU_SSSE3		0x0001
+#define		CRC_CPU_SSE41		0x0002
+#define		CRC_CPU_SSE42		0x0004
+#define		CRC_CPU_PCLMUL		0x0008
+#define		CRC_CPU_AVX2		0x0010
+#define		CRC_CPU_AVX512		0x0020
+#define		CRC_CPU_VPCLMUL		0x0040
+
+/*
+ * struct crc_fold_tp
+ *
+ * The structure crc_fold_tp contains the constants used by the carry-less
+ * multiplication folding kernels. Each pair holds the remainders modulo the
+ * CRC polynomial of the powers of x needed to move the low and high 64 bit
+ * halves of a 128 bit accumulator forward over a distance of 512 or 128 bits.
+ * The values are generated by the precalc program.
+ */
+
+						/************************************************/
+struct crc_fold_tp {				/*						*/
+	uint64_t	fold512_lo;		/* Folds the low half over 512 bits		*/
+	uint64_t	fold512_hi;		/* Folds the high half over 512 bits		*/
+	uint64_t	fold128_lo;		/* Folds the low half over 128 bits		*/
+	uint64_t	fold128_hi;		/* Folds the high half over 128 bits		*/
+};						/*						*/
+						/************************************************/
+
+/*
+ * struct crc_poly_tp
+ *
+ * The structure crc_poly_tp describes a CRC polynomial for the arithmetic
+ * modulo that polynomial. The polynomial is stored in the same bit order as
+ * the CRC register of the algorithm, without its highest order term. The
+ * table x2n contains the remainders of x^(2^k) for k = 0 .. 66.
+ */
+
+						/************************************************/
+struct crc_poly_tp {				/*						*/
+	int		bits;			/* The order of the polynomial			*/
+	bool		reflected;		/* True when the bits are reflected		*/
+	uint64_t	poly;			/* The polynomial without the x^bits term	*/
+	const uint64_t *x2n;			/* The remainders of x^(2^k) modulo poly	*/
+};						/*						*/
+						/************************************************/
+
+/*
+ * struct crc_dispatch_tp
+ *
+ * The structure crc_dispatch_tp describes one implementation level of the
+ * runtime dispatch layer. The block routines ask crc_dispatch() for the
+ * active level and use its fields to choose between the byte-at-a-time
+ * loops, slicing-by-8, the crc32 instruction and the carry-less
+ * multiplication kernels. A buffer is only folded when it is at least as
+ * long as the minimum size of its CRC width, which is SIZE_MAX for levels
+ * without folding.
+ */
+
+						/************************************************/
+struct crc_dispatch_tp {			/*						*/
+	const char *	name;			/* Name used by LIBCRC_IMPL			*/
+	unsigned int	features;		/* CRC_CPU_xxxx flags needed by the level	*/
+	bool		slice8;			/* Slicing-by-8 instead of one byte at a time	*/
+	bool		sse42;			/* CRC-32C with the crc32 instruction		*/
+	size_t		clmul_min_8;		/* Minimum length to fold an 8 bit CRC		*/
+	size_t		clmul_min_16;		/* Minimum length to fold a 16 bit CRC		*/
+	size_t		clmul_min_32;		/* Minimum length to fold a 32 bit CRC		*/
+	size_t		clmul_min_64;		/* Minimum length to fold a 64 bit CRC		*/
+};						/*						*/
+						/************************************************/
+
+/*
+ * #define CRC_BATCH_LANES
+ *
+ * The number of independent buffers which the batch routines process in an
+ * interleaved way. The lane kernels are written out for this number of
+ * lanes.
+ */
+
+#define CRC_BATCH_LANES		4
+
+/*
+ * #define CRC_BATCH_MIN
+ *
+ * The minimum length of a buffer which the batch routines interleave with
+ * other buffers. Shorter buffers are processed on their own, because with
+ * them the bookkeeping of ragged lanes costs more than the interleave gains.
+ */
+
+#define CRC_BATCH_MIN		128
+
+/*
+ * struct crc_batch_tp
+ *
+ * The structure crc_batch_tp describes a CRC algorithm for the batch
+ * routines. The lanes routine processes the same number of bytes of
+ * CRC_BATCH_LANES buffers at once, the block routine one buffer. Only buffers
+ * of at least lanes_min and less than solo_min bytes are interleaved. Longer
+ * buffers are processed on their own, because the folding kernels are faster
+ * for them.
+ */
+
+						/************************************************/
+struct crc_batch_tp {				/*						*/
+	int		bits;			/* The width of the CRC				*/
+	uint64_t	start;			/* The start value of the register		*/
+	uint64_t	xor_out;		/* The value XORed with the final register	*/
+	size_t		lanes_min;		/* Minimum length to interleave a buffer	*/
+	size_t		solo_min;		/* Minimum length to process a buffer alone	*/
+	void		(*lanes)( uint64_t crc[CRC_BATCH_LANES], const unsigned char *ptr[CRC_BATCH_LANES], size_t num_bytes );
+	uint64_t	(*block)( uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+};						/*						*/
+						/************************************************/
+
+/*
+ * Prototype list of library internal functions
+ */
+
+uint8_t			crc_8_block(         uint8_t  crc, const unsigned char *ptr, size_t num_bytes );
+uint8_t			crc_8_autosar_block( uint8_t  crc, const unsigned char *ptr, size_t num_bytes );
+uint8_t			crc_8_maxim_block(   uint8_t  crc, const unsigned char *ptr, size_t num_bytes );
+uint8_t			crc_8_smbus_block(   uint8_t  crc, const unsigned char *ptr, size_t num_bytes );
+uint16_t		crc_16_block(        uint16_t crc, const unsigned char *ptr, size_t num_bytes );
+uint32_t		crc_32_block(        uint32_t crc, const unsigned char *ptr, size_t num_bytes );
+uint32_t		crc_32c_block(       uint32_t crc, const unsigned char *ptr, size_t num_bytes );
+uint64_t		crc_64_block(        uint64_t crc, const unsigned char *ptr, size_t num_bytes );
+uint16_t		crc_ccitt_block(     uint16_t crc, const unsigned char *ptr, size_t num_bytes );
+uint16_t		crc_dnp_block(       uint16_t crc, const unsigned char *ptr, size_t num_bytes );
+uint16_t		crc_kermit_block(    uint16_t crc, const unsigned char *ptr, size_t num_bytes );
+uint16_t		crc_sick_block(      uint16_t crc, unsigned char prev_byte, const unsigned char *ptr, size_t num_bytes );
+void			crc_batch_run( const struct crc_batch_tp *batch, const unsigned char *const bufs[], const size_t lens[], void *out, size_t n );
+unsigned int		crc_cpu_features( void );
+unsigned long		crc_cpu_signature( void );
+const struct crc_dispatch_tp *	crc_dispatch( void );
+struct crc_dispatch_tp *	crc_dispatch_level( const char *name );
+unsigned long		crc_parallel_worker_jobs( void );
+uint8_t			crc_8_lsb_update(  uint8_t  crc, const unsigned char *ptr, size_t num_bytes, const uint8_t  tab[8][256], const struct crc_fold_tp *fold );
+uint8_t			crc_8_msb_update(  uint8_t  crc, const unsigned char *ptr, size_t num_bytes, const uint8_t  tab[8][256], const struct crc_fold_tp *fold );
+uint16_t		crc_16_lsb_update( uint16_t crc, const unsigned char *ptr, size_t num_bytes, const uint16_t tab[8][256], const struct crc_fold_tp *fold );
+uint16_t		crc_16_msb_update( uint16_t crc, const unsigned char *ptr, size_t num_bytes, const uint16_t tab[8][256], const struct crc_fold_tp *fold );
+uint64_t		crc_64_lsb_update( uint64_t crc, const unsigned char *ptr, size_t num_bytes, const uint64_t tab[8][256], const struct crc_fold_tp *fold );
+uint64_t		crc_64_msb_update( uint64_t crc, const unsigned char *ptr, size_t num_bytes, const uint64_t tab[8][256], const struct crc_fold_tp *fold );
+void			crc_16_lsb_lanes(  uint64_t crc[CRC_BATCH_LANES], const unsigned char *ptr[CRC_BATCH_LANES], size_t num_bytes, const uint16_t tab[8][256] );
+uint64_t		crc_poly_mulmod( const struct crc_poly_tp *poly, uint64_t a, uint64_t b );
+uint64_t		crc_poly_shift(  const struct crc_poly_tp *poly, uint64_t crc, size_t num_bytes );
+uint64_t		crc_poly_xpow(   const struct crc_poly_tp *poly, size_t n, int k );
+#if defined(LIBCRC_X86_64)
+void			crc_fold_lsb( const unsigned char *ptr, size_t num_bytes, uint64_t init, const struct crc_fold_tp *fold, unsigned char result[16] );
+void			crc_fold_msb( const unsigned char *ptr, size_t num_bytes, uint64_t init, const struct crc_fold_tp *fold, unsigned char result[16] );
+#endif
+
+#endif  // DEF_LIBCRC_CRCINT_H
@@ -34,11 +34,13 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include "checksum.h"
+#include "crcint.h"
 
-static void		init_crc_tab( void );
+/*
+ * Include the lookup table for the Kermit calculation
+ */
 
-static bool		crc_tab_init		= false;
-static uint16_t		crc_tab[256];
+#include "../tab/gentabkr.inc"
 
 /*
  * uint16_t crc_kermit( const unsigned char *input_str, size_t num_bytes );
@@ -53,18 +55,10 @@ uint16_t crc_kermit( const unsigned char *input_str, size_t num_bytes ) {
 	uint16_t crc;
 	uint16_t low_byte;
 	uint16_t high_byte;
-	const unsigned char *ptr;
-	size_t a;
-
-	if ( ! crc_tab_init ) init_crc_tab();
 
 	crc = CRC_START_KERMIT;
-	ptr = input_str;
 
-	if ( ptr != NULL ) for (a=0; a<num_bytes; a++) {
-
-		crc = (crc >> 8) ^ crc_tab[ (crc ^ (uint16_t) *ptr++) & 0x00FF ];
-	}
+	if ( input_str != NULL ) crc = crc_kermit_block( crc, input_str, num_bytes );
 
 	low_byte  = (crc & 0xff00) >> 8;
 	high_byte = (crc & 0x00ff) << 8;
@@ -75,52 +69,28 @@ uint16_t crc_kermit( const unsigned char *input_str, size_t num_bytes ) {
 }  /* crc_kermit */
 
 /*
- * uint16_t update_crc_kermit( uint16_t crc, unsigned char c );
+ * uint16_t crc_kermit_block( uint16_t crc, const unsigned char *ptr, size_t num_bytes );
  *
- * The function update_crc_kermit() calculates a new CRC Kermit value based on
- * the previous value of the CRC and the next byte of data to be checked.
+ * The function crc_kermit_block() updates a Kermit register with the contents
+ * of a byte buffer. The byte swap of the final Kermit CRC value is not
+ * applied.
  */
 
-uint16_t update_crc_kermit( uint16_t crc, unsigned char c ) {
-
-	if ( ! crc_tab_init ) init_crc_tab();
+uint16_t crc_kermit_block( uint16_t crc, const unsigned char *ptr, size_t num_bytes ) {
 
-	return (crc >> 8) ^ crc_tab[ (crc ^ (uint16_t) c) & 0x00FF ];
+	return crc_16_lsb_update( crc, ptr, num_bytes, crc_tabkrmit_slice8, & crc_tabkrmit_fold );
 
-}  /* update_crc_kermit */
+}  /* crc_kermit_block */
 
 /*
- * static void init_crc_tab( void );
+ * uint16_t update_crc_kermit( uint16_t crc, unsigned char c );
  *
- * For optimal performance, the  CRC Kermit routine uses a lookup table with
- * values that can be used directly in the XOR arithmetic in the algorithm.
- * This lookup table is calculated by the init_crc_tab() routine, the first
- * time the CRC function is called.
+ * The function update_crc_kermit() calculates a new CRC Kermit value based on
+ * the previous value of the CRC and the next byte of data to be checked.
  */
 
-static void init_crc_tab( void ) {
-
-	uint16_t i;
-	uint16_t j;
-	uint16_t crc;
-	uint16_t c;
-
-	for (i=0; i<256; i++) {
-
-		crc = 0;
-		c   = i;
-
-		for (j=0; j<8; j++) {
-
-			if ( (crc ^ c) & 0x0001 ) crc = ( crc >> 1 ) ^ CRC_POLY_KERMIT;
-			else                      crc =   crc >> 1;
-
-			c = c >> 1;
-		}
-
-		crc_tab[i] = crc;
-	}
+uint16_t update_crc_kermit( uint16_t crc, unsigned char c ) {
 
-	crc_tab_init = true;
+	return (crc >> 8) ^ crc_tabkrmit[ (crc ^ (uint16_t) c) & 0x00FF ];
 
-}  /* init_crc_tab */
+}  /* update_crc_kermit */
@@ -0,0 +1,691 @@
+/*
+ * Library: libcrc
+ * File:    src/crcmodel.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2026 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crcmodel.c contains a CRC engine for any algorithm
+ * which can be described with the parameters of the Rocksoft model, together
+ * with a catalog of the commonly published algorithms. The lookup tables and
+ * folding constants of a polynomial are built on first use and kept in a
+ * process wide cache, after which the calculation runs on the same slicing
+ * and folding kernels as the built-in routines.
+ *
+ * Every width is handled as a 64 bit CRC. A non reflected register is kept in
+ * the top bits of a 64 bit value, which turns the calculation into a 64 bit
+ * CRC with the polynomial shifted up by the same amount. A reflected register
+ * is kept in the low bits, which is the mirror image of the same trick.
+ */
+
+#include <ctype.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "checksum.h"
+#include "crcint.h"
+
+#if ! defined(_WIN32)
+#define CRC_HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
+/*
+ * #define CRC_MODEL_xxxx
+ *
+ * CRC_MODEL_MAX_ENGINES limits the number of polynomials kept in the cache.
+ * Each entry uses 16 kB of tables. Calculations with other polynomials build
+ * temporary tables. The name index has CRC_MODEL_HASH_SIZE slots, a power of
+ * two, and up to CRC_MODEL_SEED_TRIES hash seeds are tried to find one where
+ * no two names share a slot.
+ */
+
+#define CRC_MODEL_MAX_ENGINES		64
+#define CRC_MODEL_HASH_SIZE		1024
+#define CRC_MODEL_SEED_TRIES		4096
+
+/*
+ * struct crc_engine_tp
+ *
+ * The structure crc_engine_tp contains the tables and folding constants for
+ * one polynomial and bit order. The entries of the cache form a linked list
+ * which is only extended at the head, so readers can walk it without a lock.
+ */
+
+						/************************************************/
+struct crc_engine_tp {				/*						*/
+	struct crc_engine_tp *next;		/* Next entry in the cache			*/
+	int		width;			/* Width of the CRC				*/
+	uint64_t	poly;			/* Polynomial in normal bit order		*/
+	bool		reflected;		/* Bytes are processed LSB first		*/
+	struct crc_fold_tp fold;		/* Constants for the folding kernels		*/
+	uint64_t	tab[8][256];		/* Slicing-by-8 lookup tables			*/
+};						/*						*/
+						/************************************************/
+
+/*
+ * struct crc_name_tp
+ *
+ * The structure crc_name_tp is one slot of the index used to find an
+ * algorithm of the catalog by its name or by one of its aliases.
+ */
+
+						/************************************************/
+struct crc_name_tp {				/*						*/
+	const char *	name;			/* Name or alias of the algorithm		*/
+	const char *	target;			/* Catalog name an alias refers to		*/
+	const struct crc_model *model;		/* Entry in the catalog				*/
+};						/*						*/
+						/************************************************/
+
+static const struct crc_engine_tp *	engine_find( const struct crc_model *model );
+static void				engine_init( struct crc_engine_tp *engine, const struct crc_model *model );
+static void				index_build( void );
+static uint32_t				name_hash( const char *name, uint32_t seed );
+static bool				name_equal( const char *name1, const char *name2 );
+static uint64_t				reflect( uint64_t value, int bits );
+static uint64_t				update_bitwise( uint64_t crc, const unsigned char *ptr, size_t num_bytes, uint64_t poly, bool reflected );
+static uint64_t				xpow_mod( int n, uint64_t poly );
+
+/*
+ * static const struct crc_model crc_model_catalog[];
+ *
+ * The catalog contains the parameters of the commonly used CRC algorithms
+ * under the names of the CRC RevEng catalogue, sorted by width and name.
+ */
+
+static const struct crc_model crc_model_catalog[] = {
+	{ "CRC-3/GSM",           3, 0x3ull, 0x0ull, false, false, 0x7ull, 0x4ull },
+	{ "CRC-3/ROHC",          3, 0x3ull, 0x7ull, true,  true,  0x0ull, 0x6ull },
+	{ "CRC-4/G-704",         4, 0x3ull, 0x0ull, true,  true,  0x0ull, 0x7ull },
+	{ "CRC-4/INTERLAKEN",    4, 0x3ull, 0xFull, false, false, 0xFull, 0xBull },
+	{ "CRC-5/EPC-C1G2",      5, 0x09ull, 0x09ull, false, false, 0x00ull, 0x00ull },
+	{ "CRC-5/G-704",         5, 0x15ull, 0x00ull, true,  true,  0x00ull, 0x07ull },
+	{ "CRC-5/USB",           5, 0x05ull, 0x1Full, true,  true,  0x1Full, 0x19ull },
+	{ "CRC-6/CDMA2000-A",    6, 0x27ull, 0x3Full, false, false, 0x00ull, 0x0Dull },
+	{ "CRC-6/G-704",         6, 0x03ull, 0x00ull, true,  true,  0x00ull, 0x06ull },
+	{ "CRC-7/MMC",           7, 0x09ull, 0x00ull, false, false, 0x00ull, 0x75ull },
+	{ "CRC-7/ROHC",          7, 0x4Full, 0x7Full, true,  true,  0x00ull, 0x53ull },
+	{ "CRC-8/AUTOSAR",       8, 0x2Full, 0xFFull, false, false, 0xFFull, 0xDFull },
+	{ "CRC-8/BLUETOOTH",     8, 0xA7ull, 0x00ull, true,  true,  0x00ull, 0x26ull },
+	{ "CRC-8/I-432-1",       8, 0x07ull, 0x00ull, false, false, 0x55ull, 0xA1ull },
+	{ "CRC-8/MAXIM-DOW",     8, 0x31ull, 0x00ull, true,  true,  0x00ull, 0xA1ull },
+	{ "CRC-8/NRSC-5",        8, 0x31ull, 0xFFull, false, false, 0x00ull, 0xF7ull },
+	{ "CRC-8/ROHC",          8, 0x07ull, 0xFFull, true,  true,  0x00ull, 0xD0ull },
+	{ "CRC-8/SAE-J1850",     8, 0x1Dull, 0xFFull, false, false, 0xFFull, 0x4Bull },
+	{ "CRC-8/SMBUS",         8, 0x07ull, 0x00ull, false, false, 0x00ull, 0xF4ull },
+	{ "CRC-8/WCDMA",         8, 0x9Bull, 0x00ull, true,  true,  0x00ull, 0x25ull },
+	{ "CRC-10/ATM",         10, 0x233ull, 0x000ull, false, false, 0x000ull, 0x199ull },
+	{ "CRC-11/FLEXRAY",     11, 0x385ull, 0x01Aull, false, false, 0x000ull, 0x5A3ull },
+	{ "CRC-12/DECT",        12, 0x80Full, 0x000ull, false, false, 0x000ull, 0xF5Bull },
+	{ "CRC-12/UMTS",        12, 0x80Full, 0x000ull, false, true,  0x000ull, 0xDAFull },
+	{ "CRC-13/BBC",         13, 0x1CF5ull, 0x0000ull, false, false, 0x0000ull, 0x04FAull },
+	{ "CRC-14/DARC",        14, 0x0805ull, 0x0000ull, true,  true,  0x0000ull, 0x082Dull },
+	{ "CRC-15/CAN",         15, 0x4599ull, 0x0000ull, false, false, 0x0000ull, 0x059Eull },
+	{ "CRC-16/ARC",         16, 0x8005ull, 0x0000ull, true,  true,  0x0000ull, 0xBB3Dull },
+	{ "CRC-16/CDMA2000",    16, 0xC867ull, 0xFFFFull, false, false, 0x0000ull, 0x4C06ull },
+	{ "CRC-16/DECT-X",      16, 0x0589ull, 0x0000ull, false, false, 0x0000ull, 0x007Full },
+	{ "CRC-16/DNP",         16, 0x3D65ull, 0x0000ull, true,  true,  0xFFFFull, 0xEA82ull },
+	{ "CRC-16/GENIBUS",     16, 0x1021ull, 0xFFFFull, false, false, 0xFFFFull, 0xD64Eull },
+	{ "CRC-16/IBM-3740",    16, 0x1021ull, 0xFFFFull, false, false, 0x0000ull, 0x29B1ull },
+	{ "CRC-16/IBM-SDLC",    16, 0x1021ull, 0xFFFFull, true,  true,  0xFFFFull, 0x906Eull },
+	{ "CRC-16/KERMIT",      16, 0x1021ull, 0x0000ull, true,  true,  0x0000ull, 0x2189ull },
+	{ "CRC-16/MAXIM-DOW",   16, 0x8005ull, 0x0000ull, true,  true,  0xFFFFull, 0x44C2ull },
+	{ "CRC-16/MCRF4XX",     16, 0x1021ull, 0xFFFFull, true,  true,  0x0000ull, 0x6F91ull },
+	{ "CRC-16/MODBUS",      16, 0x8005ull, 0xFFFFull, true,  true,  0x0000ull, 0x4B37ull },
+	{ "CRC-16/RIELLO",      16, 0x1021ull, 0xB2AAull, true,  true,  0x0000ull, 0x63D0ull },
+	{ "CRC-16/SPI-FUJITSU", 16, 0x1021ull, 0x1D0Full, false, false, 0x0000ull, 0xE5CCull },
+	{ "CRC-16/T10-DIF",     16, 0x8BB7ull, 0x0000ull, false, false, 0x0000ull, 0xD0DBull },
+	{ "CRC-16/UMTS",        16, 0x8005ull, 0x0000ull, false, false, 0x0000ull, 0xFEE8ull },
+	{ "CRC-16/USB",         16, 0x8005ull, 0xFFFFull, true,  true,  0xFFFFull, 0xB4C8ull },
+	{ "CRC-16/XMODEM",      16, 0x1021ull, 0x0000ull, false, false, 0x0000ull, 0x31C3ull },
+	{ "CRC-17/CAN-FD",      17, 0x1685Bull, 0x00000ull, false, false, 0x00000ull, 0x04F03ull },
+	{ "CRC-21/CAN-FD",      21, 0x102899ull, 0x000000ull, false, false, 0x000000ull, 0x0ED841ull },
+	{ "CRC-24/BLE",         24, 0x00065Bull, 0x555555ull, true,  true,  0x000000ull, 0xC25A56ull },
+	{ "CRC-24/FLEXRAY-A",   24, 0x5D6DCBull, 0xFEDCBAull, false, false, 0x000000ull, 0x7979BDull },
+	{ "CRC-24/LTE-A",       24, 0x864CFBull, 0x000000ull, false, false, 0x000000ull, 0xCDE703ull },
+	{ "CRC-24/OPENPGP",     24, 0x864CFBull, 0xB704CEull, false, false, 0x000000ull, 0x21CF02ull },
+	{ "CRC-30/CDMA",        30, 0x2030B9C7ull, 0x3FFFFFFFull, false, false, 0x3FFFFFFFull, 0x04C34ABFull },
+	{ "CRC-31/PHILIPS",     31, 0x04C11DB7ull, 0x7FFFFFFFull, false, false, 0x7FFFFFFFull, 0x0CE9E46Cull },
+	{ "CRC-32/AIXM",        32, 0x814141ABull, 0x00000000ull, false, false, 0x00000000ull, 0x3010BF7Full },
+	{ "CRC-32/BASE91-D",    32, 0xA833982Bull, 0xFFFFFFFFull, true,  true,  0xFFFFFFFFull, 0x87315576ull },
+	{ "CRC-32/BZIP2",       32, 0x04C11DB7ull, 0xFFFFFFFFull, false, false, 0xFFFFFFFFull, 0xFC891918ull },
+	{ "CRC-32/CKSUM",       32, 0x04C11DB7ull, 0x00000000ull, false, false, 0xFFFFFFFFull, 0x765E7680ull },
+	{ "CRC-32/ISCSI",       32, 0x1EDC6F41ull, 0xFFFFFFFFull, true,  true,  0xFFFFFFFFull, 0xE3069283ull },
+	{ "CRC-32/ISO-HDLC",    32, 0x04C11DB7ull, 0xFFFFFFFFull, true,  true,  0xFFFFFFFFull, 0xCBF43926ull },
+	{ "CRC-32/JAMCRC",      32, 0x04C11DB7ull, 0xFFFFFFFFull, true,  true,  0x00000000ull, 0x340BC6D9ull },
+	{ "CRC-32/MPEG-2",      32, 0x04C11DB7ull, 0xFFFFFFFFull, false, false, 0x00000000ull, 0x0376E6E7ull },
+	{ "CRC-32/XFER",        32, 0x000000AFull, 0x00000000ull, false, false, 0x00000000ull, 0xBD0BE338ull },
+	{ "CRC-40/GSM",         40, 0x0004820009ull, 0x0000000000ull, false, false, 0xFFFFFFFFFFull, 0xD4164FC646ull },
+	{ "CRC-64/ECMA-182",    64, 0x42F0E1EBA9EA3693ull, 0x0000000000000000ull, false, false, 0x0000000000000000ull, 0x6C40DF5F0B497347ull },
+	{ "CRC-64/GO-ISO",      64, 0x000000000000001Bull, 0xFFFFFFFFFFFFFFFFull, true,  true,  0xFFFFFFFFFFFFFFFFull, 0xB90956C775A41001ull },
+	{ "CRC-64/MS",          64, 0x259C84CBA6426349ull, 0xFFFFFFFFFFFFFFFFull, true,  true,  0x0000000000000000ull, 0x75D4B74F024ECEEAull },
+	{ "CRC-64/NVME",        64, 0xAD93D23594C93659ull, 0xFFFFFFFFFFFFFFFFull, true,  true,  0xFFFFFFFFFFFFFFFFull, 0xAE8B14860A799888ull },
+	{ "CRC-64/REDIS",       64, 0xAD93D23594C935A9ull, 0x0000000000000000ull, true,  true,  0x0000000000000000ull, 0xE9C6D914C4B8D9CAull },
+	{ "CRC-64/WE",          64, 0x42F0E1EBA9EA3693ull, 0xFFFFFFFFFFFFFFFFull, false, false, 0xFFFFFFFFFFFFFFFFull, 0x62EC59E3F1A4F00Aull },
+	{ "CRC-64/XZ",          64, 0x42F0E1EBA9EA3693ull, 0xFFFFFFFFFFFFFFFFull, true,  true,  0xFFFFFFFFFFFFFFFFull, 0x995DC9BBDF1939FAull },
+};
+
+/*
+ * static const struct crc_name_tp crc_model_alias[];
+ *
+ * Other names under which the algorithms of the catalog are widely known.
+ */
+
+static const struct crc_name_tp crc_model_alias[] = {
+	{ "CRC-8",              "CRC-8/SMBUS",        NULL },
+	{ "CRC-8/MAXIM",        "CRC-8/MAXIM-DOW",    NULL },
+	{ "CRC-16",             "CRC-16/ARC",         NULL },
+	{ "CRC-16/AUG-CCITT",   "CRC-16/SPI-FUJITSU", NULL },
+	{ "CRC-16/BUYPASS",     "CRC-16/UMTS",        NULL },
+	{ "CRC-16/CCITT",       "CRC-16/KERMIT",      NULL },
+	{ "CRC-16/CCITT-FALSE", "CRC-16/IBM-3740",    NULL },
+	{ "CRC-16/LHA",         "CRC-16/ARC",         NULL },
+	{ "CRC-16/MAXIM",       "CRC-16/MAXIM-DOW",   NULL },
+	{ "CRC-16/X-25",        "CRC-16/IBM-SDLC",    NULL },
+	{ "CRC-16/ZMODEM",      "CRC-16/XMODEM",      NULL },
+	{ "CRC-24",             "CRC-24/OPENPGP",     NULL },
+	{ "CRC-32",             "CRC-32/ISO-HDLC",    NULL },
+	{ "CRC-32/CASTAGNOLI",  "CRC-32/ISCSI",       NULL },
+	{ "CRC-32/POSIX",       "CRC-32/CKSUM",       NULL },
+	{ "CRC-32C",            "CRC-32/ISCSI",       NULL },
+	{ "CRC-64",             "CRC-64/ECMA-182",    NULL },
+	{ "CRC-64/GO-ECMA",     "CRC-64/XZ",          NULL }
+};
+
+#define CRC_MODEL_NUM	( sizeof(crc_model_catalog) / sizeof(crc_model_catalog[0]) )
+#define CRC_ALIAS_NUM	( sizeof(crc_model_alias)   / sizeof(crc_model_alias[0])   )
+
+static struct crc_engine_tp *	engine_list;
+static int			engine_count;
+static struct crc_name_tp	name_index[CRC_MODEL_HASH_SIZE];
+static uint32_t			name_seed;
+static int			name_index_ready;
+
+#if defined(CRC_HAVE_PTHREAD)
+static pthread_mutex_t		model_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/*
+ * uint64_t crc_model_calc( const struct crc_model *model, const unsigned char *input_str, size_t num_bytes );
+ *
+ * The function crc_model_calc() calculates the CRC of a byte buffer with the
+ * algorithm described by model. The model can be an entry of the catalog or
+ * a structure filled in by the caller, only the name and check fields are
+ * not used. When input_str is NULL the CRC of an empty buffer is returned.
+ * The function returns 0 when the model is NULL or the width is not in the
+ * range 1 to 64.
+ */
+
+uint64_t crc_model_calc( const struct crc_model *model, const unsigned char *input_str, size_t num_bytes ) {
+
+	uint64_t init;
+	uint64_t mask;
+
+	if ( model == NULL  ||  model->width < 1  ||  model->width > 64 ) return 0;
+
+	mask = 0xFFFFFFFFFFFFFFFFull >> (64 - model->width);
+	init = model->init & mask;
+
+	if ( model->refout ) init = reflect( init, model->width );
+
+	return crc_model_update( model, init ^ model->xorout, input_str, num_bytes );
+
+}  /* crc_model_calc */
+
+/*
+ * uint64_t crc_model_update( const struct crc_model *model, uint64_t crc, const unsigned char *input_str, size_t num_bytes );
+ *
+ * The function crc_model_update() continues a CRC calculation with the next
+ * part of the data. The parameter crc is the value returned by an earlier
+ * call to crc_model_calc() or crc_model_update() with the same model. The
+ * final XOR and output reflection are undone before the register is updated,
+ * so the data may be split at any byte boundary.
+ */
+
+uint64_t crc_model_update( const struct crc_model *model, uint64_t crc, const unsigned char *input_str, size_t num_bytes ) {
+
+	int shift;
+	uint64_t mask;
+	uint64_t poly;
+	const struct crc_engine_tp *engine;
+	struct crc_engine_tp *temp;
+
+	if ( model == NULL  ||  model->width < 1  ||  model->width > 64 ) return 0;
+
+	shift = 64 - model->width;
+	mask  = 0xFFFFFFFFFFFFFFFFull >> shift;
+	crc   = ( crc ^ model->xorout ) & mask;
+
+	if ( model->refout != model->refin ) crc = reflect( crc, model->width );
+	if ( ! model->refin                ) crc <<= shift;
+
+	if ( input_str != NULL  &&  num_bytes > 0 ) {
+
+		engine = engine_find( model );
+
+		if ( engine != NULL ) {
+
+			if ( model->refin ) crc = crc_64_lsb_update( crc, input_str, num_bytes, engine->tab, & engine->fold );
+			else                crc = crc_64_msb_update( crc, input_str, num_bytes, engine->tab, & engine->fold );
+		}
+
+		else if ( ( temp = malloc( sizeof(struct crc_engine_tp) ) ) != NULL ) {
+
+			engine_init( temp, model );
+
+			if ( model->refin ) crc = crc_64_lsb_update( crc, input_str, num_bytes, temp->tab, & temp->fold );
+			else                crc = crc_64_msb_update( crc, input_str, num_bytes, temp->tab, & temp->fold );
+
+			free( temp );
+		}
+
+		else {
+
+			poly = ( model->poly & mask ) << shift;
+			crc  = update_bitwise( crc, input_str, num_bytes, poly, model->refin );
+		}
+	}
+
+	if ( ! model->refin                ) crc >>= shift;
+	if ( model->refout != model->refin ) crc = reflect( crc, model->width );
+
+	return ( crc ^ model->xorout ) & mask;
+
+}  /* crc_model_update */
+
+/*
+ * const struct crc_model *crc_model_find( const char *name );
+ *
+ * The function crc_model_find() returns the entry of the catalog with the
+ * given name or alias. Upper and lower case are not distinguished. The name
+ * index is built on the first call with a hash seed for which every name has
+ * its own slot, so a lookup takes one hash calculation and one compare. NULL
+ * is returned when the name is unknown.
+ */
+
+const struct crc_model *crc_model_find( const char *name ) {
+
+	uint32_t slot;
+
+	if ( name == NULL ) return NULL;
+
+	if ( ! CRC_ATOMIC_LOAD( & name_index_ready ) ) index_build();
+
+	slot = name_hash( name, name_seed ) & ( CRC_MODEL_HASH_SIZE - 1 );
+
+	while ( name_index[slot].name != NULL ) {
+
+		if ( name_equal( name_index[slot].name, name ) ) return name_index[slot].model;
+
+		slot = ( slot + 1 ) & ( CRC_MODEL_HASH_SIZE - 1 );
+	}
+
+	return NULL;
+
+}  /* crc_model_find */
+
+/*
+ * const struct crc_model *crc_model_list( size_t *num_models );
+ *
+ * The function crc_model_list() returns the array with all entries of the
+ * catalog and stores the number of entries in num_models.
+ */
+
+const struct crc_model *crc_model_list( size_t *num_models ) {
+
+	if ( num_models != NULL ) *num_models = CRC_MODEL_NUM;
+
+	return crc_model_catalog;
+
+}  /* crc_model_list */
+
+/*
+ * static const struct crc_engine_tp *engine_find( const struct crc_model *model );
+ *
+ * The function engine_find() returns the cache entry for the polynomial and
+ * bit order of a model. A missing entry is built while the lock is held and
+ * then published at the head of the list. The function returns NULL when the
+ * cache is full or no memory is available.
+ */
+
+static const struct crc_engine_tp *engine_find( const struct crc_model *model ) {
+
+	uint64_t poly;
+	struct crc_engine_tp *engine;
+
+	poly = model->poly & ( 0xFFFFFFFFFFFFFFFFull >> (64 - model->width) );
+
+	for (engine=CRC_ATOMIC_LOAD_PTR( & engine_list ); engine!=NULL; engine=engine->next) {
+
+		if ( engine->width == model->width  &&  engine->poly == poly  &&  engine->reflected == model->refin ) return engine;
+	}
+
+#if defined(CRC_HAVE_PTHREAD)
+	pthread_mutex_lock( & model_lock );
+#endif
+
+	for (engine=engine_list; engine!=NULL; engine=engine->next) {
+
+		if ( engine->width == model->width  &&  engine->poly == poly  &&  engine->reflected == model->refin ) break;
+	}
+
+	if ( engine == NULL  &&  engine_count < CRC_MODEL_MAX_ENGINES ) {
+
+		engine = malloc( sizeof(struct crc_engine_tp) );
+
+		if ( engine != NULL ) {
+
+			engine_init( engine, model );
+			engine->next = engine_list;
+			engine_count++;
+
+			CRC_ATOMIC_STORE_PTR( & engine_list, engine );
+		}
+	}
+
+#if defined(CRC_HAVE_PTHREAD)
+	pthread_mutex_unlock( & model_lock );
+#endif
+
+	return engine;
+
+}  /* engine_find */
+
+/*
+ * static void engine_init( struct crc_engine_tp *engine, const struct crc_model *model );
+ *
+ * The function engine_init() builds the slicing-by-8 tables and folding
+ * constants for a model. Table 0 is the classic byte table, table k moves an
+ * entry of table k-1 over one more zero byte. The folding constants follow
+ * the same formulas as the precalc program uses for the built-in algorithms.
+ */
+
+static void engine_init( struct crc_engine_tp *engine, const struct crc_model *model ) {
+
+	int a;
+	int i;
+	int b;
+	uint64_t crc;
+	uint64_t poly;
+	uint64_t rpoly;
+
+	engine->next      = NULL;
+	engine->width     = model->width;
+	engine->poly      = model->poly & ( 0xFFFFFFFFFFFFFFFFull >> (64 - model->width) );
+	engine->reflected = model->refin;
+
+	poly  = engine->poly << (64 - model->width);
+	rpoly = reflect( poly, 64 );
+
+	for (i=0; i<256; i++) {
+
+		if ( engine->reflected ) {
+
+			crc = (uint64_t) i;
+			for (b=0; b<8; b++) crc = ( crc & 1 ) ? ( crc >> 1 ) ^ rpoly : crc >> 1;
+		}
+
+		else {
+
+			crc = (uint64_t) i << 56;
+			for (b=0; b<8; b++) crc = ( crc >> 63 ) ? ( crc << 1 ) ^ poly : crc << 1;
+		}
+
+		engine->tab[0][i] = crc;
+	}
+
+	for (a=1; a<8; a++) {
+
+		for (i=0; i<256; i++) {
+
+			crc = engine->tab[a-1][i];
+
+			if ( engine->reflected ) engine->tab[a][i] = ( crc >> 8 ) ^ engine->tab[0][ crc & 0xFF ];
+			else                     engine->tab[a][i] = ( crc << 8 ) ^ engine->tab[0][ crc >> 56  ];
+		}
+	}
+
+	if ( engine->reflected ) {
+
+		engine->fold.fold512_lo = reflect( xpow_mod( 512+64-1, poly ), 64 );
+		engine->fold.fold512_hi = reflect( xpow_mod( 512-1,    poly ), 64 );
+		engine->fold.fold128_lo = reflect( xpow_mod( 128+64-1, poly ), 64 );
+		engine->fold.fold128_hi = reflect( xpow_mod( 128-1,    poly ), 64 );
+	}
+
+	else {
+
+		engine->fold.fold512_lo = xpow_mod( 512,    poly );
+		engine->fold.fold512_hi = xpow_mod( 512+64, poly );
+		engine->fold.fold128_lo = xpow_mod( 128,    poly );
+		engine->fold.fold128_hi = xpow_mod( 128+64, poly );
+	}
+
+}  /* engine_init */
+
+/*
+ * static void index_build( void );
+ *
+ * The function index_build() fills the name index with the catalog and the
+ * aliases. Seeds are tried until every name hashes to a different slot. If
+ * no such seed is found the colliding names are placed in the next free
+ * slot, and a lookup of those names takes a few more probes.
+ */
+
+static void index_build( void ) {
+
+	size_t a;
+	size_t b;
+	uint32_t seed;
+	uint32_t slot;
+	bool collision;
+	const char *name;
+	const struct crc_model *model;
+
+#if defined(CRC_HAVE_PTHREAD)
+	pthread_mutex_lock( & model_lock );
+#endif
+
+	if ( ! name_index_ready ) {
+
+		collision = true;
+
+		for (seed=0; seed<CRC_MODEL_SEED_TRIES  &&  collision; seed++) {
+
+			collision = false;
+
+			for (a=0; a<CRC_MODEL_HASH_SIZE; a++) name_index[a].name = NULL;
+
+			for (a=0; a<CRC_MODEL_NUM+CRC_ALIAS_NUM; a++) {
+
+				if ( a < CRC_MODEL_NUM ) name = crc_model_catalog[a].name;
+				else                     name = crc_model_alias[a-CRC_MODEL_NUM].name;
+
+				slot = name_hash( name, seed ) & ( CRC_MODEL_HASH_SIZE - 1 );
+
+				if ( name_index[slot].name != NULL ) { collision = true; break; }
+
+				name_index[slot].name = name;
+			}
+		}
+
+		name_seed = ( collision ) ? 0 : seed - 1;
+
+		for (a=0; a<CRC_MODEL_HASH_SIZE; a++) name_index[a].name = NULL;
+
+		for (a=0; a<CRC_MODEL_NUM+CRC_ALIAS_NUM; a++) {
+
+			if ( a < CRC_MODEL_NUM ) {
+
+				name  = crc_model_catalog[a].name;
+				model = & crc_model_catalog[a];
+			}
+
+			else {
+
+				name  = crc_model_alias[a-CRC_MODEL_NUM].name;
+				model = NULL;
+
+				for (b=0; b<CRC_MODEL_NUM; b++) {
+
+					if ( name_equal( crc_model_catalog[b].name, crc_model_alias[a-CRC_MODEL_NUM].target ) ) model = & crc_model_catalog[b];
+				}
+			}
+
+			slot = name_hash( name, name_seed ) & ( CRC_MODEL_HASH_SIZE - 1 );
+
+			while ( name_index[slot].name != NULL ) slot = ( slot + 1 ) & ( CRC_MODEL_HASH_SIZE - 1 );
+
+			name_index[slot].name  = name;
+			name_index[slot].model = model;
+		}
+
+		CRC_ATOMIC_STORE( & name_index_ready, 1 );
+	}
+
+#if defined(CRC_HAVE_PTHREAD)
+	pthread_mutex_unlock( & model_lock );
+#endif
+
+}  /* index_build */
+
+/*
+ * static uint32_t name_hash( const char *name, uint32_t seed );
+ *
+ * The function name_hash() calculates the 32 bit FNV-1a hash of a name in
+ * upper case, with the seed mixed into the offset basis. The high half is
+ * folded into the low bits which are used as the slot number.
+ */
+
+static uint32_t name_hash( const char *name, uint32_t seed ) {
+
+	uint32_t hash;
+
+	hash = 2166136261u ^ ( seed * 0x9E3779B9u );
+
+	while ( *name ) {
+
+		hash ^= (uint32_t) toupper( (unsigned char) *name++ );
+		hash *= 16777619u;
+	}
+
+	return hash ^ ( hash >> 16 );
+
+}  /* name_hash */
+
+/*
+ * static bool name_equal( const char *name1, const char *name2 );
+ *
+ * The function name_equal() compares two names without distinguishing upper
+ * and lower case.
+ */
+
+static bool name_equal( const char *name1, const char *name2 ) {
+
+	while ( *name1  &&  toupper( (unsigned char) *name1 ) == toupper( (unsigned char) *name2 ) ) {
+
+		name1++;
+		name2++;
+	}
+
+	return ( *name1 == *name2 );
+
+}  /* name_equal */
+
+/*
+ * static uint64_t reflect( uint64_t value, int bits );
+ *
+ * The function reflect() returns the lowest bits of a value in reversed bit
+ * order. The full 64 bit word is reversed by swapping ever smaller groups of
+ * bits, after which the result is shifted down to the requested width.
+ */
+
+static uint64_t reflect( uint64_t value, int bits ) {
+
+	value = ( ( value >>  1 ) & 0x5555555555555555ull ) | ( ( value & 0x5555555555555555ull ) <<  1 );
+	value = ( ( value >>  2 ) & 0x3333333333333333ull ) | ( ( value & 0x3333333333333333ull ) <<  2 );
+	value = ( ( value >>  4 ) & 0x0F0F0F0F0F0F0F0Full ) | ( ( value & 0x0F0F0F0F0F0F0F0Full ) <<  4 );
+	value = ( ( value >>  8 ) & 0x00FF00FF00FF00FFull ) | ( ( value & 0x00FF00FF00FF00FFull ) <<  8 );
+	value = ( ( value >> 16 ) & 0x0000FFFF0000FFFFull ) | ( ( value & 0x0000FFFF0000FFFFull ) << 16 );
+	value = ( value >> 32 ) | ( value << 32 );
+
+	return value >> (64 - bits);
+
+}  /* reflect */
+
+/*
+ * static uint64_t update_bitwise( uint64_t crc, const unsigned char *ptr, size_t num_bytes, uint64_t poly, bool reflected );
+ *
+ * The function update_bitwise() updates a register one bit at a time. It is
+ * only used when no memory is available for the lookup tables. The
+ * polynomial is passed shifted to the top of the 64 bit word.
+ */
+
+static uint64_t update_bitwise( uint64_t crc, const unsigned char *ptr, size_t num_bytes, uint64_t poly, bool reflected ) {
+
+	int b;
+	uint64_t rpoly;
+
+	rpoly = reflect( poly, 64 );
+
+	while ( num_bytes-- > 0 ) {
+
+		if ( reflected ) {
+
+			crc ^= (uint64_t) *ptr++;
+			for (b=0; b<8; b++) crc = ( crc & 1 ) ? ( crc >> 1 ) ^ rpoly : crc >> 1;
+		}
+
+		else {
+
+			crc ^= (uint64_t) *ptr++ << 56;
+			for (b=0; b<8; b++) crc = ( crc >> 63 ) ? ( crc << 1 ) ^ poly : crc << 1;
+		}
+	}
+
+	return crc;
+
+}  /* update_bitwise */
+
+/*
+ * static uint64_t xpow_mod( int n, uint64_t poly );
+ *
+ * The function xpow_mod() calculates the remainder of x^n modulo the 64 bit
+ * polynomial x^64 + poly.
+ */
+
+static uint64_t xpow_mod( int n, uint64_t poly ) {
+
+	int a;
+	uint64_t rem;
+
+	rem = 1;
+
+	for (a=0; a<n; a++) rem = ( rem >> 63 ) ? ( rem << 1 ) ^ poly : rem << 1;
+
+	return rem;
+
+}  /* xpow_mod */
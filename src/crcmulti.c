@@ -0,0 +1,97 @@
+/*
+ * Library: libcrc
+ * File:    src/crcmulti.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2026 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crcmulti.c contains the routine crc_multi() which
+ * calculates several CRC algorithms over the same data in one pass. The data
+ * is processed in blocks which fit in the level 1 data cache. Each block is
+ * passed to the bulk routine of every requested algorithm before the next
+ * block is read, so the data is loaded from memory only once.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "checksum.h"
+#include "crcint.h"
+
+/*
+ * #define CRC_MULTI_BLOCK		8192
+ *
+ * The number of bytes which crc_multi() passes to each algorithm before it
+ * continues with the next block. The block must stay in the level 1 data
+ * cache together with the lookup tables of the table driven routines, but it
+ * must be long enough to use the folding kernels at full speed.
+ */
+
+#define CRC_MULTI_BLOCK		8192
+
+/*
+ * bool crc_multi( const unsigned char *input_str, size_t num_bytes, uint32_t algo_mask, uint64_t results[CRC_ALGO_NUM] );
+ *
+ * The function crc_multi() calculates the CRC of a buffer for every algorithm
+ * selected in algo_mask with CRC_ALGO_MASK(). The value of each algorithm is
+ * stored in the results array at the index of the algorithm. Elements of
+ * algorithms which are not selected are not changed. The function returns
+ * false if results is NULL or the mask selects an unknown algorithm.
+ */
+
+bool crc_multi( const unsigned char *input_str, size_t num_bytes, uint32_t algo_mask, uint64_t results[CRC_ALGO_NUM] ) {
+
+	int algo;
+	int a;
+	int num_algo;
+	size_t pos;
+	size_t len;
+	struct crc_ctx ctx[CRC_ALGO_NUM];
+
+	if ( results == NULL  ||  ( algo_mask & ~CRC_ALGO_ALL ) != 0 ) return false;
+
+	num_algo = 0;
+
+	for (algo=0; algo<CRC_ALGO_NUM; algo++) {
+
+		if ( algo_mask & CRC_ALGO_MASK( algo ) ) crc_init( & ctx[num_algo++], (enum crc_algo) algo );
+	}
+
+	if ( input_str == NULL ) num_bytes = 0;
+
+	if ( num_algo == 1 ) crc_update( & ctx[0], input_str, num_bytes );
+
+	else for (pos=0; pos<num_bytes; pos+=len) {
+
+		len = ( num_bytes - pos < CRC_MULTI_BLOCK ) ? num_bytes - pos : CRC_MULTI_BLOCK;
+
+		for (a=0; a<num_algo; a++) crc_update( & ctx[a], input_str + pos, len );
+	}
+
+	for (a=0; a<num_algo; a++) results[ctx[a].algo] = crc_final( & ctx[a] );
+
+	return true;
+
+}  /* crc_multi */
@@ -0,0 +1,429 @@
+/*
+ * Library: libcrc
+ * File:    src/crcpar.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2026 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crcpar.c contains routines which calculate the CRC of
+ * one large buffer with more than one thread. The buffer is split in chunks
+ * of equal size. Each chunk is handled by a thread of a persistent worker
+ * pool with the fastest calculation routine available on the processor and
+ * the partial results are merged with the crc_xxx_combine() functions.
+ *
+ * The CRC calculation of a single core already runs at several gigabytes per
+ * second. Adding threads therefore only helps until the memory bandwidth of
+ * the system is saturated. The library does not measure the bandwidth. The
+ * number of threads is limited by a fixed maximum and by a minimum chunk
+ * size instead, which suit a typical server socket. Both can be changed with
+ * crc_parallel_tune() for systems where other limits work better.
+ *
+ * The worker pool is built on POSIX threads. When these are not available,
+ * the routines calculate the CRC in the calling thread.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "checksum.h"
+#include "crcint.h"
+
+#if ! defined(_WIN32)
+#define CRC_HAVE_PTHREAD
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+/*
+ * #define CRC_PARALLEL_xxxx
+ *
+ * The default minimum number of bytes each thread must process and the
+ * default maximum number of threads. Around eight cores running the folding
+ * kernels saturate the memory bandwidth of a typical server socket. This is
+ * a fixed rule of thumb, not a measurement of the actual system. Chunks
+ * are a multiple of CRC_PARALLEL_ALIGN bytes.
+ */
+
+#define CRC_PARALLEL_MIN_CHUNK		(1024*1024)
+#define CRC_PARALLEL_DEF_THREADS	8
+#define CRC_PARALLEL_ALIGN		4096
+
+/*
+ * struct crc_job_tp
+ *
+ * The structure crc_job_tp describes the calculation of the CRC of one chunk
+ * of the buffer by one of the threads.
+ */
+
+						/************************************************/
+struct crc_job_tp {				/*						*/
+	uint64_t	(*func)( const unsigned char *ptr, size_t num_bytes );	/* Calculation routine	*/
+	const unsigned char *ptr;		/* Start of the chunk				*/
+	size_t		num_bytes;		/* Number of bytes in the chunk			*/
+	uint64_t	crc;			/* Resulting CRC of the chunk			*/
+};						/*						*/
+						/************************************************/
+
+static void		run_jobs( struct crc_job_tp *jobs, int num_jobs );
+static uint64_t		job_crc_32(    const unsigned char *ptr, size_t num_bytes );
+static uint64_t		job_crc_64_we( const unsigned char *ptr, size_t num_bytes );
+
+static size_t		parallel_min_chunk   = CRC_PARALLEL_MIN_CHUNK;
+static int		parallel_max_threads = CRC_PARALLEL_DEF_THREADS;
+
+#if defined(CRC_HAVE_PTHREAD)
+static void *		pool_worker( void *arg );
+static void		pool_work(   bool worker );
+
+static pthread_mutex_t	pool_run	= PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t	pool_lock	= PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t	pool_start	= PTHREAD_COND_INITIALIZER;
+static pthread_cond_t	pool_done	= PTHREAD_COND_INITIALIZER;
+static int		pool_size;
+static unsigned long	pool_generation;
+static struct crc_job_tp *pool_jobs;
+static int		pool_num_jobs;
+static int		pool_next_job;
+static int		pool_pending;
+static unsigned long	pool_worker_jobs;
+#endif
+
+/*
+ * uint32_t crc_32_parallel( const unsigned char *input_str, size_t num_bytes, int num_threads );
+ *
+ * The function crc_32_parallel() calculates the 32 bit CRC value of a byte
+ * string with up to num_threads threads. A value of 0 for num_threads uses
+ * one thread for every online processor. The result is the same as the
+ * result of crc_32().
+ */
+
+uint32_t crc_32_parallel( const unsigned char *input_str, size_t num_bytes, int num_threads ) {
+
+	int a;
+	int num_jobs;
+	size_t chunk;
+	uint32_t crc;
+	struct crc_job_tp jobs[CRC_PARALLEL_MAX_THREADS];
+
+	num_jobs = crc_parallel_split( num_bytes, num_threads, & chunk );
+
+	if ( input_str == NULL  ||  num_jobs <= 1 ) return crc_32( input_str, num_bytes );
+
+	for (a=0; a<num_jobs; a++) {
+
+		jobs[a].func      = job_crc_32;
+		jobs[a].ptr       = input_str + a * chunk;
+		jobs[a].num_bytes = ( a < num_jobs-1 ) ? chunk : num_bytes - a * chunk;
+	}
+
+	run_jobs( jobs, num_jobs );
+
+	crc = (uint32_t) jobs[0].crc;
+	for (a=1; a<num_jobs; a++) crc = crc_32_combine( crc, (uint32_t) jobs[a].crc, jobs[a].num_bytes );
+
+	return crc;
+
+}  /* crc_32_parallel */
+
+/*
+ * uint64_t crc_64_we_parallel( const unsigned char *input_str, size_t num_bytes, int num_threads );
+ *
+ * The function crc_64_we_parallel() calculates the CRC-64 WE value of a byte
+ * string with up to num_threads threads. A value of 0 for num_threads uses
+ * one thread for every online processor. The result is the same as the
+ * result of crc_64_we().
+ */
+
+uint64_t crc_64_we_parallel( const unsigned char *input_str, size_t num_bytes, int num_threads ) {
+
+	int a;
+	int num_jobs;
+	size_t chunk;
+	uint64_t crc;
+	struct crc_job_tp jobs[CRC_PARALLEL_MAX_THREADS];
+
+	num_jobs = crc_parallel_split( num_bytes, num_threads, & chunk );
+
+	if ( input_str == NULL  ||  num_jobs <= 1 ) return crc_64_we( input_str, num_bytes );
+
+	for (a=0; a<num_jobs; a++) {
+
+		jobs[a].func      = job_crc_64_we;
+		jobs[a].ptr       = input_str + a * chunk;
+		jobs[a].num_bytes = ( a < num_jobs-1 ) ? chunk : num_bytes - a * chunk;
+	}
+
+	run_jobs( jobs, num_jobs );
+
+	crc = jobs[0].crc;
+	for (a=1; a<num_jobs; a++) crc = crc_64_we_combine( crc, jobs[a].crc, jobs[a].num_bytes );
+
+	return crc;
+
+}  /* crc_64_we_parallel */
+
+/*
+ * int crc_parallel_split( size_t num_bytes, int num_threads, size_t *chunk_bytes );
+ *
+ * The function crc_parallel_split() returns the number of threads that the
+ * parallel CRC routines use for a buffer of num_bytes bytes when at most
+ * num_threads threads are requested. When chunk_bytes is not NULL, the size
+ * of every chunk except the last one is stored there.
+ */
+
+int crc_parallel_split( size_t num_bytes, int num_threads, size_t *chunk_bytes ) {
+
+	int num_jobs;
+	size_t chunk;
+	size_t max_jobs;
+
+	if ( num_threads <= 0 ) {
+
+#if defined(CRC_HAVE_PTHREAD) && defined(_SC_NPROCESSORS_ONLN)
+		num_threads = (int) sysconf( _SC_NPROCESSORS_ONLN );
+#endif
+		if ( num_threads <= 0 ) num_threads = 1;
+	}
+
+#if ! defined(CRC_HAVE_PTHREAD)
+	num_threads = 1;
+#endif
+
+	if ( num_threads > parallel_max_threads   ) num_threads = parallel_max_threads;
+	if ( num_threads > CRC_PARALLEL_MAX_THREADS ) num_threads = CRC_PARALLEL_MAX_THREADS;
+
+	max_jobs = num_bytes / parallel_min_chunk;
+	if ( max_jobs < (size_t) num_threads ) num_threads = ( max_jobs > 0 ) ? (int) max_jobs : 1;
+
+	chunk = ( num_bytes + (size_t) num_threads - 1 ) / (size_t) num_threads;
+	chunk = ( chunk + CRC_PARALLEL_ALIGN - 1 ) & ~( (size_t) CRC_PARALLEL_ALIGN - 1 );
+
+	if ( chunk == 0 ) chunk = CRC_PARALLEL_ALIGN;
+
+	num_jobs = (int) ( ( num_bytes + chunk - 1 ) / chunk );
+	if ( num_jobs < 1 ) num_jobs = 1;
+
+	if ( chunk_bytes != NULL ) *chunk_bytes = ( num_jobs > 1 ) ? chunk : num_bytes;
+
+	return num_jobs;
+
+}  /* crc_parallel_split */
+
+/*
+ * void crc_parallel_tune( size_t min_chunk, int max_threads );
+ *
+ * The function crc_parallel_tune() sets the minimum number of bytes that
+ * each thread must process and the maximum number of threads used by the
+ * parallel CRC routines. A value of 0 restores the default of a parameter.
+ * The function should not be called while a parallel calculation runs.
+ */
+
+void crc_parallel_tune( size_t min_chunk, int max_threads ) {
+
+	if ( min_chunk == 0 ) min_chunk = CRC_PARALLEL_MIN_CHUNK;
+	if ( min_chunk < CRC_PARALLEL_ALIGN ) min_chunk = CRC_PARALLEL_ALIGN;
+
+	if ( max_threads <= 0                       ) max_threads = CRC_PARALLEL_DEF_THREADS;
+	if ( max_threads > CRC_PARALLEL_MAX_THREADS ) max_threads = CRC_PARALLEL_MAX_THREADS;
+
+	parallel_min_chunk   = min_chunk;
+	parallel_max_threads = max_threads;
+
+}  /* crc_parallel_tune */
+
+/*
+ * unsigned long crc_parallel_worker_jobs( void );
+ *
+ * The function crc_parallel_worker_jobs() returns the number of chunks which
+ * were calculated by the threads of the worker pool, rather than by the
+ * thread which called a parallel CRC routine, since the program started. It
+ * is an internal diagnostic which the test program uses to check that a
+ * calculation was really spread over threads.
+ */
+
+unsigned long crc_parallel_worker_jobs( void ) {
+
+#if defined(CRC_HAVE_PTHREAD)
+	unsigned long num_jobs;
+
+	pthread_mutex_lock( & pool_lock );
+	num_jobs = pool_worker_jobs;
+	pthread_mutex_unlock( & pool_lock );
+
+	return num_jobs;
+#else
+	return 0;
+#endif
+
+}  /* crc_parallel_worker_jobs */
+
+/*
+ * static void run_jobs( struct crc_job_tp *jobs, int num_jobs );
+ *
+ * The function run_jobs() calculates the CRC of all jobs. The calling thread
+ * takes part in the calculation and the function returns when all jobs have
+ * finished. Threads are added to the pool when needed and stay alive for
+ * later calls. When a thread cannot be created, the remaining threads take
+ * over its work.
+ */
+
+static void run_jobs( struct crc_job_tp *jobs, int num_jobs ) {
+
+#if defined(CRC_HAVE_PTHREAD)
+
+	pthread_t thread;
+
+	pthread_mutex_lock( & pool_run );
+	pthread_mutex_lock( & pool_lock );
+
+	/*
+	 * New threads are told which generation is about to start. They may
+	 * only get pool_lock after the jobs have been published, and must then
+	 * still take part in this set of jobs.
+	 */
+
+	while ( pool_size < num_jobs-1 ) {
+
+		if ( pthread_create( & thread, NULL, pool_worker, (void *) (uintptr_t) ( pool_generation + 1 ) ) != 0 ) break;
+
+		pthread_detach( thread );
+		pool_size++;
+	}
+
+	pool_jobs     = jobs;
+	pool_num_jobs = num_jobs;
+	pool_next_job = 0;
+	pool_pending  = num_jobs;
+	pool_generation++;
+
+	pthread_cond_broadcast( & pool_start );
+
+	pool_work( false );
+
+	while ( pool_pending > 0 ) pthread_cond_wait( & pool_done, & pool_lock );
+
+	pool_jobs     = NULL;
+	pool_num_jobs = 0;
+
+	pthread_mutex_unlock( & pool_lock );
+	pthread_mutex_unlock( & pool_run );
+
+#else
+
+	int a;
+
+	for (a=0; a<num_jobs; a++) jobs[a].crc = jobs[a].func( jobs[a].ptr, jobs[a].num_bytes );
+
+#endif
+
+}  /* run_jobs */
+
+#if defined(CRC_HAVE_PTHREAD)
+
+/*
+ * static void *pool_worker( void *arg );
+ *
+ * The function pool_worker() is the main loop of a thread in the worker
+ * pool. The thread sleeps until a new set of jobs is started and then takes
+ * part in the calculation. The argument is the generation which was started
+ * when the thread was created, which the thread joins first.
+ */
+
+static void *pool_worker( void *arg ) {
+
+	unsigned long generation;
+
+	pthread_mutex_lock( & pool_lock );
+
+	generation = (unsigned long) (uintptr_t) arg - 1;
+
+	for (;;) {
+
+		while ( generation == pool_generation ) pthread_cond_wait( & pool_start, & pool_lock );
+
+		generation = pool_generation;
+
+		pool_work( true );
+	}
+
+	return NULL;
+
+}  /* pool_worker */
+
+/*
+ * static void pool_work( bool worker );
+ *
+ * The function pool_work() takes jobs from the pool until no jobs are left.
+ * It is called with pool_lock locked, but releases the lock while the CRC of
+ * a chunk is calculated. The parameter worker is true when the function is
+ * called by a thread of the pool instead of the calling thread. The calling
+ * thread leaves one job for every thread in the pool, so that the work is
+ * spread even when the pool threads are slow to wake up. It only takes over
+ * the jobs of threads which could not be created.
+ */
+
+static void pool_work( bool worker ) {
+
+	int limit;
+	struct crc_job_tp *job;
+
+	limit = pool_num_jobs;
+	if ( ! worker ) limit -= ( pool_size < pool_num_jobs-1 ) ? pool_size : pool_num_jobs-1;
+
+	while ( pool_next_job < limit ) {
+
+		job = pool_jobs + pool_next_job++;
+
+		pthread_mutex_unlock( & pool_lock );
+		job->crc = job->func( job->ptr, job->num_bytes );
+		pthread_mutex_lock( & pool_lock );
+
+		if ( worker ) pool_worker_jobs++;
+		if ( --pool_pending == 0 ) pthread_cond_signal( & pool_done );
+	}
+
+}  /* pool_work */
+
+#endif
+
+/*
+ * static uint64_t job_crc_32( const unsigned char *ptr, size_t num_bytes );
+ * static uint64_t job_crc_64_we( const unsigned char *ptr, size_t num_bytes );
+ *
+ * The functions job_crc_32() and job_crc_64_we() calculate the CRC of one
+ * chunk for the worker pool.
+ */
+
+static uint64_t job_crc_32( const unsigned char *ptr, size_t num_bytes ) {
+
+	return crc_32( ptr, num_bytes );
+
+}  /* job_crc_32 */
+
+static uint64_t job_crc_64_we( const unsigned char *ptr, size_t num_bytes ) {
+
+	return crc_64_we( ptr, num_bytes );
+
+}  /* job_crc_64_we */
@@ -34,6 +34,13 @@
 
 #include <stdlib.h>
 #include "checksum.h"
+#include "crcint.h"
+
+/*
+ * Include the lookup tables for the Sick calculation
+ */
+
+#include "../tab/gentabsk.inc"
 
 /*
  * uint16_t crc_sick( const unsigned char *input_str, size_t num_bytes );
@@ -47,35 +54,76 @@ uint16_t crc_sick( const unsigned char *input_str, size_t num_bytes ) {
 	uint16_t crc;
 	uint16_t low_byte;
 	uint16_t high_byte;
+
+	crc = CRC_START_SICK;
+
+	if ( input_str != NULL ) crc = crc_sick_block( crc, 0, input_str, num_bytes );
+
+	low_byte  = (crc & 0xFF00) >> 8;
+	high_byte = (crc & 0x00FF) << 8;
+	crc       = low_byte | high_byte;
+
+	return crc;
+
+}  /* crc_sick */
+
+/*
+ * uint16_t crc_sick_block( uint16_t crc, unsigned char prev_byte, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function crc_sick_block() updates a Sick register with the contents of
+ * a byte buffer. The byte which preceded the buffer in the data stream must be
+ * passed in prev_byte, or 0 at the start of the stream. The byte swap of the
+ * final Sick CRC value is not applied.
+ *
+ * Eight bytes are processed per iteration. The register is moved forward over
+ * the eight bytes with the ordinary byte lookup table, because the Sick
+ * algorithm shifts it only one bit per byte. The contributions of the eight
+ * bytes and of the last byte of the previous block are taken from the byte
+ * pair tables generated by precalc. The trailing bytes are processed one at a
+ * time.
+ */
+
+uint16_t crc_sick_block( uint16_t crc, unsigned char prev_byte, const unsigned char *ptr, size_t num_bytes ) {
+
 	uint16_t short_c;
 	uint16_t short_p;
-	const unsigned char *ptr;
-	size_t a;
+	const unsigned char *end;
+
+	while ( num_bytes >= 8 ) {
+
+		crc = (uint16_t) ( crc << 8 ) ^ crc_tabsick[ crc >> 8 ]
+		    ^ crc_tabsick_pair[0][ prev_byte ]
+		    ^ crc_tabsick_pair[1][ ptr[0]    ]
+		    ^ crc_tabsick_pair[2][ ptr[1]    ]
+		    ^ crc_tabsick_pair[3][ ptr[2]    ]
+		    ^ crc_tabsick_pair[4][ ptr[3]    ]
+		    ^ crc_tabsick_pair[5][ ptr[4]    ]
+		    ^ crc_tabsick_pair[6][ ptr[5]    ]
+		    ^ crc_tabsick_pair[7][ ptr[6]    ]
+		    ^ (uint16_t) ptr[7];
+
+		prev_byte  = ptr[7];
+		ptr       += 8;
+		num_bytes -= 8;
+	}
 
-	crc     = CRC_START_SICK;
-	ptr     = input_str;
-	short_p = 0;
+	short_p = ( 0x00FF & (uint16_t) prev_byte ) << 8;
+	end     = ptr + num_bytes;
 
-	if ( ptr != NULL ) for (a=0; a<num_bytes; a++) {
+	while ( ptr < end ) {
 
-		short_c = 0x00FF & (uint16_t) *ptr;
+		short_c = 0x00FF & (uint16_t) *ptr++;
 
 		if ( crc & 0x8000 ) crc = ( crc << 1 ) ^ CRC_POLY_SICK;
 		else                crc =   crc << 1;
 
 		crc    ^= ( short_c | short_p );
 		short_p = short_c << 8;
-
-		ptr++;
 	}
 
-	low_byte  = (crc & 0xFF00) >> 8;
-	high_byte = (crc & 0x00FF) << 8;
-	crc       = low_byte | high_byte;
-
 	return crc;
 
-}  /* crc_sick */
+}  /* crc_sick_block */
 
 /*
  * uint16_t update_crc_sick( uint16_t crc, unsigned char c, unsigned char prev_byte );
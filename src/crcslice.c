@@ -0,0 +1,618 @@
+/*
+ * Library: libcrc
+ * File:    src/crcslice.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2026 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crcslice.c contains the slicing-by-8 kernels which are
+ * shared by several CRC algorithms of the same width. The
+ * lookup tables are passed as a parameter, which lets one kernel serve all
+ * algorithms of a family. Long buffers are folded with carry-less
+ * multiplication when the processor supports it. The kernels are chosen by
+ * the dispatch layer in src/crcdisp.c, which can also force the plain
+ * byte-at-a-time loops.
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include "checksum.h"
+#include "crcint.h"
+
+static uint8_t		crc_8_slice8(      uint8_t  crc, const unsigned char *ptr, size_t num_bytes, const uint8_t  tab[8][256] );
+static uint16_t		crc_16_lsb_step8(  uint16_t crc, const unsigned char *ptr,                   const uint16_t tab[8][256] );
+static uint16_t		crc_16_lsb_slice8( uint16_t crc, const unsigned char *ptr, size_t num_bytes, const uint16_t tab[8][256] );
+static uint16_t		crc_16_msb_slice8( uint16_t crc, const unsigned char *ptr, size_t num_bytes, const uint16_t tab[8][256] );
+static uint64_t		crc_64_lsb_slice8( uint64_t crc, const unsigned char *ptr, size_t num_bytes, const uint64_t tab[8][256] );
+static uint64_t		crc_64_msb_slice8( uint64_t crc, const unsigned char *ptr, size_t num_bytes, const uint64_t tab[8][256] );
+
+/*
+ * uint8_t crc_8_lsb_update( uint8_t crc, const unsigned char *ptr, size_t num_bytes, const uint8_t tab[8][256], const struct crc_fold_tp *fold );
+ *
+ * The function crc_8_lsb_update() updates the register of a reflected 8 bit
+ * CRC with the contents of a byte buffer. Long buffers are folded with
+ * carry-less multiplication when the processor supports it. The 128 bit
+ * remainder of the folding kernel and the remaining bytes are then processed
+ * with slicing-by-8.
+ */
+
+uint8_t crc_8_lsb_update( uint8_t crc, const unsigned char *ptr, size_t num_bytes, const uint8_t tab[8][256], const struct crc_fold_tp *fold ) {
+
+	const struct crc_dispatch_tp *disp;
+#if defined(LIBCRC_X86_64)
+	size_t num_fold;
+	unsigned char remainder[16];
+#endif
+
+	disp = crc_dispatch();
+
+#if defined(LIBCRC_X86_64)
+	if ( num_bytes >= disp->clmul_min_8 ) {
+
+		num_fold = num_bytes & ~( (size_t) 0x0F );
+
+		crc_fold_lsb( ptr, num_fold, crc, fold, remainder );
+
+		crc        = crc_8_slice8( 0, remainder, 16, tab );
+		ptr       += num_fold;
+		num_bytes -= num_fold;
+	}
+#else
+	(void) fold;
+#endif
+
+	if ( disp->slice8 ) return crc_8_slice8( crc, ptr, num_bytes, tab );
+
+	while ( num_bytes-- > 0 ) crc = tab[0][ crc ^ *ptr++ ];
+
+	return crc;
+
+}  /* crc_8_lsb_update */
+
+/*
+ * uint8_t crc_8_msb_update( uint8_t crc, const unsigned char *ptr, size_t num_bytes, const uint8_t tab[8][256], const struct crc_fold_tp *fold );
+ *
+ * The function crc_8_msb_update() updates the register of a non reflected 8
+ * bit CRC with the contents of a byte buffer. It is used for the CRC-8 of the
+ * SHT75 sensors and the other common non reflected 8 bit CRCs. Long buffers
+ * are folded with carry-less multiplication when the processor supports it,
+ * the register value is then shifted to the top of the first 64 bit word.
+ */
+
+uint8_t crc_8_msb_update( uint8_t crc, const unsigned char *ptr, size_t num_bytes, const uint8_t tab[8][256], const struct crc_fold_tp *fold ) {
+
+	const struct crc_dispatch_tp *disp;
+#if defined(LIBCRC_X86_64)
+	size_t num_fold;
+	unsigned char remainder[16];
+#endif
+
+	disp = crc_dispatch();
+
+#if defined(LIBCRC_X86_64)
+	if ( num_bytes >= disp->clmul_min_8 ) {
+
+		num_fold = num_bytes & ~( (size_t) 0x0F );
+
+		crc_fold_msb( ptr, num_fold, (uint64_t) crc << 56, fold, remainder );
+
+		crc        = crc_8_slice8( 0, remainder, 16, tab );
+		ptr       += num_fold;
+		num_bytes -= num_fold;
+	}
+#else
+	(void) fold;
+#endif
+
+	if ( disp->slice8 ) return crc_8_slice8( crc, ptr, num_bytes, tab );
+
+	while ( num_bytes-- > 0 ) crc = tab[0][ crc ^ *ptr++ ];
+
+	return crc;
+
+}  /* crc_8_msb_update */
+
+/*
+ * uint16_t crc_16_lsb_update( uint16_t crc, const unsigned char *ptr, size_t num_bytes, const uint16_t tab[8][256], const struct crc_fold_tp *fold );
+ *
+ * The function crc_16_lsb_update() updates the register of a reflected 16 bit
+ * CRC with the contents of a byte buffer. It is used for the CRC16, Modbus,
+ * DNP and Kermit calculations. Long buffers are folded with carry-less
+ * multiplication when the processor supports it. The 128 bit remainder of the
+ * folding kernel and the remaining bytes are then processed with
+ * slicing-by-8.
+ */
+
+uint16_t crc_16_lsb_update( uint16_t crc, const unsigned char *ptr, size_t num_bytes, const uint16_t tab[8][256], const struct crc_fold_tp *fold ) {
+
+	const struct crc_dispatch_tp *disp;
+#if defined(LIBCRC_X86_64)
+	size_t num_fold;
+	unsigned char remainder[16];
+#endif
+
+	disp = crc_dispatch();
+
+#if defined(LIBCRC_X86_64)
+	if ( num_bytes >= disp->clmul_min_16 ) {
+
+		num_fold = num_bytes & ~( (size_t) 0x0F );
+
+		crc_fold_lsb( ptr, num_fold, crc, fold, remainder );
+
+		crc        = crc_16_lsb_slice8( 0, remainder, 16, tab );
+		ptr       += num_fold;
+		num_bytes -= num_fold;
+	}
+#else
+	(void) fold;
+#endif
+
+	if ( disp->slice8 ) return crc_16_lsb_slice8( crc, ptr, num_bytes, tab );
+
+	while ( num_bytes-- > 0 ) crc = (crc >> 8) ^ tab[0][ (crc ^ (uint16_t) *ptr++) & 0x00FF ];
+
+	return crc;
+
+}  /* crc_16_lsb_update */
+
+/*
+ * uint16_t crc_16_msb_update( uint16_t crc, const unsigned char *ptr, size_t num_bytes, const uint16_t tab[8][256], const struct crc_fold_tp *fold );
+ *
+ * The function crc_16_msb_update() updates the register of a non reflected 16
+ * bit CRC with the contents of a byte buffer. It is used for the XModem and
+ * CCITT calculations. Long buffers are folded with carry-less multiplication
+ * when the processor supports it, the register value is then shifted to the
+ * top of the first 64 bit word. The remainder and the remaining bytes are
+ * processed with slicing-by-8.
+ */
+
+uint16_t crc_16_msb_update( uint16_t crc, const unsigned char *ptr, size_t num_bytes, const uint16_t tab[8][256], const struct crc_fold_tp *fold ) {
+
+	const struct crc_dispatch_tp *disp;
+#if defined(LIBCRC_X86_64)
+	size_t num_fold;
+	unsigned char remainder[16];
+#endif
+
+	disp = crc_dispatch();
+
+#if defined(LIBCRC_X86_64)
+	if ( num_bytes >= disp->clmul_min_16 ) {
+
+		num_fold = num_bytes & ~( (size_t) 0x0F );
+
+		crc_fold_msb( ptr, num_fold, (uint64_t) crc << 48, fold, remainder );
+
+		crc        = crc_16_msb_slice8( 0, remainder, 16, tab );
+		ptr       += num_fold;
+		num_bytes -= num_fold;
+	}
+#else
+	(void) fold;
+#endif
+
+	if ( disp->slice8 ) return crc_16_msb_slice8( crc, ptr, num_bytes, tab );
+
+	while ( num_bytes-- > 0 ) crc = (uint16_t) (crc << 8) ^ tab[0][ ((crc >> 8) ^ (uint16_t) *ptr++) & 0x00FF ];
+
+	return crc;
+
+}  /* crc_16_msb_update */
+
+/*
+ * uint64_t crc_64_lsb_update( uint64_t crc, const unsigned char *ptr, size_t num_bytes, const uint64_t tab[8][256], const struct crc_fold_tp *fold );
+ *
+ * The function crc_64_lsb_update() updates a reflected CRC register of up to
+ * 64 bits with the contents of a byte buffer. Narrower registers occupy the
+ * low bits of the value. The tables and folding constants are built at run
+ * time by the parameterised engine in src/crcmodel.c.
+ */
+
+uint64_t crc_64_lsb_update( uint64_t crc, const unsigned char *ptr, size_t num_bytes, const uint64_t tab[8][256], const struct crc_fold_tp *fold ) {
+
+	const struct crc_dispatch_tp *disp;
+#if defined(LIBCRC_X86_64)
+	size_t num_fold;
+	unsigned char remainder[16];
+#endif
+
+	disp = crc_dispatch();
+
+#if defined(LIBCRC_X86_64)
+	if ( num_bytes >= disp->clmul_min_64 ) {
+
+		num_fold = num_bytes & ~( (size_t) 0x0F );
+
+		crc_fold_lsb( ptr, num_fold, crc, fold, remainder );
+
+		crc        = crc_64_lsb_slice8( 0, remainder, 16, tab );
+		ptr       += num_fold;
+		num_bytes -= num_fold;
+	}
+#else
+	(void) fold;
+#endif
+
+	if ( disp->slice8 ) return crc_64_lsb_slice8( crc, ptr, num_bytes, tab );
+
+	while ( num_bytes-- > 0 ) crc = (crc >> 8) ^ tab[0][ (crc ^ (uint64_t) *ptr++) & 0xFF ];
+
+	return crc;
+
+}  /* crc_64_lsb_update */
+
+/*
+ * uint64_t crc_64_msb_update( uint64_t crc, const unsigned char *ptr, size_t num_bytes, const uint64_t tab[8][256], const struct crc_fold_tp *fold );
+ *
+ * The function crc_64_msb_update() is the non reflected counterpart of
+ * crc_64_lsb_update(). A register narrower than 64 bits is kept in the top
+ * bits of the value, so the same shifts and folding kernel serve every width.
+ */
+
+uint64_t crc_64_msb_update( uint64_t crc, const unsigned char *ptr, size_t num_bytes, const uint64_t tab[8][256], const struct crc_fold_tp *fold ) {
+
+	const struct crc_dispatch_tp *disp;
+#if defined(LIBCRC_X86_64)
+	size_t num_fold;
+	unsigned char remainder[16];
+#endif
+
+	disp = crc_dispatch();
+
+#if defined(LIBCRC_X86_64)
+	if ( num_bytes >= disp->clmul_min_64 ) {
+
+		num_fold = num_bytes & ~( (size_t) 0x0F );
+
+		crc_fold_msb( ptr, num_fold, crc, fold, remainder );
+
+		crc        = crc_64_msb_slice8( 0, remainder, 16, tab );
+		ptr       += num_fold;
+		num_bytes -= num_fold;
+	}
+#else
+	(void) fold;
+#endif
+
+	if ( disp->slice8 ) return crc_64_msb_slice8( crc, ptr, num_bytes, tab );
+
+	while ( num_bytes-- > 0 ) crc = (crc << 8) ^ tab[0][ ((crc >> 56) ^ (uint64_t) *ptr++) & 0xFF ];
+
+	return crc;
+
+}  /* crc_64_msb_update */
+
+/*
+ * void crc_16_lsb_lanes( uint64_t crc[CRC_BATCH_LANES], const unsigned char *ptr[CRC_BATCH_LANES], size_t num_bytes, const uint16_t tab[8][256] );
+ *
+ * The function crc_16_lsb_lanes() updates the registers of a reflected 16
+ * bit CRC for four independent buffers with the same number of bytes of each
+ * buffer. It is used by the batch routines. The slicing-by-8 calculations of
+ * the buffers are interleaved, which lets the processor overlap the table
+ * lookups of the four dependency chains. The pointers are advanced past the
+ * processed bytes.
+ */
+
+void crc_16_lsb_lanes( uint64_t crc[CRC_BATCH_LANES], const unsigned char *ptr[CRC_BATCH_LANES], size_t num_bytes, const uint16_t tab[8][256] ) {
+
+	uint16_t crc0;
+	uint16_t crc1;
+	uint16_t crc2;
+	uint16_t crc3;
+	const unsigned char *ptr0;
+	const unsigned char *ptr1;
+	const unsigned char *ptr2;
+	const unsigned char *ptr3;
+
+	crc0 = (uint16_t) crc[0];
+	crc1 = (uint16_t) crc[1];
+	crc2 = (uint16_t) crc[2];
+	crc3 = (uint16_t) crc[3];
+	ptr0 = ptr[0];
+	ptr1 = ptr[1];
+	ptr2 = ptr[2];
+	ptr3 = ptr[3];
+
+	while ( num_bytes >= 8 ) {
+
+		crc0 = crc_16_lsb_step8( crc0, ptr0, tab );
+		crc1 = crc_16_lsb_step8( crc1, ptr1, tab );
+		crc2 = crc_16_lsb_step8( crc2, ptr2, tab );
+		crc3 = crc_16_lsb_step8( crc3, ptr3, tab );
+
+		ptr0      += 8;
+		ptr1      += 8;
+		ptr2      += 8;
+		ptr3      += 8;
+		num_bytes -= 8;
+	}
+
+	while ( num_bytes > 0 ) {
+
+		crc0 = (crc0 >> 8) ^ tab[0][ (crc0 ^ (uint16_t) *ptr0++) & 0x00FF ];
+		crc1 = (crc1 >> 8) ^ tab[0][ (crc1 ^ (uint16_t) *ptr1++) & 0x00FF ];
+		crc2 = (crc2 >> 8) ^ tab[0][ (crc2 ^ (uint16_t) *ptr2++) & 0x00FF ];
+		crc3 = (crc3 >> 8) ^ tab[0][ (crc3 ^ (uint16_t) *ptr3++) & 0x00FF ];
+		num_bytes--;
+	}
+
+	crc[0] = crc0;
+	crc[1] = crc1;
+	crc[2] = crc2;
+	crc[3] = crc3;
+	ptr[0] = ptr0;
+	ptr[1] = ptr1;
+	ptr[2] = ptr2;
+	ptr[3] = ptr3;
+
+}  /* crc_16_lsb_lanes */
+
+/*
+ * static uint16_t crc_16_lsb_slice8( uint16_t crc, const unsigned char *ptr, size_t num_bytes, const uint16_t tab[8][256] );
+ *
+ * The function crc_16_lsb_slice8() updates the register of a reflected 16 bit
+ * CRC with the contents of a byte buffer using the slicing-by-8 algorithm. It
+ * is used for the CRC16, Modbus, DNP and Kermit calculations. The tables are
+ * generated by precalc, where tab[0] is the ordinary byte lookup table and
+ * tab[n] the contribution of a byte followed by n other bytes. Only the bytes
+ * before the first 8 byte boundary and the trailing bytes are processed one
+ * at a time. Because the register is only 16 bits wide, it affects only the
+ * first two bytes of each 8 byte word.
+ */
+
+static uint16_t crc_16_lsb_slice8( uint16_t crc, const unsigned char *ptr, size_t num_bytes, const uint16_t tab[8][256] ) {
+
+	while ( num_bytes > 0  &&  ( (uintptr_t) ptr & 0x07 ) != 0 ) {
+
+		crc = (crc >> 8) ^ tab[0][ (crc ^ (uint16_t) *ptr++) & 0x00FF ];
+		num_bytes--;
+	}
+
+	while ( num_bytes >= 8 ) {
+
+		crc        = crc_16_lsb_step8( crc, ptr, tab );
+		ptr       += 8;
+		num_bytes -= 8;
+	}
+
+	while ( num_bytes > 0 ) {
+
+		crc = (crc >> 8) ^ tab[0][ (crc ^ (uint16_t) *ptr++) & 0x00FF ];
+		num_bytes--;
+	}
+
+	return crc;
+
+}  /* crc_16_lsb_slice8 */
+
+/*
+ * static uint16_t crc_16_lsb_step8( uint16_t crc, const unsigned char *ptr, const uint16_t tab[8][256] );
+ *
+ * The function crc_16_lsb_step8() processes one 8 byte word of a reflected 16
+ * bit CRC with the slicing-by-8 algorithm and returns the new register value.
+ */
+
+static uint16_t crc_16_lsb_step8( uint16_t crc, const unsigned char *ptr, const uint16_t tab[8][256] ) {
+
+	uint32_t low;
+	uint32_t high;
+
+	low  = crc ^ ( (uint32_t) ptr[0] | ( (uint32_t) ptr[1] << 8 ) | ( (uint32_t) ptr[2] << 16 ) | ( (uint32_t) ptr[3] << 24 ) );
+	high =         (uint32_t) ptr[4] | ( (uint32_t) ptr[5] << 8 ) | ( (uint32_t) ptr[6] << 16 ) | ( (uint32_t) ptr[7] << 24 );
+
+	return tab[7][  low         & 0xFF ]
+	     ^ tab[6][ (low  >>  8) & 0xFF ]
+	     ^ tab[5][ (low  >> 16) & 0xFF ]
+	     ^ tab[4][  low  >> 24         ]
+	     ^ tab[3][  high        & 0xFF ]
+	     ^ tab[2][ (high >>  8) & 0xFF ]
+	     ^ tab[1][ (high >> 16) & 0xFF ]
+	     ^ tab[0][  high >> 24         ];
+
+}  /* crc_16_lsb_step8 */
+
+/*
+ * static uint16_t crc_16_msb_slice8( uint16_t crc, const unsigned char *ptr, size_t num_bytes, const uint16_t tab[8][256] );
+ *
+ * The function crc_16_msb_slice8() updates the register of a non reflected 16
+ * bit CRC with the contents of a byte buffer using the slicing-by-8
+ * algorithm. It is used for the XModem and CCITT calculations. The bytes are
+ * processed most significant bit first, which means that the register is
+ * combined with the first two bytes of each 8 byte word in big endian order.
+ * The bytes before the first 8 byte boundary and the trailing bytes are
+ * processed one at a time.
+ */
+
+static uint16_t crc_16_msb_slice8( uint16_t crc, const unsigned char *ptr, size_t num_bytes, const uint16_t tab[8][256] ) {
+
+	uint32_t high;
+	uint32_t low;
+
+	while ( num_bytes > 0  &&  ( (uintptr_t) ptr & 0x07 ) != 0 ) {
+
+		crc = (uint16_t) (crc << 8) ^ tab[0][ ((crc >> 8) ^ (uint16_t) *ptr++) & 0x00FF ];
+		num_bytes--;
+	}
+
+	while ( num_bytes >= 8 ) {
+
+		high = ( (uint32_t) crc << 16 ) ^ ( ( (uint32_t) ptr[0] << 24 ) | ( (uint32_t) ptr[1] << 16 ) | ( (uint32_t) ptr[2] << 8 ) | (uint32_t) ptr[3] );
+		low  =                              ( (uint32_t) ptr[4] << 24 ) | ( (uint32_t) ptr[5] << 16 ) | ( (uint32_t) ptr[6] << 8 ) | (uint32_t) ptr[7];
+
+		crc  = tab[7][  high >> 24         ]
+		     ^ tab[6][ (high >> 16) & 0xFF ]
+		     ^ tab[5][ (high >>  8) & 0xFF ]
+		     ^ tab[4][  high        & 0xFF ]
+		     ^ tab[3][  low  >> 24         ]
+		     ^ tab[2][ (low  >> 16) & 0xFF ]
+		     ^ tab[1][ (low  >>  8) & 0xFF ]
+		     ^ tab[0][  low         & 0xFF ];
+
+		ptr       += 8;
+		num_bytes -= 8;
+	}
+
+	while ( num_bytes > 0 ) {
+
+		crc = (uint16_t) (crc << 8) ^ tab[0][ ((crc >> 8) ^ (uint16_t) *ptr++) & 0x00FF ];
+		num_bytes--;
+	}
+
+	return crc;
+
+}  /* crc_16_msb_slice8 */
+
+/*
+ * static uint64_t crc_64_lsb_slice8( uint64_t crc, const unsigned char *ptr, size_t num_bytes, const uint64_t tab[8][256] );
+ *
+ * The function crc_64_lsb_slice8() updates a reflected register of up to 64
+ * bits with slicing-by-8. The eight bytes are combined in little endian order
+ * with the register, the first byte of the word therefore indexes table 7.
+ */
+
+static uint64_t crc_64_lsb_slice8( uint64_t crc, const unsigned char *ptr, size_t num_bytes, const uint64_t tab[8][256] ) {
+
+	while ( num_bytes > 0  &&  ( (uintptr_t) ptr & 0x07 ) != 0 ) {
+
+		crc = (crc >> 8) ^ tab[0][ (crc ^ (uint64_t) *ptr++) & 0xFF ];
+		num_bytes--;
+	}
+
+	while ( num_bytes >= 8 ) {
+
+		crc ^= ( (uint64_t) ptr[7] << 56 ) | ( (uint64_t) ptr[6] << 48 ) | ( (uint64_t) ptr[5] << 40 ) | ( (uint64_t) ptr[4] << 32 )
+		     | ( (uint64_t) ptr[3] << 24 ) | ( (uint64_t) ptr[2] << 16 ) | ( (uint64_t) ptr[1] <<  8 ) |   (uint64_t) ptr[0];
+
+		crc  = tab[7][  crc        & 0xFF ]
+		     ^ tab[6][ (crc >>  8) & 0xFF ]
+		     ^ tab[5][ (crc >> 16) & 0xFF ]
+		     ^ tab[4][ (crc >> 24) & 0xFF ]
+		     ^ tab[3][ (crc >> 32) & 0xFF ]
+		     ^ tab[2][ (crc >> 40) & 0xFF ]
+		     ^ tab[1][ (crc >> 48) & 0xFF ]
+		     ^ tab[0][  crc >> 56         ];
+
+		ptr       += 8;
+		num_bytes -= 8;
+	}
+
+	while ( num_bytes > 0 ) {
+
+		crc = (crc >> 8) ^ tab[0][ (crc ^ (uint64_t) *ptr++) & 0xFF ];
+		num_bytes--;
+	}
+
+	return crc;
+
+}  /* crc_64_lsb_slice8 */
+
+/*
+ * static uint64_t crc_64_msb_slice8( uint64_t crc, const unsigned char *ptr, size_t num_bytes, const uint64_t tab[8][256] );
+ *
+ * The function crc_64_msb_slice8() updates a non reflected register of up to
+ * 64 bits, aligned to the top of the value, with slicing-by-8. The eight
+ * bytes are combined in big endian order with the register.
+ */
+
+static uint64_t crc_64_msb_slice8( uint64_t crc, const unsigned char *ptr, size_t num_bytes, const uint64_t tab[8][256] ) {
+
+	while ( num_bytes > 0  &&  ( (uintptr_t) ptr & 0x07 ) != 0 ) {
+
+		crc = (crc << 8) ^ tab[0][ ((crc >> 56) ^ (uint64_t) *ptr++) & 0xFF ];
+		num_bytes--;
+	}
+
+	while ( num_bytes >= 8 ) {
+
+		crc ^= ( (uint64_t) ptr[0] << 56 ) | ( (uint64_t) ptr[1] << 48 ) | ( (uint64_t) ptr[2] << 40 ) | ( (uint64_t) ptr[3] << 32 )
+		     | ( (uint64_t) ptr[4] << 24 ) | ( (uint64_t) ptr[5] << 16 ) | ( (uint64_t) ptr[6] <<  8 ) |   (uint64_t) ptr[7];
+
+		crc  = tab[7][  crc >> 56         ]
+		     ^ tab[6][ (crc >> 48) & 0xFF ]
+		     ^ tab[5][ (crc >> 40) & 0xFF ]
+		     ^ tab[4][ (crc >> 32) & 0xFF ]
+		     ^ tab[3][ (crc >> 24) & 0xFF ]
+		     ^ tab[2][ (crc >> 16) & 0xFF ]
+		     ^ tab[1][ (crc >>  8) & 0xFF ]
+		     ^ tab[0][  crc        & 0xFF ];
+
+		ptr       += 8;
+		num_bytes -= 8;
+	}
+
+	while ( num_bytes > 0 ) {
+
+		crc = (crc << 8) ^ tab[0][ ((crc >> 56) ^ (uint64_t) *ptr++) & 0xFF ];
+		num_bytes--;
+	}
+
+	return crc;
+
+}  /* crc_64_msb_slice8 */
+
+/*
+ * static uint8_t crc_8_slice8( uint8_t crc, const unsigned char *ptr, size_t num_bytes, const uint8_t tab[8][256] );
+ *
+ * The function crc_8_slice8() updates the register of an 8 bit CRC with the
+ * contents of a byte buffer using the slicing-by-8 algorithm. Because the
+ * register is only one byte wide, it is combined with the first byte of each
+ * 8 byte word only. The calculation is therefore the same for reflected and
+ * non reflected CRCs, only the tables differ. The bytes before the first 8
+ * byte boundary and the trailing bytes are processed one at a time.
+ */
+
+static uint8_t crc_8_slice8( uint8_t crc, const unsigned char *ptr, size_t num_bytes, const uint8_t tab[8][256] ) {
+
+	while ( num_bytes > 0  &&  ( (uintptr_t) ptr & 0x07 ) != 0 ) {
+
+		crc = tab[0][ crc ^ *ptr++ ];
+		num_bytes--;
+	}
+
+	while ( num_bytes >= 8 ) {
+
+		crc = tab[7][ crc ^ ptr[0] ]
+		    ^ tab[6][       ptr[1] ]
+		    ^ tab[5][       ptr[2] ]
+		    ^ tab[4][       ptr[3] ]
+		    ^ tab[3][       ptr[4] ]
+		    ^ tab[2][       ptr[5] ]
+		    ^ tab[1][       ptr[6] ]
+		    ^ tab[0][       ptr[7] ];
+
+		ptr       += 8;
+		num_bytes -= 8;
+	}
+
+	while ( num_bytes > 0 ) {
+
+		crc = tab[0][ crc ^ *ptr++ ];
+		num_bytes--;
+	}
+
+	return crc;
+
+}  /* crc_8_slice8 */
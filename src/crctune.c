@@ -0,0 +1,394 @@
+/*
+ * Library: libcrc
+ * File:    src/crctune.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2026 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file src/crctune.c contains the auto-tuner of the library. The
+ * best calculation kernel depends on the length of the buffer and on the
+ * micro-architecture of the processor. The auto-tuner measures for each CRC
+ * width from which buffer length on the carry-less multiplication kernels
+ * are faster than slicing-by-8 and stores these crossover points in the
+ * dispatch table. The results can be kept in a small cache file, which lets
+ * later processes on the same machine start tuned without measuring again.
+ */
+
+#if ! defined(_WIN32)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "checksum.h"
+#include "crcint.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+/*
+ * #define CRC_TUNE_xxxx
+ *
+ * CRC_TUNE_MAGIC is the first line of a cache file and changes when the
+ * format or the meaning of the results changes. CRC_TUNE_MIN_FOLD is the
+ * shortest buffer which the folding kernels accept. Every measurement
+ * processes at least CRC_TUNE_BYTES bytes and the fastest of CRC_TUNE_RUNS
+ * runs is used, which keeps a complete tuning run well below 100 ms.
+ */
+
+#define CRC_TUNE_MAGIC		"libcrc-autotune 1"
+#define CRC_TUNE_MIN_FOLD	64
+#define CRC_TUNE_BYTES		32768
+#define CRC_TUNE_RUNS		5
+
+typedef uint64_t (*crc_tune_func_tp)( const unsigned char *ptr, size_t num_bytes );
+
+/*
+ * struct crc_tune_tp
+ *
+ * The structure crc_tune_tp describes the measurement for one CRC width. The
+ * minimum folding size in the dispatch table is shared by the reflected and
+ * the non reflected algorithms of a width, and both are measured when the
+ * width has them.
+ */
+
+						/************************************************/
+struct crc_tune_tp {				/*						*/
+	int			bits;		/* The width of the CRC				*/
+	size_t			offset;		/* Offset of the size in crc_dispatch_tp	*/
+	crc_tune_func_tp	func1;		/* First algorithm to measure			*/
+	crc_tune_func_tp	func2;		/* Second algorithm to measure or NULL		*/
+};						/*						*/
+						/************************************************/
+
+static uint64_t		tune_crc_8(       const unsigned char *ptr, size_t num_bytes );
+static uint64_t		tune_crc_8_maxim( const unsigned char *ptr, size_t num_bytes );
+static uint64_t		tune_crc_16(      const unsigned char *ptr, size_t num_bytes );
+static uint64_t		tune_crc_xmodem(  const unsigned char *ptr, size_t num_bytes );
+static uint64_t		tune_crc_32(      const unsigned char *ptr, size_t num_bytes );
+static uint64_t		tune_crc_64_we(   const unsigned char *ptr, size_t num_bytes );
+static size_t		find_crossover( struct crc_dispatch_tp *level, const struct crc_tune_tp *tune, const unsigned char *buf );
+static bool		load_cache( struct crc_dispatch_tp *level, const char *cache_file );
+static double		measure( const struct crc_tune_tp *tune, const unsigned char *buf, size_t num_bytes );
+static double		now_seconds( void );
+static bool		save_cache( const struct crc_dispatch_tp *level, const char *cache_file );
+
+static const struct crc_tune_tp	tune_tab[] = {
+
+	{  8, offsetof( struct crc_dispatch_tp, clmul_min_8  ), tune_crc_8,     tune_crc_8_maxim },
+	{ 16, offsetof( struct crc_dispatch_tp, clmul_min_16 ), tune_crc_16,    tune_crc_xmodem  },
+	{ 32, offsetof( struct crc_dispatch_tp, clmul_min_32 ), tune_crc_32,    NULL             },
+	{ 64, offsetof( struct crc_dispatch_tp, clmul_min_64 ), tune_crc_64_we, NULL             },
+};
+
+static const size_t		tune_sizes[] = { 64, 96, 128, 160, 192, 256, 384, 512, 768, 1024, 2048, 4096 };
+
+#define CRC_TUNE_NUM		( sizeof(tune_tab)   / sizeof(tune_tab[0])   )
+#define CRC_TUNE_NUM_SIZES	( sizeof(tune_sizes) / sizeof(tune_sizes[0]) )
+#define CRC_TUNE_MAX_SIZE	4096
+
+#define CRC_TUNE_MIN(level,tune)	( *(size_t *) ( (char *) (level) + (tune)->offset ) )
+
+static volatile uint64_t	tune_sink;
+
+/*
+ * bool libcrc_autotune( const char *cache_file );
+ *
+ * The function libcrc_autotune() determines for each CRC width the buffer
+ * length from which on carry-less multiplication folding is used. When a
+ * cache file is given and it contains the results for the same processor,
+ * these are used without measuring. Otherwise the kernels are measured and
+ * the results are written to the cache file. The function returns false
+ * when memory could not be allocated or the cache file could not be
+ * written. On processors without folding kernels there is nothing to tune
+ * and true is returned. The function should not be called while other
+ * threads calculate CRC values.
+ */
+
+bool libcrc_autotune( const char *cache_file ) {
+
+	size_t a;
+	size_t b;
+	unsigned char *buf;
+	const char *old_impl;
+	struct crc_dispatch_tp *level;
+
+	level = crc_dispatch_level( "clmul" );
+	if ( level == NULL ) return true;
+
+	if ( cache_file != NULL  &&  load_cache( level, cache_file ) ) return true;
+
+	buf = malloc( CRC_TUNE_MAX_SIZE );
+	if ( buf == NULL ) return false;
+
+	for (a=0; a<CRC_TUNE_MAX_SIZE; a++) buf[a] = (unsigned char) ( a * 131 + 7 );
+
+	old_impl = libcrc_get_impl();
+	libcrc_set_impl( "clmul" );
+
+	for (b=0; b<CRC_TUNE_NUM; b++) CRC_TUNE_MIN( level, & tune_tab[b] ) = find_crossover( level, & tune_tab[b], buf );
+
+	libcrc_set_impl( old_impl );
+	free( buf );
+
+	if ( cache_file != NULL ) return save_cache( level, cache_file );
+
+	return true;
+
+}  /* libcrc_autotune */
+
+/*
+ * static size_t find_crossover( struct crc_dispatch_tp *level, const struct crc_tune_tp *tune, const unsigned char *buf );
+ *
+ * The function find_crossover() measures one CRC width with and without
+ * folding for a range of buffer lengths. It returns the shortest length from
+ * which on folding is faster for this and all longer lengths. When folding
+ * does not win even for the longest length, the measurement is considered
+ * unreliable and the current minimum size is returned unchanged.
+ */
+
+static size_t find_crossover( struct crc_dispatch_tp *level, const struct crc_tune_tp *tune, const unsigned char *buf ) {
+
+	size_t a;
+	size_t crossover;
+	size_t old_min;
+	double fold_time;
+	double slice_time;
+
+	old_min   = CRC_TUNE_MIN( level, tune );
+	crossover = SIZE_MAX;
+
+	for (a=CRC_TUNE_NUM_SIZES; a>0; a--) {
+
+		CRC_TUNE_MIN( level, tune ) = CRC_TUNE_MIN_FOLD;
+		fold_time = measure( tune, buf, tune_sizes[a-1] );
+
+		CRC_TUNE_MIN( level, tune ) = SIZE_MAX;
+		slice_time = measure( tune, buf, tune_sizes[a-1] );
+
+		if ( fold_time >= slice_time ) break;
+
+		crossover = tune_sizes[a-1];
+	}
+
+	if ( crossover == SIZE_MAX ) return old_min;
+
+	return crossover;
+
+}  /* find_crossover */
+
+/*
+ * static double measure( const struct crc_tune_tp *tune, const unsigned char *buf, size_t num_bytes );
+ *
+ * The function measure() returns the time in seconds which the algorithms of
+ * a CRC width need together for one buffer of the given length. The fastest
+ * of several runs is used to filter out interrupts and other noise.
+ */
+
+static double measure( const struct crc_tune_tp *tune, const unsigned char *buf, size_t num_bytes ) {
+
+	int run;
+	size_t a;
+	size_t calls;
+	uint64_t sum;
+	double start;
+	double elapsed;
+	double best;
+
+	calls = CRC_TUNE_BYTES / num_bytes + 1;
+	best  = 0.0;
+
+	for (run=0; run<CRC_TUNE_RUNS; run++) {
+
+		sum   = 0;
+		start = now_seconds();
+
+		for (a=0; a<calls; a++) {
+
+			sum += tune->func1( buf, num_bytes );
+			if ( tune->func2 != NULL ) sum += tune->func2( buf, num_bytes );
+		}
+
+		elapsed   = now_seconds() - start;
+		tune_sink = sum;
+
+		if ( run == 0  ||  elapsed < best ) best = elapsed;
+	}
+
+	return best / (double) calls;
+
+}  /* measure */
+
+/*
+ * static bool load_cache( struct crc_dispatch_tp *level, const char *cache_file );
+ *
+ * The function load_cache() reads the minimum folding sizes from a cache file
+ * into the dispatch table. It returns false without changing anything when
+ * the file does not exist, is damaged or was written on a processor with a
+ * different signature or different extensions.
+ */
+
+static bool load_cache( struct crc_dispatch_tp *level, const char *cache_file ) {
+
+	FILE *fp;
+	char line[64];
+	size_t a;
+	int bits;
+	unsigned long signature;
+	unsigned int features;
+	size_t min_size[CRC_TUNE_NUM];
+	bool ok;
+
+	fp = fopen( cache_file, "r" );
+	if ( fp == NULL ) return false;
+
+	ok = ( fgets( line, sizeof(line), fp ) != NULL  &&  strncmp( line, CRC_TUNE_MAGIC "\n", sizeof(CRC_TUNE_MAGIC) ) == 0 );
+
+	if ( ok ) ok = ( fscanf( fp, " signature %lx", & signature ) == 1  &&  signature == crc_cpu_signature() );
+	if ( ok ) ok = ( fscanf( fp, " features %x",   & features  ) == 1  &&  features  == crc_cpu_features()  );
+
+	for (a=0; ok  &&  a<CRC_TUNE_NUM; a++) {
+
+		ok = ( fscanf( fp, " clmul_min %d %zu", & bits, & min_size[a] ) == 2  &&  bits == tune_tab[a].bits  &&  min_size[a] >= CRC_TUNE_MIN_FOLD );
+	}
+
+	fclose( fp );
+
+	if ( ! ok ) return false;
+
+	for (a=0; a<CRC_TUNE_NUM; a++) CRC_TUNE_MIN( level, & tune_tab[a] ) = min_size[a];
+
+	return true;
+
+}  /* load_cache */
+
+/*
+ * static bool save_cache( const struct crc_dispatch_tp *level, const char *cache_file );
+ *
+ * The function save_cache() writes the minimum folding sizes of the dispatch
+ * table to a cache file, together with the processor signature and
+ * extensions for which they are valid.
+ */
+
+static bool save_cache( const struct crc_dispatch_tp *level, const char *cache_file ) {
+
+	FILE *fp;
+	size_t a;
+	bool ok;
+
+	fp = fopen( cache_file, "w" );
+	if ( fp == NULL ) return false;
+
+	ok = ( fprintf( fp, "%s\nsignature %lx\nfeatures %x\n", CRC_TUNE_MAGIC, crc_cpu_signature(), crc_cpu_features() ) > 0 );
+
+	for (a=0; ok  &&  a<CRC_TUNE_NUM; a++) {
+
+		ok = ( fprintf( fp, "clmul_min %d %zu\n", tune_tab[a].bits, *(const size_t *) ( (const char *) level + tune_tab[a].offset ) ) > 0 );
+	}
+
+	if ( fclose( fp ) != 0 ) ok = false;
+
+	return ok;
+
+}  /* save_cache */
+
+/*
+ * static double now_seconds( void );
+ *
+ * The function now_seconds() returns the value of a monotonic clock in
+ * seconds.
+ */
+
+static double now_seconds( void ) {
+
+#if defined(_WIN32)
+
+	LARGE_INTEGER count;
+	LARGE_INTEGER freq;
+
+	QueryPerformanceCounter(   & count );
+	QueryPerformanceFrequency( & freq  );
+
+	return (double) count.QuadPart / (double) freq.QuadPart;
+
+#else
+
+	struct timespec ts;
+
+	clock_gettime( CLOCK_MONOTONIC, & ts );
+
+	return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+
+#endif
+
+}  /* now_seconds */
+
+/*
+ * static uint64_t tune_crc_xxxx( const unsigned char *ptr, size_t num_bytes );
+ *
+ * The functions tune_crc_xxxx() call the measured CRC routines through one
+ * common prototype.
+ */
+
+static uint64_t tune_crc_8( const unsigned char *ptr, size_t num_bytes ) {
+
+	return crc_8( ptr, num_bytes );
+
+}  /* tune_crc_8 */
+
+static uint64_t tune_crc_8_maxim( const unsigned char *ptr, size_t num_bytes ) {
+
+	return crc_8_maxim( ptr, num_bytes );
+
+}  /* tune_crc_8_maxim */
+
+static uint64_t tune_crc_16( const unsigned char *ptr, size_t num_bytes ) {
+
+	return crc_16( ptr, num_bytes );
+
+}  /* tune_crc_16 */
+
+static uint64_t tune_crc_xmodem( const unsigned char *ptr, size_t num_bytes ) {
+
+	return crc_xmodem( ptr, num_bytes );
+
+}  /* tune_crc_xmodem */
+
+static uint64_t tune_crc_32( const unsigned char *ptr, size_t num_bytes ) {
+
+	return crc_32( ptr, num_bytes );
+
+}  /* tune_crc_32 */
+
+static uint64_t tune_crc_64_we( const unsigned char *ptr, size_t num_bytes ) {
+
+	return crc_64_we( ptr, num_bytes );
+
+}  /* tune_crc_64_we */
@@ -0,0 +1,664 @@
+/*
+ * Library: libcrc
+ * File:    test/bench.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2026 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file test/bench.c contains the crcbench program which measures
+ * the speed of the public routines of the libcrc library. Every routine is
+ * called on buffers from 8 bytes up to 1 GB, with the data in the cache (hot)
+ * and not in the cache (cold), and at an aligned and a misaligned address.
+ * The results are printed as a table in GB/s, nanoseconds per call and
+ * processor cycles per byte, can be written as JSON and can be compared with
+ * a JSON file of an earlier run to detect regressions.
+ *
+ * usage: crcbench [-m max_size] [-t min_time] [-f filter] [-j json_file]
+ *                 [-b baseline_file] [-r threshold]
+ */
+
+#if ! defined(_WIN32)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../include/checksum.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+#if defined(__x86_64__)  ||  defined(__i386__)  ||  defined(_M_X64)  ||  defined(_M_IX86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define BENCH_HAVE_RDTSC
+#endif
+
+/*
+ * #define BENCH_xxxx
+ *
+ * BENCH_COLD_ARENA is the size of the memory area over which the buffers are
+ * moved in the cold cache runs. It must be larger than the last level cache.
+ * BENCH_MIN_SIZE and BENCH_MAX_SIZE are the smallest and default largest
+ * buffer size, each size is eight times the previous one. A measurement is
+ * repeated until at least BENCH_MIN_TIME seconds have been timed.
+ */
+
+#define BENCH_COLD_ARENA	(256ul*1024*1024)
+#define BENCH_MIN_SIZE		8
+#define BENCH_MAX_SIZE		(1024ul*1024*1024)
+#define BENCH_MIN_TIME		0.05
+#define BENCH_THRESHOLD		10.0
+#define BENCH_MAX_RESULTS	2048
+
+/*
+ * struct bench_func_tp
+ *
+ * The structure bench_func_tp connects the name of a library routine with a
+ * wrapper which calls that routine for a buffer.
+ */
+
+						/************************************************/
+struct bench_func_tp {				/*						*/
+	const char *	name;			/* Name of the library routine			*/
+	void		(*func)( unsigned char *ptr, size_t num_bytes );
+};						/*						*/
+						/************************************************/
+
+/*
+ * struct bench_result_tp
+ *
+ * The structure bench_result_tp holds the result of one measurement.
+ */
+
+						/************************************************/
+struct bench_result_tp {			/*						*/
+	char		name[32];		/* Name of the library routine			*/
+	size_t		size;			/* Buffer size in bytes				*/
+	bool		cold;			/* True if the buffer was not in the cache	*/
+	int		offset;			/* Misalignment of the buffer			*/
+	double		gbps;			/* Throughput in GB/s				*/
+	double		ns_call;		/* Nanoseconds per call				*/
+	double		cycles_byte;		/* Time stamp counter cycles per byte		*/
+};						/*						*/
+						/************************************************/
+
+int			main( int argc, char *argv[] );
+static void		bench_crc_8(          unsigned char *ptr, size_t num_bytes );
+static void		bench_crc_8_autosar(  unsigned char *ptr, size_t num_bytes );
+static void		bench_crc_8_maxim(    unsigned char *ptr, size_t num_bytes );
+static void		bench_crc_8_smbus(    unsigned char *ptr, size_t num_bytes );
+static void		bench_crc_16(         unsigned char *ptr, size_t num_bytes );
+static void		bench_crc_32(         unsigned char *ptr, size_t num_bytes );
+static void		bench_crc_32c(        unsigned char *ptr, size_t num_bytes );
+static void		bench_crc_64_ecma(    unsigned char *ptr, size_t num_bytes );
+static void		bench_crc_64_we(      unsigned char *ptr, size_t num_bytes );
+static void		bench_crc_ccitt_1d0f( unsigned char *ptr, size_t num_bytes );
+static void		bench_crc_ccitt_ffff( unsigned char *ptr, size_t num_bytes );
+static void		bench_crc_dnp(        unsigned char *ptr, size_t num_bytes );
+static void		bench_crc_kermit(     unsigned char *ptr, size_t num_bytes );
+static void		bench_crc_modbus(     unsigned char *ptr, size_t num_bytes );
+static void		bench_crc_sick(       unsigned char *ptr, size_t num_bytes );
+static void		bench_crc_xmodem(     unsigned char *ptr, size_t num_bytes );
+static void		bench_checksum_nmea(  unsigned char *ptr, size_t num_bytes );
+static void		bench_update_crc_8(      unsigned char *ptr, size_t num_bytes );
+static void		bench_update_crc_16(     unsigned char *ptr, size_t num_bytes );
+static void		bench_update_crc_32(     unsigned char *ptr, size_t num_bytes );
+static void		bench_update_crc_32c(    unsigned char *ptr, size_t num_bytes );
+static void		bench_update_crc_64(     unsigned char *ptr, size_t num_bytes );
+static void		bench_update_crc_ccitt(  unsigned char *ptr, size_t num_bytes );
+static void		bench_update_crc_dnp(    unsigned char *ptr, size_t num_bytes );
+static void		bench_update_crc_kermit( unsigned char *ptr, size_t num_bytes );
+static void		bench_update_crc_sick(   unsigned char *ptr, size_t num_bytes );
+static void		measure( const struct bench_func_tp *func, unsigned char *arena, size_t arena_size, size_t size, bool cold, int offset, double min_time, struct bench_result_tp *result );
+static double		now_seconds( void );
+static uint64_t		read_tsc( void );
+static int		read_baseline( const char *filename, struct bench_result_tp *results, int max_results );
+static const struct bench_result_tp *find_result( const struct bench_result_tp *results, int num_results, const struct bench_result_tp *key );
+static void		write_json( const char *filename, const struct bench_result_tp *results, int num_results );
+
+static volatile uint64_t	bench_sink;
+
+static const struct bench_func_tp bench_funcs[] = {
+
+	{ "crc_8",             bench_crc_8             },
+	{ "crc_8_autosar",     bench_crc_8_autosar     },
+	{ "crc_8_maxim",       bench_crc_8_maxim       },
+	{ "crc_8_smbus",       bench_crc_8_smbus       },
+	{ "crc_16",            bench_crc_16            },
+	{ "crc_32",            bench_crc_32            },
+	{ "crc_32c",           bench_crc_32c           },
+	{ "crc_64_ecma",       bench_crc_64_ecma       },
+	{ "crc_64_we",         bench_crc_64_we         },
+	{ "crc_ccitt_1d0f",    bench_crc_ccitt_1d0f    },
+	{ "crc_ccitt_ffff",    bench_crc_ccitt_ffff    },
+	{ "crc_dnp",           bench_crc_dnp           },
+	{ "crc_kermit",        bench_crc_kermit        },
+	{ "crc_modbus",        bench_crc_modbus        },
+	{ "crc_sick",          bench_crc_sick          },
+	{ "crc_xmodem",        bench_crc_xmodem        },
+	{ "checksum_NMEA",     bench_checksum_nmea     },
+	{ "update_crc_8",      bench_update_crc_8      },
+	{ "update_crc_16",     bench_update_crc_16     },
+	{ "update_crc_32",     bench_update_crc_32     },
+	{ "update_crc_32c",    bench_update_crc_32c    },
+	{ "update_crc_64",     bench_update_crc_64     },
+	{ "update_crc_ccitt",  bench_update_crc_ccitt  },
+	{ "update_crc_dnp",    bench_update_crc_dnp    },
+	{ "update_crc_kermit", bench_update_crc_kermit },
+	{ "update_crc_sick",   bench_update_crc_sick   }
+};
+
+static struct bench_result_tp	bench_results[BENCH_MAX_RESULTS];
+static struct bench_result_tp	bench_baseline[BENCH_MAX_RESULTS];
+
+/*
+ * int main( int argc, char *argv[] );
+ *
+ * The main routine of the crcbench program parses the command line, runs all
+ * measurements and reports the results.
+ */
+
+int main( int argc, char *argv[] ) {
+
+	int a;
+	int offset;
+	int cache;
+	int num_results;
+	int num_baseline;
+	int regressions;
+	size_t f;
+	size_t size;
+	size_t max_size;
+	size_t arena_size;
+	double min_time;
+	double threshold;
+	double delta;
+	const char *filter;
+	const char *json_file;
+	const char *baseline_file;
+	unsigned char *mem;
+	unsigned char *arena;
+	struct bench_result_tp *res;
+	const struct bench_result_tp *base;
+
+	max_size      = BENCH_MAX_SIZE;
+	min_time      = BENCH_MIN_TIME;
+	threshold     = BENCH_THRESHOLD;
+	filter        = NULL;
+	json_file     = NULL;
+	baseline_file = NULL;
+
+	for (a=1; a<argc; a++) {
+
+		if      ( ! strcmp( argv[a], "-m" )  &&  a+1 < argc ) max_size      = strtoul( argv[++a], NULL, 0 );
+		else if ( ! strcmp( argv[a], "-t" )  &&  a+1 < argc ) min_time      = atof(    argv[++a]          );
+		else if ( ! strcmp( argv[a], "-f" )  &&  a+1 < argc ) filter        =          argv[++a];
+		else if ( ! strcmp( argv[a], "-j" )  &&  a+1 < argc ) json_file     =          argv[++a];
+		else if ( ! strcmp( argv[a], "-b" )  &&  a+1 < argc ) baseline_file =          argv[++a];
+		else if ( ! strcmp( argv[a], "-r" )  &&  a+1 < argc ) threshold     = atof(    argv[++a]          );
+		else {
+
+			fprintf( stderr, "\nusage: crcbench [-m max_size] [-t min_time] [-f filter] [-j json_file]\n" );
+			fprintf( stderr, "                [-b baseline_file] [-r threshold]\n\n" );
+			exit( 1 );
+		}
+	}
+
+	if ( max_size < BENCH_MIN_SIZE ) max_size = BENCH_MIN_SIZE;
+
+	arena_size = ( max_size > BENCH_COLD_ARENA ) ? max_size : BENCH_COLD_ARENA;
+	mem        = malloc( arena_size + 128 );
+
+	if ( mem == NULL ) {
+
+		fprintf( stderr, "\ncrcbench: cannot allocate %zu bytes\n\n", arena_size + 128 );
+		exit( 1 );
+	}
+
+	arena = mem + ( ( 64 - ( (uintptr_t) mem & 63 ) ) & 63 );
+
+	srand( 1 );
+	for (f=0; f<arena_size+64; f++) arena[f] = (unsigned char) ( 'A' + rand() % 26 );
+
+	num_baseline = 0;
+	if ( baseline_file != NULL ) {
+
+		num_baseline = read_baseline( baseline_file, bench_baseline, BENCH_MAX_RESULTS );
+		if ( num_baseline < 0 ) printf( "No baseline file \"%s\" found, no comparison is made\n\n", baseline_file );
+	}
+
+	printf( "%-18s %11s %-5s %3s %10s %14s %9s %s\n", "function", "size", "cache", "off", "GB/s", "ns/call", "cycles/B", ( num_baseline > 0 ) ? "   vs base" : "" );
+
+	num_results = 0;
+	regressions = 0;
+
+	for (f=0; f<sizeof(bench_funcs)/sizeof(bench_funcs[0]); f++) {
+
+		if ( filter != NULL  &&  strstr( bench_funcs[f].name, filter ) == NULL ) continue;
+
+		for (size=BENCH_MIN_SIZE; size<=max_size; size*=8) {
+
+			for (cache=0; cache<2; cache++) for (offset=0; offset<=1; offset++) {
+
+				if ( num_results >= BENCH_MAX_RESULTS ) break;
+
+				res = bench_results + num_results++;
+				measure( bench_funcs + f, arena, arena_size, size, cache == 1, offset, min_time, res );
+
+				printf( "%-18s %11zu %-5s %3d %10.3f %14.1f %9.3f", res->name, res->size, ( res->cold ) ? "cold" : "hot", res->offset, res->gbps, res->ns_call, res->cycles_byte );
+
+				base = ( num_baseline > 0 ) ? find_result( bench_baseline, num_baseline, res ) : NULL;
+
+				if ( base != NULL  &&  base->gbps > 0.0 ) {
+
+					delta = 100.0 * ( res->gbps - base->gbps ) / base->gbps;
+					printf( " %+9.1f%%", delta );
+
+					if ( delta < -threshold ) {
+
+						printf( " REGRESSION" );
+						regressions++;
+					}
+				}
+
+				printf( "\n" );
+				fflush( stdout );
+			}
+		}
+	}
+
+	if ( json_file != NULL ) write_json( json_file, bench_results, num_results );
+
+	if ( num_baseline > 0 ) printf( "\n%d measurements are more than %.1f%% slower than the baseline\n", regressions, threshold );
+
+	free( mem );
+
+	return ( regressions > 0 ) ? 2 : 0;
+
+}  /* main (crcbench) */
+
+/*
+ * static void measure( const struct bench_func_tp *func, unsigned char *arena, size_t arena_size, size_t size, bool cold, int offset, double min_time, struct bench_result_tp *result );
+ *
+ * The function measure() calls a library routine repeatedly on a buffer of
+ * the given size until at least min_time seconds have been timed. The number
+ * of calls per timed batch doubles each round. In cold runs every call uses
+ * the next buffer position in an arena which is larger than the cache.
+ */
+
+static void measure( const struct bench_func_tp *func, unsigned char *arena, size_t arena_size, size_t size, bool cold, int offset, double min_time, struct bench_result_tp *result ) {
+
+	size_t a;
+	size_t pos;
+	size_t stride;
+	size_t batch;
+	size_t calls;
+	double start;
+	double elapsed;
+	uint64_t tsc_start;
+	uint64_t cycles;
+
+	stride  = ( ( size + 4095 ) & ~( (size_t) 4095 ) ) + 4096;
+	pos     = 0;
+	batch   = 1;
+	calls   = 0;
+	elapsed = 0.0;
+	cycles  = 0;
+
+	func->func( arena + offset, size );
+
+	while ( elapsed < min_time ) {
+
+		start     = now_seconds();
+		tsc_start = read_tsc();
+
+		for (a=0; a<batch; a++) {
+
+			if ( cold ) {
+
+				pos += stride;
+				if ( pos + size + offset > arena_size ) pos = 0;
+			}
+
+			func->func( arena + pos + offset, size );
+		}
+
+		cycles  += read_tsc() - tsc_start;
+		elapsed += now_seconds() - start;
+		calls   += batch;
+		batch   *= 2;
+	}
+
+	memset( result, 0, sizeof(*result) );
+
+	snprintf( result->name, sizeof(result->name), "%s", func->name );
+	result->size        = size;
+	result->cold        = cold;
+	result->offset      = offset;
+	result->gbps        = ( (double) size * (double) calls ) / elapsed / 1e9;
+	result->ns_call     = elapsed * 1e9 / (double) calls;
+	result->cycles_byte = (double) cycles / ( (double) size * (double) calls );
+
+}  /* measure */
+
+/*
+ * static double now_seconds( void );
+ *
+ * The function now_seconds() returns the value of a monotonic clock in
+ * seconds.
+ */
+
+static double now_seconds( void ) {
+
+#if defined(_WIN32)
+
+	LARGE_INTEGER count;
+	LARGE_INTEGER freq;
+
+	QueryPerformanceCounter(   & count );
+	QueryPerformanceFrequency( & freq  );
+
+	return (double) count.QuadPart / (double) freq.QuadPart;
+
+#else
+
+	struct timespec ts;
+
+	clock_gettime( CLOCK_MONOTONIC, & ts );
+
+	return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+
+#endif
+
+}  /* now_seconds */
+
+/*
+ * static uint64_t read_tsc( void );
+ *
+ * The function read_tsc() returns the time stamp counter of the processor, or
+ * 0 on processors without such a counter.
+ */
+
+static uint64_t read_tsc( void ) {
+
+#if defined(BENCH_HAVE_RDTSC)
+	return (uint64_t) __rdtsc();
+#else
+	return 0;
+#endif
+
+}  /* read_tsc */
+
+/*
+ * static int read_baseline( const char *filename, struct bench_result_tp *results, int max_results );
+ *
+ * The function read_baseline() reads the results of an earlier run from a
+ * JSON file written by write_json(). The function returns the number of
+ * results read, or -1 if the file cannot be opened.
+ */
+
+static int read_baseline( const char *filename, struct bench_result_tp *results, int max_results ) {
+
+	int num;
+	char cache[8];
+	char line[512];
+	FILE *fp;
+	struct bench_result_tp *res;
+
+	fp = fopen( filename, "r" );
+	if ( fp == NULL ) return -1;
+
+	num = 0;
+
+	while ( num < max_results  &&  fgets( line, sizeof(line), fp ) != NULL ) {
+
+		res = results + num;
+
+		if ( sscanf( line, " { \"function\": \"%31[^\"]\", \"size\": %zu, \"cache\": \"%7[^\"]\", \"offset\": %d, \"gbps\": %lf, \"ns_per_call\": %lf, \"cycles_per_byte\": %lf"
+				, res->name, & res->size, cache, & res->offset, & res->gbps, & res->ns_call, & res->cycles_byte ) == 7 ) {
+
+			res->cold = ( strcmp( cache, "cold" ) == 0 );
+			num++;
+		}
+	}
+
+	fclose( fp );
+
+	return num;
+
+}  /* read_baseline */
+
+/*
+ * static const struct bench_result_tp *find_result( const struct bench_result_tp *results, int num_results, const struct bench_result_tp *key );
+ *
+ * The function find_result() returns the result of the same measurement in a
+ * list of results, or NULL if that measurement is not in the list.
+ */
+
+static const struct bench_result_tp *find_result( const struct bench_result_tp *results, int num_results, const struct bench_result_tp *key ) {
+
+	int a;
+
+	for (a=0; a<num_results; a++) {
+
+		if ( results[a].size == key->size  &&  results[a].cold == key->cold  &&  results[a].offset == key->offset  &&  ! strcmp( results[a].name, key->name ) ) return results + a;
+	}
+
+	return NULL;
+
+}  /* find_result */
+
+/*
+ * static void write_json( const char *filename, const struct bench_result_tp *results, int num_results );
+ *
+ * The function write_json() writes the results to a JSON file with one
+ * measurement per line. The file can be used as baseline for later runs.
+ */
+
+static void write_json( const char *filename, const struct bench_result_tp *results, int num_results ) {
+
+	int a;
+	FILE *fp;
+
+	fp = fopen( filename, "w" );
+
+	if ( fp == NULL ) {
+
+		fprintf( stderr, "\ncrcbench: cannot open \"%s\" for writing\n\n", filename );
+		return;
+	}
+
+	fprintf( fp, "{\n  \"results\": [\n" );
+
+	for (a=0; a<num_results; a++) {
+
+		fprintf( fp, "    { \"function\": \"%s\", \"size\": %zu, \"cache\": \"%s\", \"offset\": %d, \"gbps\": %.6f, \"ns_per_call\": %.3f, \"cycles_per_byte\": %.4f }%s\n"
+			, results[a].name, results[a].size, ( results[a].cold ) ? "cold" : "hot", results[a].offset
+			, results[a].gbps, results[a].ns_call, results[a].cycles_byte, ( a < num_results-1 ) ? "," : "" );
+	}
+
+	fprintf( fp, "  ]\n}\n" );
+
+	fclose( fp );
+
+}  /* write_json */
+
+/*
+ * static void bench_xxx( unsigned char *ptr, size_t num_bytes );
+ *
+ * The bench_xxx() functions call one library routine for a buffer and store
+ * the result in a volatile variable, so the compiler cannot remove the call.
+ * The update_xxx() routines are called once for every byte.
+ */
+
+static void bench_crc_8(          unsigned char *ptr, size_t num_bytes ) { bench_sink = crc_8(          ptr, num_bytes ); }
+static void bench_crc_8_autosar(  unsigned char *ptr, size_t num_bytes ) { bench_sink = crc_8_autosar(  ptr, num_bytes ); }
+static void bench_crc_8_maxim(    unsigned char *ptr, size_t num_bytes ) { bench_sink = crc_8_maxim(    ptr, num_bytes ); }
+static void bench_crc_8_smbus(    unsigned char *ptr, size_t num_bytes ) { bench_sink = crc_8_smbus(    ptr, num_bytes ); }
+static void bench_crc_16(         unsigned char *ptr, size_t num_bytes ) { bench_sink = crc_16(         ptr, num_bytes ); }
+static void bench_crc_32(         unsigned char *ptr, size_t num_bytes ) { bench_sink = crc_32(         ptr, num_bytes ); }
+static void bench_crc_32c(        unsigned char *ptr, size_t num_bytes ) { bench_sink = crc_32c(        ptr, num_bytes ); }
+static void bench_crc_64_ecma(    unsigned char *ptr, size_t num_bytes ) { bench_sink = crc_64_ecma(    ptr, num_bytes ); }
+static void bench_crc_64_we(      unsigned char *ptr, size_t num_bytes ) { bench_sink = crc_64_we(      ptr, num_bytes ); }
+static void bench_crc_ccitt_1d0f( unsigned char *ptr, size_t num_bytes ) { bench_sink = crc_ccitt_1d0f( ptr, num_bytes ); }
+static void bench_crc_ccitt_ffff( unsigned char *ptr, size_t num_bytes ) { bench_sink = crc_ccitt_ffff( ptr, num_bytes ); }
+static void bench_crc_dnp(        unsigned char *ptr, size_t num_bytes ) { bench_sink = crc_dnp(        ptr, num_bytes ); }
+static void bench_crc_kermit(     unsigned char *ptr, size_t num_bytes ) { bench_sink = crc_kermit(     ptr, num_bytes ); }
+static void bench_crc_modbus(     unsigned char *ptr, size_t num_bytes ) { bench_sink = crc_modbus(     ptr, num_bytes ); }
+static void bench_crc_sick(       unsigned char *ptr, size_t num_bytes ) { bench_sink = crc_sick(       ptr, num_bytes ); }
+static void bench_crc_xmodem(     unsigned char *ptr, size_t num_bytes ) { bench_sink = crc_xmodem(     ptr, num_bytes ); }
+
+static void bench_checksum_nmea( unsigned char *ptr, size_t num_bytes ) {
+
+	unsigned char save;
+	unsigned char result[3];
+
+	save           = ptr[num_bytes];
+	ptr[num_bytes] = '\0';
+
+	checksum_NMEA( ptr, result );
+
+	ptr[num_bytes] = save;
+	bench_sink     = result[0];
+
+}  /* bench_checksum_nmea */
+
+static void bench_update_crc_8( unsigned char *ptr, size_t num_bytes ) {
+
+	size_t a;
+	uint8_t crc;
+
+	crc = CRC_START_8;
+	for (a=0; a<num_bytes; a++) crc = update_crc_8( crc, ptr[a] );
+	bench_sink = crc;
+
+}  /* bench_update_crc_8 */
+
+static void bench_update_crc_16( unsigned char *ptr, size_t num_bytes ) {
+
+	size_t a;
+	uint16_t crc;
+
+	crc = CRC_START_16;
+	for (a=0; a<num_bytes; a++) crc = update_crc_16( crc, ptr[a] );
+	bench_sink = crc;
+
+}  /* bench_update_crc_16 */
+
+static void bench_update_crc_32( unsigned char *ptr, size_t num_bytes ) {
+
+	size_t a;
+	uint32_t crc;
+
+	crc = CRC_START_32;
+	for (a=0; a<num_bytes; a++) crc = update_crc_32( crc, ptr[a] );
+	bench_sink = crc;
+
+}  /* bench_update_crc_32 */
+
+static void bench_update_crc_32c( unsigned char *ptr, size_t num_bytes ) {
+
+	size_t a;
+	uint32_t crc;
+
+	crc = CRC_START_32C;
+	for (a=0; a<num_bytes; a++) crc = update_crc_32c( crc, ptr[a] );
+	bench_sink = crc;
+
+}  /* bench_update_crc_32c */
+
+static void bench_update_crc_64( unsigned char *ptr, size_t num_bytes ) {
+
+	size_t a;
+	uint64_t crc;
+
+	crc = CRC_START_64_ECMA;
+	for (a=0; a<num_bytes; a++) crc = update_crc_64( crc, ptr[a] );
+	bench_sink = crc;
+
+}  /* bench_update_crc_64 */
+
+static void bench_update_crc_ccitt( unsigned char *ptr, size_t num_bytes ) {
+
+	size_t a;
+	uint16_t crc;
+
+	crc = CRC_START_CCITT_FFFF;
+	for (a=0; a<num_bytes; a++) crc = update_crc_ccitt( crc, ptr[a] );
+	bench_sink = crc;
+
+}  /* bench_update_crc_ccitt */
+
+static void bench_update_crc_dnp( unsigned char *ptr, size_t num_bytes ) {
+
+	size_t a;
+	uint16_t crc;
+
+	crc = CRC_START_DNP;
+	for (a=0; a<num_bytes; a++) crc = update_crc_dnp( crc, ptr[a] );
+	bench_sink = crc;
+
+}  /* bench_update_crc_dnp */
+
+static void bench_update_crc_kermit( unsigned char *ptr, size_t num_bytes ) {
+
+	size_t a;
+	uint16_t crc;
+
+	crc = CRC_START_KERMIT;
+	for (a=0; a<num_bytes; a++) crc = update_crc_kermit( crc, ptr[a] );
+	bench_sink = crc;
+
+}  /* bench_update_crc_kermit */
+
+static void bench_update_crc_sick( unsigned char *ptr, size_t num_bytes ) {
+
+	size_t a;
+	uint16_t crc;
+	unsigned char prev;
+
+	crc  = CRC_START_SICK;
+	prev = 0;
+
+	for (a=0; a<num_bytes; a++) {
+
+		crc  = update_crc_sick( crc, ptr[a], prev );
+		prev = ptr[a];
+	}
+
+	bench_sink = crc;
+
+}  /* bench_update_crc_sick */
@@ -52,6 +52,17 @@ int main( void ) {
 
 	problems  = 0;
 	problems += test_crc( true );
+	problems += test_crc_inline( true );
+	problems += test_crc_block( true );
+	problems += test_crc_dispatch( true );
+	problems += test_crc_autotune( true );
+	problems += test_crc_batch( true );
+	problems += test_crc_verify( true );
+	problems += test_crc_model( true );
+	problems += test_crc_combine( true );
+	problems += test_crc_parallel( true );
+	problems += test_crc_ctx( true );
+	problems += test_crc_multi( true );
 	problems += test_checksum_NMEA( true );
 
 	printf( "\n" );
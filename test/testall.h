@@ -37,3 +37,14 @@
 int		main( void );
 int		test_checksum_NMEA( bool verbose );
 int		test_crc( bool verbose );
+int		test_crc_autotune( bool verbose );
+int		test_crc_batch( bool verbose );
+int		test_crc_block( bool verbose );
+int		test_crc_combine( bool verbose );
+int		test_crc_ctx( bool verbose );
+int		test_crc_dispatch( bool verbose );
+int		test_crc_inline( bool verbose );
+int		test_crc_model( bool verbose );
+int		test_crc_multi( bool verbose );
+int		test_crc_parallel( bool verbose );
+int		test_crc_verify( bool verbose );
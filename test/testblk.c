@@ -0,0 +1,937 @@
+/*
+ * Library: libcrc
+ * File:    test/testblk.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2026 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file test/testblk.c contains routines which test that the block
+ * oriented CRC routines of the libcrc library return the same values as the
+ * byte-at-a-time update routines. The buffers are long enough and are offered
+ * at enough different alignments to exercise every code path of the
+ * accelerated calculation kernels. The parallel routines are checked on the
+ * same buffers with a small chunk size to force the use of several threads.
+ * The batch routines are checked on many buffers of different lengths.
+ * Every implementation level of the dispatch layer is checked against the
+ * plain byte-at-a-time level, also after the crossover points have been
+ * changed by the auto-tuner.
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "testall.h"
+
+#if ! defined(_WIN32)
+#include <unistd.h>
+#endif
+
+#include "../include/checksum.h"
+#include "../src/crcint.h"
+
+#define TEST_BUF_SIZE		(70000+16)
+#define TEST_NUM_OFFSET		16
+#define TEST_TUNE_NAME		"libcrc-tune-XXXXXX"
+#define TEST_BATCH_SIZE		101
+#define TEST_VERIFY_SIZE	130
+
+static void			fill_test_buf( void );
+static bool			tune_file_name( char *name, size_t size );
+static int			compare_levels( bool verbose );
+static uint64_t			stream_crc( enum crc_algo algo, const unsigned char *ptr, size_t len );
+
+static unsigned char		test_buf[TEST_BUF_SIZE];
+
+static const size_t		test_lengths[] = {
+
+	0, 1, 2, 3, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 128, 129,
+	255, 256, 257, 1000, 1024, 4095, 4096, 4097, 65536, 70000
+};
+
+/*
+ * int test_crc_block( bool verbose );
+ *
+ * The function test_crc_block() compares the result of the one-pass CRC
+ * routines over long buffers with the result of the byte-at-a-time update
+ * routines for a range of buffer lengths and start alignments.
+ */
+
+int test_crc_block( bool verbose ) {
+
+	int errors;
+	size_t a;
+	size_t b;
+	size_t offset;
+	size_t len;
+	const unsigned char *ptr;
+	uint8_t crc8;
+	uint8_t ref8;
+	uint16_t crc16;
+	uint16_t ref16;
+	uint32_t crc32;
+	uint32_t ref32;
+	uint64_t crc64;
+	uint64_t ref64;
+
+	errors = 0;
+
+	printf( "Testing CRC block routines: " );
+
+	fill_test_buf();
+
+	for (offset=0; offset<TEST_NUM_OFFSET; offset++) {
+
+		for (a=0; a<sizeof(test_lengths)/sizeof(test_lengths[0]); a++) {
+
+			ptr = test_buf + offset;
+			len = test_lengths[a];
+
+			ref32 = CRC_START_32;
+			for (b=0; b<len; b++) ref32 = update_crc_32( ref32, ptr[b] );
+			ref32 ^= 0xFFFFFFFFul;
+
+			crc32 = crc_32( ptr, len );
+
+			if ( crc32 != ref32 ) {
+
+				if ( verbose ) printf( "\n    FAIL: CRC32 offset %zu length %zu returns 0x%08" PRIX32 ", not 0x%08" PRIX32
+								, offset, len, crc32, ref32 );
+				errors++;
+			}
+
+			ref32 = CRC_START_32C;
+			for (b=0; b<len; b++) ref32 = update_crc_32c( ref32, ptr[b] );
+			ref32 ^= 0xFFFFFFFFul;
+
+			crc32 = crc_32c( ptr, len );
+
+			if ( crc32 != ref32 ) {
+
+				if ( verbose ) printf( "\n    FAIL: CRC32C offset %zu length %zu returns 0x%08" PRIX32 ", not 0x%08" PRIX32
+								, offset, len, crc32, ref32 );
+				errors++;
+			}
+
+			ref64 = CRC_START_64_ECMA;
+			for (b=0; b<len; b++) ref64 = update_crc_64( ref64, ptr[b] );
+
+			crc64 = crc_64_ecma( ptr, len );
+
+			if ( crc64 != ref64 ) {
+
+				if ( verbose ) printf( "\n    FAIL: CRC64 ECMA offset %zu length %zu returns 0x%016" PRIX64 ", not 0x%016" PRIX64
+								, offset, len, crc64, ref64 );
+				errors++;
+			}
+
+			ref64 = CRC_START_64_WE;
+			for (b=0; b<len; b++) ref64 = update_crc_64( ref64, ptr[b] );
+			ref64 ^= 0xFFFFFFFFFFFFFFFFull;
+
+			crc64 = crc_64_we( ptr, len );
+
+			if ( crc64 != ref64 ) {
+
+				if ( verbose ) printf( "\n    FAIL: CRC64 WE offset %zu length %zu returns 0x%016" PRIX64 ", not 0x%016" PRIX64
+								, offset, len, crc64, ref64 );
+				errors++;
+			}
+
+			ref8 = CRC_START_8;
+			for (b=0; b<len; b++) ref8 = update_crc_8( ref8, ptr[b] );
+
+			crc8 = crc_8( ptr, len );
+
+			if ( crc8 != ref8 ) {
+
+				if ( verbose ) printf( "\n    FAIL: CRC8 offset %zu length %zu returns 0x%02" PRIX8 ", not 0x%02" PRIX8
+								, offset, len, crc8, ref8 );
+				errors++;
+			}
+
+			ref16 = CRC_START_16;
+			for (b=0; b<len; b++) ref16 = update_crc_16( ref16, ptr[b] );
+
+			crc16 = crc_16( ptr, len );
+
+			if ( crc16 != ref16 ) {
+
+				if ( verbose ) printf( "\n    FAIL: CRC16 offset %zu length %zu returns 0x%04" PRIX16 ", not 0x%04" PRIX16
+								, offset, len, crc16, ref16 );
+				errors++;
+			}
+
+			ref16 = CRC_START_MODBUS;
+			for (b=0; b<len; b++) ref16 = update_crc_16( ref16, ptr[b] );
+
+			crc16 = crc_modbus( ptr, len );
+
+			if ( crc16 != ref16 ) {
+
+				if ( verbose ) printf( "\n    FAIL: Modbus offset %zu length %zu returns 0x%04" PRIX16 ", not 0x%04" PRIX16
+								, offset, len, crc16, ref16 );
+				errors++;
+			}
+
+			ref16 = CRC_START_DNP;
+			for (b=0; b<len; b++) ref16 = update_crc_dnp( ref16, ptr[b] );
+			ref16 = (uint16_t) ~ref16;
+			ref16 = (uint16_t) ( ( ref16 >> 8 ) | ( ref16 << 8 ) );
+
+			crc16 = crc_dnp( ptr, len );
+
+			if ( crc16 != ref16 ) {
+
+				if ( verbose ) printf( "\n    FAIL: DNP offset %zu length %zu returns 0x%04" PRIX16 ", not 0x%04" PRIX16
+								, offset, len, crc16, ref16 );
+				errors++;
+			}
+
+			ref16 = CRC_START_KERMIT;
+			for (b=0; b<len; b++) ref16 = update_crc_kermit( ref16, ptr[b] );
+			ref16 = (uint16_t) ( ( ref16 >> 8 ) | ( ref16 << 8 ) );
+
+			crc16 = crc_kermit( ptr, len );
+
+			if ( crc16 != ref16 ) {
+
+				if ( verbose ) printf( "\n    FAIL: Kermit offset %zu length %zu returns 0x%04" PRIX16 ", not 0x%04" PRIX16
+								, offset, len, crc16, ref16 );
+				errors++;
+			}
+
+			ref16 = CRC_START_XMODEM;
+			for (b=0; b<len; b++) ref16 = update_crc_ccitt( ref16, ptr[b] );
+
+			crc16 = crc_xmodem( ptr, len );
+
+			if ( crc16 != ref16 ) {
+
+				if ( verbose ) printf( "\n    FAIL: XModem offset %zu length %zu returns 0x%04" PRIX16 ", not 0x%04" PRIX16
+								, offset, len, crc16, ref16 );
+				errors++;
+			}
+
+			ref16 = CRC_START_CCITT_1D0F;
+			for (b=0; b<len; b++) ref16 = update_crc_ccitt( ref16, ptr[b] );
+
+			crc16 = crc_ccitt_1d0f( ptr, len );
+
+			if ( crc16 != ref16 ) {
+
+				if ( verbose ) printf( "\n    FAIL: CCITT 1D0F offset %zu length %zu returns 0x%04" PRIX16 ", not 0x%04" PRIX16
+								, offset, len, crc16, ref16 );
+				errors++;
+			}
+
+			ref16 = CRC_START_CCITT_FFFF;
+			for (b=0; b<len; b++) ref16 = update_crc_ccitt( ref16, ptr[b] );
+
+			crc16 = crc_ccitt_ffff( ptr, len );
+
+			if ( crc16 != ref16 ) {
+
+				if ( verbose ) printf( "\n    FAIL: CCITT FFFF offset %zu length %zu returns 0x%04" PRIX16 ", not 0x%04" PRIX16
+								, offset, len, crc16, ref16 );
+				errors++;
+			}
+
+			ref16 = CRC_START_SICK;
+			for (b=0; b<len; b++) ref16 = update_crc_sick( ref16, ptr[b], ( b > 0 ) ? ptr[b-1] : 0 );
+			ref16 = (uint16_t) ( ( ref16 >> 8 ) | ( ref16 << 8 ) );
+
+			crc16 = crc_sick( ptr, len );
+
+			if ( crc16 != ref16 ) {
+
+				if ( verbose ) printf( "\n    FAIL: Sick offset %zu length %zu returns 0x%04" PRIX16 ", not 0x%04" PRIX16
+								, offset, len, crc16, ref16 );
+				errors++;
+			}
+		}
+	}
+
+	if ( errors == 0 ) printf( "OK\n" );
+	else {
+
+		if ( verbose ) printf( "\n    " );
+		printf( "FAILED %d checks\n", errors );
+	}
+
+	return errors;
+
+}  /* test_crc_block */
+
+/*
+ * int test_crc_batch( bool verbose );
+ *
+ * The function test_crc_batch() calculates the CRC of a batch of buffers with
+ * ragged lengths, including empty and NULL buffers, with the batch routines
+ * and compares the results with the one-pass routines for every
+ * implementation level which the processor supports.
+ */
+
+int test_crc_batch( bool verbose ) {
+
+	int errors;
+	size_t a;
+	size_t b;
+	size_t pos;
+	const unsigned char *bufs[TEST_BATCH_SIZE];
+	size_t lens[TEST_BATCH_SIZE];
+	uint16_t out16[TEST_BATCH_SIZE];
+	uint32_t out32[TEST_BATCH_SIZE];
+	uint32_t out32c[TEST_BATCH_SIZE];
+	uint64_t out64e[TEST_BATCH_SIZE];
+	uint64_t out64w[TEST_BATCH_SIZE];
+	static const char *impl_names[] = { "generic", "slice8", "sse42", "clmul" };
+
+	errors = 0;
+
+	printf( "Testing CRC batch routines: " );
+
+	fill_test_buf();
+
+	pos = 0;
+
+	for (a=0; a<TEST_BATCH_SIZE; a++) {
+
+		lens[a] = test_lengths[ (a * 7) % (sizeof(test_lengths)/sizeof(test_lengths[0])) ];
+		if ( pos + lens[a] + TEST_NUM_OFFSET > TEST_BUF_SIZE ) pos = 0;
+
+		bufs[a] = ( a % 17 == 16 ) ? NULL : test_buf + pos + a % TEST_NUM_OFFSET;
+		pos    += lens[a] / 4;
+	}
+
+	for (b=0; b<sizeof(impl_names)/sizeof(impl_names[0]); b++) {
+
+		if ( ! libcrc_set_impl( impl_names[b] ) ) continue;
+
+		crc_16_batch(      bufs, lens, out16,  TEST_BATCH_SIZE );
+		crc_32_batch(      bufs, lens, out32,  TEST_BATCH_SIZE );
+		crc_32c_batch(     bufs, lens, out32c, TEST_BATCH_SIZE );
+		crc_64_ecma_batch( bufs, lens, out64e, TEST_BATCH_SIZE );
+		crc_64_we_batch(   bufs, lens, out64w, TEST_BATCH_SIZE );
+
+		for (a=0; a<TEST_BATCH_SIZE; a++) {
+
+			if ( out16[a]  != crc_16(      bufs[a], lens[a] )  ||
+			     out32[a]  != crc_32(      bufs[a], lens[a] )  ||
+			     out32c[a] != crc_32c(     bufs[a], lens[a] )  ||
+			     out64e[a] != crc_64_ecma( bufs[a], lens[a] )  ||
+			     out64w[a] != crc_64_we(   bufs[a], lens[a] ) ) {
+
+				if ( verbose ) printf( "\n    FAIL: level %s buffer %zu length %zu", impl_names[b], a, lens[a] );
+				errors++;
+			}
+		}
+	}
+
+	libcrc_set_impl( "auto" );
+
+	if ( errors == 0 ) printf( "OK\n" );
+	else {
+
+		if ( verbose ) printf( "\n    " );
+		printf( "FAILED %d checks\n", errors );
+	}
+
+	return errors;
+
+}  /* test_crc_batch */
+
+/*
+ * int test_crc_verify( bool verbose );
+ *
+ * The function test_crc_verify() checks groups of equal length messages with
+ * the bit-sliced verify routines. Some of the expected values are damaged,
+ * and the failure masks and counts must point at exactly these messages.
+ * The number of messages is not a multiple of 64, so that the last group of
+ * lanes is only partly filled.
+ */
+
+int test_crc_verify( bool verbose ) {
+
+	int errors;
+	size_t a;
+	size_t b;
+	size_t len;
+	size_t count8;
+	size_t count16;
+	size_t damaged;
+	bool bad;
+	bool fail8;
+	bool fail16;
+	const unsigned char *msgs[TEST_VERIFY_SIZE];
+	uint8_t expect8[TEST_VERIFY_SIZE];
+	uint16_t expect16[TEST_VERIFY_SIZE];
+	uint64_t failed8[(TEST_VERIFY_SIZE+63)/64];
+	uint64_t failed16[(TEST_VERIFY_SIZE+63)/64];
+	static const size_t verify_lengths[] = { 0, 1, 4, 7, 8, 9, 15, 16, 17, 40 };
+
+	errors = 0;
+
+	printf( "Testing CRC verify routines: " );
+
+	fill_test_buf();
+
+	for (b=0; b<sizeof(verify_lengths)/sizeof(verify_lengths[0]); b++) {
+
+		len     = verify_lengths[b];
+		damaged = 0;
+
+		for (a=0; a<TEST_VERIFY_SIZE; a++) {
+
+			msgs[a]     = test_buf + 37 * a;
+			expect8[a]  = crc_8(      msgs[a], len );
+			expect16[a] = crc_modbus( msgs[a], len );
+
+			if ( a % 11 == 3 ) {
+
+				expect8[a]  ^= (uint8_t)  ( 1u << (a % 8)  );
+				expect16[a] ^= (uint16_t) ( 1u << (a % 16) );
+				damaged++;
+			}
+		}
+
+		count8  = crc_8_verify(      msgs, len, expect8,  failed8,  TEST_VERIFY_SIZE );
+		count16 = crc_modbus_verify( msgs, len, expect16, failed16, TEST_VERIFY_SIZE );
+
+		if ( count8 != damaged  ||  count16 != damaged ) {
+
+			if ( verbose ) printf( "\n    FAIL: length %zu reports %zu and %zu failures, not %zu", len, count8, count16, damaged );
+			errors++;
+		}
+
+		for (a=0; a<TEST_VERIFY_SIZE; a++) {
+
+			bad    = ( a % 11 == 3 );
+			fail8  = ( ( failed8[a/64]  >> (a%64) ) & 1 ) != 0;
+			fail16 = ( ( failed16[a/64] >> (a%64) ) & 1 ) != 0;
+
+			if ( fail8 != bad  ||  fail16 != bad ) {
+
+				if ( verbose ) printf( "\n    FAIL: length %zu message %zu has a wrong failure bit", len, a );
+				errors++;
+			}
+		}
+	}
+
+	if ( errors == 0 ) printf( "OK\n" );
+	else {
+
+		if ( verbose ) printf( "\n    " );
+		printf( "FAILED %d checks\n", errors );
+	}
+
+	return errors;
+
+}  /* test_crc_verify */
+
+/*
+ * int test_crc_model( bool verbose );
+ *
+ * The function test_crc_model() checks the parameterised CRC engine. Every
+ * algorithm of the catalog must produce its published check value and give
+ * the same result on every implementation level and when the data is split
+ * in two parts. The catalog algorithms which are also built into the library
+ * must match the dedicated routines, and all names and aliases must be found.
+ */
+
+int test_crc_model( bool verbose ) {
+
+	int errors;
+	size_t a;
+	size_t b;
+	size_t c;
+	size_t len;
+	size_t num_models;
+	uint64_t crc;
+	uint64_t expect;
+	uint64_t part;
+	const struct crc_model *models;
+	const struct crc_model *model;
+	struct crc_model custom;
+	static const char *impl_names[] = { "slice8", "sse42", "clmul" };
+	static const unsigned char check_str[] = "123456789";
+
+	errors = 0;
+
+	printf( "Testing CRC parameterised engine: " );
+
+	fill_test_buf();
+
+	models = crc_model_list( & num_models );
+
+	for (a=0; a<num_models; a++) {
+
+		model = & models[a];
+
+		if ( crc_model_find( model->name ) != model ) {
+
+			if ( verbose ) printf( "\n    FAIL: %s not found by name", model->name );
+			errors++;
+		}
+
+		for (b=0; b<sizeof(test_lengths)/sizeof(test_lengths[0]); b++) {
+
+			len = test_lengths[b];
+
+			libcrc_set_impl( "generic" );
+
+			expect = crc_model_calc( model, test_buf + a % TEST_NUM_OFFSET, len );
+
+			if ( b == 0  &&  crc_model_calc( model, check_str, 9 ) != model->check ) {
+
+				if ( verbose ) printf( "\n    FAIL: %s check value", model->name );
+				errors++;
+			}
+
+			for (c=0; c<sizeof(impl_names)/sizeof(impl_names[0]); c++) {
+
+				if ( ! libcrc_set_impl( impl_names[c] ) ) continue;
+
+				if ( crc_model_calc( model, test_buf + a % TEST_NUM_OFFSET, len ) != expect ) {
+
+					if ( verbose ) printf( "\n    FAIL: %s level %s length %zu", model->name, impl_names[c], len );
+					errors++;
+				}
+			}
+
+			libcrc_set_impl( "auto" );
+
+			part = crc_model_calc(   model, test_buf + a % TEST_NUM_OFFSET,           len / 3       );
+			crc  = crc_model_update( model, part, test_buf + a % TEST_NUM_OFFSET + len / 3, len - len / 3 );
+
+			if ( crc != expect ) {
+
+				if ( verbose ) printf( "\n    FAIL: %s split at %zu of %zu bytes", model->name, len / 3, len );
+				errors++;
+			}
+		}
+	}
+
+	for (b=0; b<sizeof(test_lengths)/sizeof(test_lengths[0]); b++) {
+
+		len = test_lengths[b];
+
+		if ( crc_model_calc( crc_model_find( "CRC-8/SMBUS"        ), test_buf, len ) != crc_8_smbus(    test_buf, len )  ||
+		     crc_model_calc( crc_model_find( "CRC-8/AUTOSAR"      ), test_buf, len ) != crc_8_autosar(  test_buf, len )  ||
+		     crc_model_calc( crc_model_find( "CRC-8/MAXIM-DOW"    ), test_buf, len ) != crc_8_maxim(    test_buf, len )  ||
+		     crc_model_calc( crc_model_find( "CRC-16/ARC"         ), test_buf, len ) != crc_16(         test_buf, len )  ||
+		     crc_model_calc( crc_model_find( "CRC-16/MODBUS"      ), test_buf, len ) != crc_modbus(     test_buf, len )  ||
+		     crc_model_calc( crc_model_find( "CRC-16/XMODEM"      ), test_buf, len ) != crc_xmodem(     test_buf, len )  ||
+		     crc_model_calc( crc_model_find( "CRC-16/SPI-FUJITSU" ), test_buf, len ) != crc_ccitt_1d0f( test_buf, len )  ||
+		     crc_model_calc( crc_model_find( "CRC-16/IBM-3740"    ), test_buf, len ) != crc_ccitt_ffff( test_buf, len )  ||
+		     crc_model_calc( crc_model_find( "CRC-32/ISO-HDLC"    ), test_buf, len ) != crc_32(         test_buf, len )  ||
+		     crc_model_calc( crc_model_find( "CRC-32/ISCSI"       ), test_buf, len ) != crc_32c(        test_buf, len )  ||
+		     crc_model_calc( crc_model_find( "CRC-64/ECMA-182"    ), test_buf, len ) != crc_64_ecma(    test_buf, len )  ||
+		     crc_model_calc( crc_model_find( "CRC-64/WE"          ), test_buf, len ) != crc_64_we(      test_buf, len ) ) {
+
+			if ( verbose ) printf( "\n    FAIL: built-in routine differs at length %zu", len );
+			errors++;
+		}
+	}
+
+	if ( crc_model_find( "crc-32c" ) != crc_model_find( "CRC-32/ISCSI" )  ||  crc_model_find( "CRC-16/X-25" ) != crc_model_find( "CRC-16/IBM-SDLC" ) ) {
+
+		if ( verbose ) printf( "\n    FAIL: alias lookup" );
+		errors++;
+	}
+
+	if ( crc_model_find( "CRC-32/NO-SUCH-CRC" ) != NULL  ||  crc_model_find( NULL ) != NULL ) {
+
+		if ( verbose ) printf( "\n    FAIL: unknown name found" );
+		errors++;
+	}
+
+	custom        = *crc_model_find( "CRC-24/OPENPGP" );
+	custom.name   = NULL;
+	custom.refout = true;
+
+	if ( crc_model_calc( & custom, check_str, 9 ) != 0x40F384ull ) {
+
+		if ( verbose ) printf( "\n    FAIL: descriptor outside the catalog" );
+		errors++;
+	}
+
+	if ( errors == 0 ) printf( "OK\n" );
+	else {
+
+		if ( verbose ) printf( "\n    " );
+		printf( "FAILED %d checks\n", errors );
+	}
+
+	return errors;
+
+}  /* test_crc_model */
+
+/*
+ * int test_crc_parallel( bool verbose );
+ *
+ * The function test_crc_parallel() compares the result of the multi-threaded
+ * CRC routines with the result of the single-threaded routines. It also
+ * checks that threads of the worker pool take part in the first parallel
+ * calculation, which is the one that creates the threads.
+ */
+
+int test_crc_parallel( bool verbose ) {
+
+	int errors;
+	int threads;
+	size_t a;
+	size_t offset;
+	size_t len;
+	const unsigned char *ptr;
+	uint32_t crc32;
+	uint32_t ref32;
+	uint64_t crc64;
+	uint64_t ref64;
+	unsigned long worker_jobs;
+
+	errors = 0;
+
+	printf( "Testing CRC parallel routines: " );
+
+	fill_test_buf();
+	crc_parallel_tune( 4096, 8 );
+
+	len = 16 * 4096;
+
+	if ( crc_parallel_split( len, 8, NULL ) > 1 ) {
+
+		worker_jobs = crc_parallel_worker_jobs();
+		crc32       = crc_32_parallel( test_buf, len, 8 );
+
+		if ( crc_parallel_worker_jobs() == worker_jobs ) {
+
+			if ( verbose ) printf( "\n    FAIL: no worker thread takes part in the first parallel calculation" );
+			errors++;
+		}
+
+		if ( crc32 != crc_32( test_buf, len ) ) {
+
+			if ( verbose ) printf( "\n    FAIL: CRC32 of the first parallel calculation returns 0x%08" PRIX32, crc32 );
+			errors++;
+		}
+	}
+
+	for (offset=0; offset<TEST_NUM_OFFSET; offset+=5) {
+
+		for (a=0; a<sizeof(test_lengths)/sizeof(test_lengths[0]); a++) {
+
+			for (threads=0; threads<=8; threads+=3) {
+
+				ptr = test_buf + offset;
+				len = test_lengths[a];
+
+				ref32 = crc_32( ptr, len );
+				crc32 = crc_32_parallel( ptr, len, threads );
+
+				if ( crc32 != ref32 ) {
+
+					if ( verbose ) printf( "\n    FAIL: CRC32 offset %zu length %zu threads %d returns 0x%08" PRIX32 ", not 0x%08" PRIX32
+									, offset, len, threads, crc32, ref32 );
+					errors++;
+				}
+
+				ref64 = crc_64_we( ptr, len );
+				crc64 = crc_64_we_parallel( ptr, len, threads );
+
+				if ( crc64 != ref64 ) {
+
+					if ( verbose ) printf( "\n    FAIL: CRC64 WE offset %zu length %zu threads %d returns 0x%016" PRIX64 ", not 0x%016" PRIX64
+									, offset, len, threads, crc64, ref64 );
+					errors++;
+				}
+			}
+		}
+	}
+
+	crc_parallel_tune( 0, 0 );
+
+	if ( errors == 0 ) printf( "OK\n" );
+	else {
+
+		if ( verbose ) printf( "\n    " );
+		printf( "FAILED %d checks\n", errors );
+	}
+
+	return errors;
+
+}  /* test_crc_parallel */
+
+/*
+ * int test_crc_dispatch( bool verbose );
+ *
+ * The function test_crc_dispatch() selects each implementation level which
+ * the processor supports in turn and compares the results of all streaming
+ * algorithms with the results of the generic byte-at-a-time level.
+ */
+
+int test_crc_dispatch( bool verbose ) {
+
+	int errors;
+
+	errors = 0;
+
+	printf( "Testing CRC dispatch levels: " );
+
+	fill_test_buf();
+
+	if ( ! libcrc_set_impl( "generic" ) ) {
+
+		if ( verbose ) printf( "\n    FAIL: generic level cannot be selected" );
+		errors++;
+	}
+
+	if ( libcrc_set_impl( "no-such-level" )  ||  strcmp( libcrc_get_impl(), "generic" ) != 0 ) {
+
+		if ( verbose ) printf( "\n    FAIL: unknown level changes the selection" );
+		errors++;
+	}
+
+	errors += compare_levels( verbose );
+
+	if ( ! libcrc_set_impl( "auto" ) ) {
+
+		if ( verbose ) printf( "\n    FAIL: automatic level cannot be selected" );
+		errors++;
+	}
+
+	if ( errors == 0 ) printf( "OK\n" );
+	else {
+
+		if ( verbose ) printf( "\n    " );
+		printf( "FAILED %d checks\n", errors );
+	}
+
+	return errors;
+
+}  /* test_crc_dispatch */
+
+/*
+ * int test_crc_autotune( bool verbose );
+ *
+ * The function test_crc_autotune() runs the auto-tuner with a new, a valid
+ * and a damaged cache file and checks that all implementation levels still
+ * return the same results with the tuned crossover points.
+ */
+
+int test_crc_autotune( bool verbose ) {
+
+	int errors;
+	FILE *fp;
+	char tune_file[512];
+
+	errors = 0;
+
+	printf( "Testing CRC auto-tuner: " );
+
+	fill_test_buf();
+
+	if ( ! tune_file_name( tune_file, sizeof(tune_file) ) ) {
+
+		if ( verbose ) printf( "\n    FAIL: no temporary cache file can be created\n    " );
+		printf( "FAILED 1 checks\n" );
+		return 1;
+	}
+
+	if ( ! libcrc_autotune( tune_file ) ) {
+
+		if ( verbose ) printf( "\n    FAIL: tuning with a new cache file" );
+		errors++;
+	}
+
+	if ( ! libcrc_autotune( tune_file ) ) {
+
+		if ( verbose ) printf( "\n    FAIL: tuning from an existing cache file" );
+		errors++;
+	}
+
+	fp = fopen( tune_file, "w" );
+
+	if ( fp != NULL ) {
+
+		fputs( "libcrc-autotune 1\nsignature\n", fp );
+		fclose( fp );
+	}
+
+	if ( ! libcrc_autotune( tune_file ) ) {
+
+		if ( verbose ) printf( "\n    FAIL: tuning with a damaged cache file" );
+		errors++;
+	}
+
+	remove( tune_file );
+
+	errors += compare_levels( verbose );
+
+	libcrc_set_impl( "auto" );
+
+	if ( errors == 0 ) printf( "OK\n" );
+	else {
+
+		if ( verbose ) printf( "\n    " );
+		printf( "FAILED %d checks\n", errors );
+	}
+
+	return errors;
+
+}  /* test_crc_autotune */
+
+/*
+ * static bool tune_file_name( char *name, size_t size );
+ *
+ * The function tune_file_name() stores the name of a new temporary file for
+ * the cache of the auto-tuner in name, so that the test does not write in
+ * the current directory. The file is removed again, because the first run
+ * of the tuner must start without a cache file. The function returns false
+ * when no name could be created.
+ */
+
+static bool tune_file_name( char *name, size_t size ) {
+
+#if defined(_WIN32)
+	if ( tmpnam_s( name, size ) != 0 ) return false;
+#else
+	int fd;
+	const char *dir;
+
+	dir = getenv( "TMPDIR" );
+	if ( dir == NULL  ||  *dir == 0 ) dir = "/tmp";
+
+	if ( snprintf( name, size, "%s/%s", dir, TEST_TUNE_NAME ) >= (int) size ) return false;
+
+	fd = mkstemp( name );
+	if ( fd < 0 ) return false;
+
+	close( fd );
+#endif
+
+	remove( name );
+
+	return true;
+
+}  /* tune_file_name */
+
+/*
+ * static int compare_levels( bool verbose );
+ *
+ * The function compare_levels() selects each implementation level which the
+ * processor supports in turn and compares the results of all streaming
+ * algorithms with the results of the generic byte-at-a-time level. It
+ * returns the number of differences.
+ */
+
+static int compare_levels( bool verbose ) {
+
+	int errors;
+	int algo;
+	size_t a;
+	size_t b;
+	size_t offset;
+	size_t len;
+	const unsigned char *ptr;
+	uint64_t crc;
+	uint64_t ref;
+	static const char *impl_names[] = { "slice8", "sse42", "clmul" };
+
+	errors = 0;
+
+	for (offset=0; offset<TEST_NUM_OFFSET; offset+=3) {
+
+		for (a=0; a<sizeof(test_lengths)/sizeof(test_lengths[0]); a++) {
+
+			ptr = test_buf + offset;
+			len = test_lengths[a];
+
+			for (algo=0; algo<CRC_ALGO_NUM; algo++) {
+
+				libcrc_set_impl( "generic" );
+				ref = stream_crc( (enum crc_algo) algo, ptr, len );
+
+				for (b=0; b<sizeof(impl_names)/sizeof(impl_names[0]); b++) {
+
+					if ( ! libcrc_set_impl( impl_names[b] ) ) continue;
+
+					crc = stream_crc( (enum crc_algo) algo, ptr, len );
+
+					if ( crc != ref ) {
+
+						if ( verbose ) printf( "\n    FAIL: level %s algorithm %d offset %zu length %zu returns 0x%016" PRIX64 ", not 0x%016" PRIX64
+										, impl_names[b], algo, offset, len, crc, ref );
+						errors++;
+					}
+				}
+			}
+		}
+	}
+
+	return errors;
+
+}  /* compare_levels */
+
+/*
+ * static uint64_t stream_crc( enum crc_algo algo, const unsigned char *ptr, size_t len );
+ *
+ * The function stream_crc() calculates the CRC of a buffer with the streaming
+ * interface for one of the algorithms.
+ */
+
+static uint64_t stream_crc( enum crc_algo algo, const unsigned char *ptr, size_t len ) {
+
+	struct crc_ctx ctx;
+
+	crc_init( & ctx, algo );
+	crc_update( & ctx, ptr, len );
+
+	return crc_final( & ctx );
+
+}  /* stream_crc */
+
+/*
+ * static void fill_test_buf( void );
+ *
+ * The function fill_test_buf() fills the test buffer with a reproducible
+ * pseudo random byte sequence.
+ */
+
+static void fill_test_buf( void ) {
+
+	size_t a;
+	uint32_t seed;
+
+	seed = 0x12345678ul;
+
+	for (a=0; a<TEST_BUF_SIZE; a++) {
+
+		seed        = seed * 1103515245ul + 12345ul;
+		test_buf[a] = (unsigned char) ( seed >> 16 );
+	}
+
+}  /* fill_test_buf */
@@ -0,0 +1,149 @@
+/*
+ * Library: libcrc
+ * File:    test/testcomb.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2026 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file test/testcomb.c contains routines which test that the CRC
+ * combination routines of the libcrc library return the CRC value of a whole
+ * buffer when they are fed with the CRC values of two adjacent parts of that
+ * buffer, for a range of split points.
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "testall.h"
+
+#include "../include/checksum.h"
+
+#define TEST_BUF_SIZE		1000
+
+static int			check_combine( const char *name, size_t split, uint64_t whole, uint64_t combined, bool verbose );
+static void			fill_test_buf( void );
+
+static unsigned char		test_buf[TEST_BUF_SIZE];
+
+static const size_t		test_splits[] = {
+
+	0, 1, 2, 3, 7, 8, 9, 15, 16, 17, 100, 255, 256, 257, 500, 998, 999, 1000
+};
+
+/*
+ * int test_crc_combine( bool verbose );
+ *
+ * The function test_crc_combine() splits a test buffer at several positions
+ * and verifies that combining the CRC values of both parts returns the same
+ * value as the CRC calculation over the whole buffer.
+ */
+
+int test_crc_combine( bool verbose ) {
+
+	int errors;
+	size_t a;
+	size_t s;
+	size_t n;
+	const unsigned char *p;
+	const unsigned char *q;
+
+	errors = 0;
+
+	printf( "Testing CRC combine routines: " );
+
+	fill_test_buf();
+
+	for (a=0; a<sizeof(test_splits)/sizeof(test_splits[0]); a++) {
+
+		s = test_splits[a];
+		n = TEST_BUF_SIZE - s;
+		p = test_buf;
+		q = test_buf + s;
+
+		errors += check_combine( "CRC8",        s, crc_8(          p, TEST_BUF_SIZE ), crc_8_combine(          crc_8(          p, s ), crc_8(          q, n ), n ), verbose );
+		errors += check_combine( "CRC16",       s, crc_16(         p, TEST_BUF_SIZE ), crc_16_combine(         crc_16(         p, s ), crc_16(         q, n ), n ), verbose );
+		errors += check_combine( "CRC32",       s, crc_32(         p, TEST_BUF_SIZE ), crc_32_combine(         crc_32(         p, s ), crc_32(         q, n ), n ), verbose );
+		errors += check_combine( "CRC32C",      s, crc_32c(        p, TEST_BUF_SIZE ), crc_32c_combine(        crc_32c(        p, s ), crc_32c(        q, n ), n ), verbose );
+		errors += check_combine( "CRC64 ECMA",  s, crc_64_ecma(    p, TEST_BUF_SIZE ), crc_64_ecma_combine(    crc_64_ecma(    p, s ), crc_64_ecma(    q, n ), n ), verbose );
+		errors += check_combine( "CRC64 WE",    s, crc_64_we(      p, TEST_BUF_SIZE ), crc_64_we_combine(      crc_64_we(      p, s ), crc_64_we(      q, n ), n ), verbose );
+		errors += check_combine( "CCITT 1D0F",  s, crc_ccitt_1d0f( p, TEST_BUF_SIZE ), crc_ccitt_1d0f_combine( crc_ccitt_1d0f( p, s ), crc_ccitt_1d0f( q, n ), n ), verbose );
+		errors += check_combine( "CCITT FFFF",  s, crc_ccitt_ffff( p, TEST_BUF_SIZE ), crc_ccitt_ffff_combine( crc_ccitt_ffff( p, s ), crc_ccitt_ffff( q, n ), n ), verbose );
+		errors += check_combine( "DNP",         s, crc_dnp(        p, TEST_BUF_SIZE ), crc_dnp_combine(        crc_dnp(        p, s ), crc_dnp(        q, n ), n ), verbose );
+		errors += check_combine( "Kermit",      s, crc_kermit(     p, TEST_BUF_SIZE ), crc_kermit_combine(     crc_kermit(     p, s ), crc_kermit(     q, n ), n ), verbose );
+		errors += check_combine( "Modbus",      s, crc_modbus(     p, TEST_BUF_SIZE ), crc_modbus_combine(     crc_modbus(     p, s ), crc_modbus(     q, n ), n ), verbose );
+		errors += check_combine( "XModem",      s, crc_xmodem(     p, TEST_BUF_SIZE ), crc_xmodem_combine(     crc_xmodem(     p, s ), crc_xmodem(     q, n ), n ), verbose );
+		errors += check_combine( "Sick",        s, crc_sick(       p, TEST_BUF_SIZE ), crc_sick_combine(       crc_sick(       p, s ), crc_sick(       q, n ), n, ( s > 0 ) ? p[s-1] : 0 ), verbose );
+	}
+
+	if ( errors == 0 ) printf( "OK\n" );
+	else {
+
+		if ( verbose ) printf( "\n    " );
+		printf( "FAILED %d checks\n", errors );
+	}
+
+	return errors;
+
+}  /* test_crc_combine */
+
+/*
+ * static int check_combine( const char *name, size_t split, uint64_t whole, uint64_t combined, bool verbose );
+ *
+ * The function check_combine() compares the CRC value of a whole buffer with
+ * the combined value of its two parts. It returns 1 if the values differ and 0
+ * if they are equal.
+ */
+
+static int check_combine( const char *name, size_t split, uint64_t whole, uint64_t combined, bool verbose ) {
+
+	if ( whole == combined ) return 0;
+
+	if ( verbose ) printf( "\n    FAIL: %s split at %zu returns 0x%" PRIX64 ", not 0x%" PRIX64, name, split, combined, whole );
+
+	return 1;
+
+}  /* check_combine */
+
+/*
+ * static void fill_test_buf( void );
+ *
+ * The function fill_test_buf() fills the test buffer with a reproducible
+ * pseudo random byte sequence.
+ */
+
+static void fill_test_buf( void ) {
+
+	size_t a;
+	uint32_t seed;
+
+	seed = 0x87654321ul;
+
+	for (a=0; a<TEST_BUF_SIZE; a++) {
+
+		seed        = seed * 1103515245ul + 12345ul;
+		test_buf[a] = (unsigned char) ( seed >> 16 );
+	}
+
+}  /* fill_test_buf */
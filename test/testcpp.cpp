@@ -0,0 +1,155 @@
+/*
+ * Library: libcrc
+ * File:    test/testcpp.cpp
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2026 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file test/testcpp.cpp contains the test program for the C++
+ * header include/checksum.hpp. The check values of the algorithms are
+ * verified during compilation. At run time the results of the templates are
+ * compared with the C routines of the library for a range of buffer lengths
+ * and with the data passed in two parts.
+ */
+
+#include <cstdio>
+#include "../include/checksum.h"
+#include "../include/checksum.hpp"
+
+#define TEST_BUF_SIZE		5000
+
+static_assert( libcrc::crc8::compute(         "123456789" ) == 0xA2,                  "crc8"         );
+static_assert( libcrc::crc8_autosar::compute( "123456789" ) == 0xDF,                  "crc8_autosar" );
+static_assert( libcrc::crc8_maxim::compute(   "123456789" ) == 0xA1,                  "crc8_maxim"   );
+static_assert( libcrc::crc8_smbus::compute(   "123456789" ) == 0xF4,                  "crc8_smbus"   );
+static_assert( libcrc::crc16::compute(        "123456789" ) == 0xBB3D,                "crc16"        );
+static_assert( libcrc::ccitt_1d0f::compute(   "123456789" ) == 0xE5CC,                "ccitt_1d0f"   );
+static_assert( libcrc::ccitt_ffff::compute(   "123456789" ) == 0x29B1,                "ccitt_ffff"   );
+static_assert( libcrc::modbus::compute(       "123456789" ) == 0x4B37,                "modbus"       );
+static_assert( libcrc::xmodem::compute(       "123456789" ) == 0x31C3,                "xmodem"       );
+static_assert( libcrc::crc32::compute(        "123456789" ) == 0xCBF43926ul,          "crc32"        );
+static_assert( libcrc::crc32c::compute(       "123456789" ) == 0xE3069283ul,          "crc32c"       );
+static_assert( libcrc::crc64_ecma::compute(   "123456789" ) == 0x6C40DF5F0B497347ull, "crc64_ecma"   );
+static_assert( libcrc::crc64_we::compute(     "123456789" ) == 0x62EC59E3F1A4F00Aull, "crc64_we"     );
+
+static_assert( libcrc::crc<  3, 0x3,      0x0,      false, false, 0x7 >::compute( "123456789" ) == 0x4,      "CRC-3/GSM"      );
+static_assert( libcrc::crc<  5, 0x05,     0x1F,     true,  true,  0x1F >::compute( "123456789" ) == 0x19,    "CRC-5/USB"      );
+static_assert( libcrc::crc< 12, 0x80F,    0x000,    false, true,  0x000 >::compute( "123456789" ) == 0xDAF,  "CRC-12/UMTS"    );
+static_assert( libcrc::crc< 16, 0x1021,   0xB2AA,   true,  true,  0x0000 >::compute( "123456789" ) == 0x63D0, "CRC-16/RIELLO" );
+static_assert( libcrc::crc< 24, 0x864CFB, 0xB704CE, false, false, 0x000000 >::compute( "123456789" ) == 0x21CF02, "CRC-24/OPENPGP" );
+
+static unsigned char		test_buf[TEST_BUF_SIZE];
+
+static const std::size_t	test_lengths[] = {
+
+	0, 1, 2, 3, 7, 8, 9, 15, 16, 17, 63, 64, 65, 255, 256, 1000, 4096, TEST_BUF_SIZE
+};
+
+/*
+ * template <typename Crc, typename Func> static int compare( const char *name, Func func, bool verbose );
+ *
+ * The function compare() compares the result of one template instance with
+ * the C routine of the same algorithm and returns the number of differences.
+ */
+
+template <typename Crc, typename Func> static int compare( const char *name, Func func, bool verbose ) {
+
+	int errors;
+	std::size_t len;
+	std::size_t part;
+	Crc stream;
+
+	errors = 0;
+
+	for (std::size_t a=0; a<sizeof(test_lengths)/sizeof(test_lengths[0]); a++) {
+
+		len  = test_lengths[a];
+		part = len / 3;
+
+		stream.reset();
+		stream.update( test_buf + 1, part ).update( reinterpret_cast<const std::byte *>( test_buf + 1 + part ), len - part );
+
+		if ( Crc::compute( test_buf + 1, len ) != func( test_buf + 1, len )  ||  stream.value() != Crc::compute( test_buf + 1, len ) ) {
+
+			if ( verbose ) std::printf( "\n    FAIL: %s length %zu", name, len );
+			errors++;
+		}
+
+#if defined(LIBCRC_HAVE_SPAN)
+		if ( Crc::compute( std::span<const std::byte>( reinterpret_cast<const std::byte *>( test_buf + 1 ), len ) ) != Crc::compute( test_buf + 1, len ) ) {
+
+			if ( verbose ) std::printf( "\n    FAIL: %s span of length %zu", name, len );
+			errors++;
+		}
+#endif
+	}
+
+	return errors;
+
+}  /* compare */
+
+/*
+ * int main( void );
+ *
+ * Testcpp checks the C++ header of the libcrc library. The program returns
+ * the number of errors encountered.
+ */
+
+int main( void ) {
+
+	int errors;
+	std::uint32_t seed;
+
+	errors = 0;
+	seed   = 0x12345678u;
+
+	for (std::size_t a=0; a<TEST_BUF_SIZE; a++) {
+
+		seed        = seed * 1103515245u + 12345u;
+		test_buf[a] = static_cast<unsigned char>( seed >> 16 );
+	}
+
+	std::printf( "\nTesting C++ CRC templates: " );
+
+	errors += compare<libcrc::crc8>(         "crc8",         crc_8,          true );
+	errors += compare<libcrc::crc8_autosar>( "crc8_autosar", crc_8_autosar,  true );
+	errors += compare<libcrc::crc8_maxim>(   "crc8_maxim",   crc_8_maxim,    true );
+	errors += compare<libcrc::crc8_smbus>(   "crc8_smbus",   crc_8_smbus,    true );
+	errors += compare<libcrc::crc16>(        "crc16",        crc_16,         true );
+	errors += compare<libcrc::ccitt_1d0f>(   "ccitt_1d0f",   crc_ccitt_1d0f, true );
+	errors += compare<libcrc::ccitt_ffff>(   "ccitt_ffff",   crc_ccitt_ffff, true );
+	errors += compare<libcrc::modbus>(       "modbus",       crc_modbus,     true );
+	errors += compare<libcrc::xmodem>(       "xmodem",       crc_xmodem,     true );
+	errors += compare<libcrc::crc32>(        "crc32",        crc_32,         true );
+	errors += compare<libcrc::crc32c>(       "crc32c",       crc_32c,        true );
+	errors += compare<libcrc::crc64_ecma>(   "crc64_ecma",   crc_64_ecma,    true );
+	errors += compare<libcrc::crc64_we>(     "crc64_we",     crc_64_we,      true );
+
+	if ( errors == 0 ) std::printf( "OK\n\n**** All tests succeeded\n\n" );
+	else               std::printf( "\n    FAILED %d checks\n\n**** A TOTAL OF %d TESTS FAILED, PLEASE CORRECT THE DETECTED PROBLEMS ****\n\n", errors, errors );
+
+	return errors;
+
+}  /* main (libcrc C++ test) */
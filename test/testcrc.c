@@ -40,6 +40,7 @@
 #include "testall.h"
 
 #include "../include/checksum.h"
+#include "../include/checksum_inline.h"
 
 						/************************************************/
 struct chk_tp {					/*						*/
@@ -47,6 +48,7 @@ struct chk_tp {					/*						*/
 	uint8_t		crc8;			/* The  8 bit wide CRC8 of the input string	*/
 	uint16_t	crc16;			/* The 16 bit wide CRC16 of the input string	*/
 	uint32_t	crc32;			/* The 32 bit wide CRC32 of the input string	*/
+	uint32_t	crc32c;			/* The 32 bit wide CRC32C of the input string	*/
 	uint64_t	crc64_ecma;		/* The 64 bit wide CRC64-ECMA of the input	*/
 	uint64_t	crc64_we;		/* The 64 bit wide CRC64-WE of the input string	*/
 	uint16_t	crcdnp;			/* The 16 bit wide DNP CRC of the string	*/
@@ -56,15 +58,18 @@ struct chk_tp {					/*						*/
 	uint16_t	crc1d0f;		/* The 16 bit wide CCITT CRC with 1D0F start	*/
 	uint16_t	crcffff;		/* The 16 bit wide CCITT CRC with FFFF start	*/
 	uint16_t	crckermit;		/* The 16 bit wide CRC Kermit of the string	*/
+	uint8_t		crc8autosar;		/* The  8 bit wide AUTOSAR CRC of the string	*/
+	uint8_t		crc8maxim;		/* The  8 bit wide Maxim CRC of the string	*/
+	uint8_t		crc8smbus;		/* The  8 bit wide SMBus CRC of the string	*/
 };						/*						*/
 						/************************************************/
 
 static struct chk_tp checks[] = {
-	{ "123456789",    0xA2, 0xBB3D, 0xCBF43926ul, 0x6C40DF5F0B497347ull, 0x62EC59E3F1A4F00Aull, 0x82EA, 0x4B37, 0x56A6, 0x31C3, 0xE5CC, 0x29B1, 0x8921 },
-	{ "Lammert Bies", 0xA5, 0xB638, 0x43C04CA6ul, 0xF806F4F5C0F3257Cull, 0xFE25A9F50630F789ull, 0x4583, 0xB45C, 0x1108, 0xCEC8, 0x67A2, 0x4A31, 0xF80D },
-	{ "",             0x00, 0x0000, 0x00000000ul, 0x0000000000000000ull, 0x0000000000000000ull, 0xFFFF, 0xFFFF, 0x0000, 0x0000, 0x1D0F, 0xFFFF, 0x0000 },
-	{ " ",            0x86, 0xD801, 0xE96CCF45ul, 0xCC7AF1FF21C30BDEull, 0x568617D9EF46BE26ull, 0x50D6, 0x98BE, 0x2000, 0x2462, 0xE8FE, 0xC592, 0x0221 },
-	{ NULL,           0,    0,      0,            0,                     0,                     0,      0,      0,      0,      0,      0,      0      }
+	{ "123456789",    0xA2, 0xBB3D, 0xCBF43926ul, 0xE3069283ul, 0x6C40DF5F0B497347ull, 0x62EC59E3F1A4F00Aull, 0x82EA, 0x4B37, 0x56A6, 0x31C3, 0xE5CC, 0x29B1, 0x8921, 0xDF, 0xA1, 0xF4 },
+	{ "Lammert Bies", 0xA5, 0xB638, 0x43C04CA6ul, 0xF91F7762ul, 0xF806F4F5C0F3257Cull, 0xFE25A9F50630F789ull, 0x4583, 0xB45C, 0x1108, 0xCEC8, 0x67A2, 0x4A31, 0xF80D, 0xF0, 0x6F, 0xEE },
+	{ "",             0x00, 0x0000, 0x00000000ul, 0x00000000ul, 0x0000000000000000ull, 0x0000000000000000ull, 0xFFFF, 0xFFFF, 0x0000, 0x0000, 0x1D0F, 0xFFFF, 0x0000, 0x00, 0x00, 0x00 },
+	{ " ",            0x86, 0xD801, 0xE96CCF45ul, 0x72C0DD8Ful, 0xCC7AF1FF21C30BDEull, 0x568617D9EF46BE26ull, 0x50D6, 0x98BE, 0x2000, 0x2462, 0xE8FE, 0xC592, 0x0221, 0xCE, 0x23, 0xE0 },
+	{ NULL,           0,    0,      0,            0,            0,                     0,                     0,      0,      0,      0,      0,      0,      0,      0,    0,    0    }
 };
 
 /*
@@ -81,6 +86,9 @@ int test_crc( bool verbose ) {
 	int len;
 	const unsigned char *ptr;
 	uint8_t crc8;
+	uint8_t crc8autosar;
+	uint8_t crc8maxim;
+	uint8_t crc8smbus;
 	uint16_t crc16;
 	uint16_t crcdnp;
 	uint16_t crcmodbus;
@@ -90,6 +98,7 @@ int test_crc( bool verbose ) {
 	uint16_t crcffff;
 	uint16_t crckermit;
 	uint32_t crc32;
+	uint32_t crc32c;
 	uint64_t crc64_ecma;
 	uint64_t crc64_we;
 
@@ -103,18 +112,22 @@ int test_crc( bool verbose ) {
 		ptr = (const unsigned char *) checks[a].input;
 		len = strlen( checks[a].input );
 
-		crc8       = crc_8(          ptr, len );
-		crc16      = crc_16(         ptr, len );
-		crc32      = crc_32(         ptr, len );
-		crc64_ecma = crc_64_ecma(    ptr, len );
-		crc64_we   = crc_64_we(      ptr, len );
-		crcdnp     = crc_dnp(        ptr, len );
-		crcmodbus  = crc_modbus(     ptr, len );
-		crcsick    = crc_sick(       ptr, len );
-		crcxmodem  = crc_xmodem(     ptr, len );
-		crc1d0f    = crc_ccitt_1d0f( ptr, len );
-		crcffff    = crc_ccitt_ffff( ptr, len );
-		crckermit  = crc_kermit(     ptr, len );
+		crc8        = crc_8(          ptr, len );
+		crc16       = crc_16(         ptr, len );
+		crc32       = crc_32(         ptr, len );
+		crc32c      = crc_32c(        ptr, len );
+		crc64_ecma  = crc_64_ecma(    ptr, len );
+		crc64_we    = crc_64_we(      ptr, len );
+		crcdnp      = crc_dnp(        ptr, len );
+		crcmodbus   = crc_modbus(     ptr, len );
+		crcsick     = crc_sick(       ptr, len );
+		crcxmodem   = crc_xmodem(     ptr, len );
+		crc1d0f     = crc_ccitt_1d0f( ptr, len );
+		crcffff     = crc_ccitt_ffff( ptr, len );
+		crckermit   = crc_kermit(     ptr, len );
+		crc8autosar = crc_8_autosar(  ptr, len );
+		crc8maxim   = crc_8_maxim(    ptr, len );
+		crc8smbus   = crc_8_smbus(    ptr, len );
 
 		if ( crc8 != checks[a].crc8 ) {
 
@@ -137,6 +150,13 @@ int test_crc( bool verbose ) {
 			errors++;
 		}
 
+		if ( crc32c != checks[a].crc32c ) {
+
+			if ( verbose ) printf( "\n    FAIL: CRC32C \"%s\" returns 0x%08" PRIX32 ", not 0x%08" PRIX32
+							, checks[a].input, crc32c, checks[a].crc32c );
+			errors++;
+		}
+
 		if ( crc64_ecma != checks[a].crc64_ecma ) {
 
 			if ( verbose ) printf( "\n    FAIL: CRC64 ECMA \"%s\" returns 0x%016" PRIX64 ", not 0x%016" PRIX64
@@ -200,6 +220,27 @@ int test_crc( bool verbose ) {
 			errors++;
 		}
 
+		if ( crc8autosar != checks[a].crc8autosar ) {
+
+			if ( verbose ) printf( "\n    FAIL: CRC8 AUTOSAR \"%s\" returns 0x%02" PRIX8 ", not 0x%02" PRIX8
+							, checks[a].input, crc8autosar, checks[a].crc8autosar );
+			errors++;
+		}
+
+		if ( crc8maxim != checks[a].crc8maxim ) {
+
+			if ( verbose ) printf( "\n    FAIL: CRC8 Maxim \"%s\" returns 0x%02" PRIX8 ", not 0x%02" PRIX8
+							, checks[a].input, crc8maxim, checks[a].crc8maxim );
+			errors++;
+		}
+
+		if ( crc8smbus != checks[a].crc8smbus ) {
+
+			if ( verbose ) printf( "\n    FAIL: CRC8 SMBus \"%s\" returns 0x%02" PRIX8 ", not 0x%02" PRIX8
+							, checks[a].input, crc8smbus, checks[a].crc8smbus );
+			errors++;
+		}
+
 		a++;
 	}
 
@@ -213,3 +254,66 @@ int test_crc( bool verbose ) {
 	return errors;
 
 }  /* test_crc */
+
+/*
+ * int test_crc_inline( bool verbose );
+ *
+ * The function test_crc_inline() compares the inline update routines of
+ * checksum_inline.h with the library routines for every byte value and a
+ * series of register values.
+ */
+
+int test_crc_inline( bool verbose ) {
+
+	int a;
+	int b;
+	int c;
+	int errors;
+	uint64_t reg;
+
+	errors = 0;
+
+	printf( "Testing CRC inline update routines: " );
+
+	reg = 0x0123456789ABCDEFull;
+
+	for (a=0; a<64; a++) {
+
+		reg = reg * 6364136223846793005ull + 1442695040888963407ull;
+
+		for (b=0; b<256; b++) {
+
+			if ( update_crc_8_inline(      (uint8_t)  reg, (unsigned char) b ) != update_crc_8(      (uint8_t)  reg, (unsigned char) b )  ||
+			     update_crc_16_inline(     (uint16_t) reg, (unsigned char) b ) != update_crc_16(     (uint16_t) reg, (unsigned char) b )  ||
+			     update_crc_32_inline(     (uint32_t) reg, (unsigned char) b ) != update_crc_32(     (uint32_t) reg, (unsigned char) b )  ||
+			     update_crc_32c_inline(    (uint32_t) reg, (unsigned char) b ) != update_crc_32c(    (uint32_t) reg, (unsigned char) b )  ||
+			     update_crc_64_inline(                reg, (unsigned char) b ) != update_crc_64(                reg, (unsigned char) b )  ||
+			     update_crc_ccitt_inline(  (uint16_t) reg, (unsigned char) b ) != update_crc_ccitt(  (uint16_t) reg, (unsigned char) b )  ||
+			     update_crc_dnp_inline(    (uint16_t) reg, (unsigned char) b ) != update_crc_dnp(    (uint16_t) reg, (unsigned char) b )  ||
+			     update_crc_kermit_inline( (uint16_t) reg, (unsigned char) b ) != update_crc_kermit( (uint16_t) reg, (unsigned char) b ) ) {
+
+				if ( verbose ) printf( "\n    FAIL: register 0x%016" PRIX64 " byte 0x%02X", reg, b );
+				errors++;
+			}
+
+			for (c=0; c<256; c++) {
+
+				if ( update_crc_sick_inline( (uint16_t) reg, (unsigned char) b, (unsigned char) c ) != update_crc_sick( (uint16_t) reg, (unsigned char) b, (unsigned char) c ) ) {
+
+					if ( verbose ) printf( "\n    FAIL: Sick register 0x%04" PRIX16 " byte 0x%02X previous 0x%02X", (uint16_t) reg, b, c );
+					errors++;
+				}
+			}
+		}
+	}
+
+	if ( errors == 0 ) printf( "OK\n" );
+	else {
+
+		if ( verbose ) printf( "\n    " );
+		printf( "FAILED %d checks\n", errors );
+	}
+
+	return errors;
+
+}  /* test_crc_inline */
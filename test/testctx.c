@@ -0,0 +1,264 @@
+/*
+ * Library: libcrc
+ * File:    test/testctx.c
+ * Author:  Lammert Bies
+ *
+ * This file is licensed under the MIT License as stated below
+ *
+ * Copyright (c) 2026 Lammert Bies
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Description
+ * -----------
+ * The source file test/testctx.c contains routines which test that the
+ * streaming interface of the libcrc library returns the same values as the
+ * one-pass CRC routines when the data is passed in ranges of different sizes.
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "testall.h"
+
+#include "../include/checksum.h"
+
+#define TEST_BUF_SIZE		20000
+
+static uint64_t			one_pass( enum crc_algo algo, const unsigned char *ptr, size_t num_bytes );
+static void			fill_test_buf( void );
+
+static unsigned char		test_buf[TEST_BUF_SIZE];
+
+static const size_t		test_steps[] = {
+
+	1, 2, 3, 7, 8, 13, 64, 255, 1000, TEST_BUF_SIZE
+};
+
+static const uint32_t		test_masks[] = {
+
+	CRC_ALGO_ALL,
+	CRC_ALGO_MASK(CRC_ALGO_SICK),
+	CRC_ALGO_MASK(CRC_ALGO_32) | CRC_ALGO_MASK(CRC_ALGO_32C),
+	CRC_ALGO_MASK(CRC_ALGO_16) | CRC_ALGO_MASK(CRC_ALGO_MODBUS) | CRC_ALGO_MASK(CRC_ALGO_SICK) | CRC_ALGO_MASK(CRC_ALGO_64_WE),
+	0x5555,
+	0
+};
+
+/*
+ * int test_crc_ctx( bool verbose );
+ *
+ * The function test_crc_ctx() passes a test buffer in ranges of several
+ * sizes to the streaming interface and compares the result for every
+ * algorithm with the result of the one-pass CRC routine.
+ */
+
+int test_crc_ctx( bool verbose ) {
+
+	int errors;
+	int algo;
+	size_t a;
+	size_t pos;
+	size_t len;
+	size_t step;
+	uint64_t crc;
+	uint64_t ref;
+	struct crc_ctx ctx;
+
+	errors = 0;
+
+	printf( "Testing CRC streaming routines: " );
+
+	fill_test_buf();
+
+	for (algo=0; algo<CRC_ALGO_NUM; algo++) {
+
+		ref = one_pass( (enum crc_algo) algo, test_buf, TEST_BUF_SIZE );
+
+		for (a=0; a<sizeof(test_steps)/sizeof(test_steps[0]); a++) {
+
+			step = test_steps[a];
+
+			if ( ! crc_init( & ctx, (enum crc_algo) algo ) ) {
+
+				if ( verbose ) printf( "\n    FAIL: crc_init() rejects algorithm %d", algo );
+				errors++;
+				break;
+			}
+
+			for (pos=0; pos<TEST_BUF_SIZE; pos+=len) {
+
+				len = ( TEST_BUF_SIZE - pos < step ) ? TEST_BUF_SIZE - pos : step;
+				crc_update( & ctx, test_buf + pos, len );
+			}
+
+			crc = crc_final( & ctx );
+
+			if ( crc != ref ) {
+
+				if ( verbose ) printf( "\n    FAIL: algorithm %d step %zu returns 0x%" PRIX64 ", not 0x%" PRIX64, algo, step, crc, ref );
+				errors++;
+			}
+		}
+	}
+
+	if ( crc_init( & ctx, CRC_ALGO_NUM ) ) {
+
+		if ( verbose ) printf( "\n    FAIL: crc_init() accepts an invalid algorithm" );
+		errors++;
+	}
+
+	if ( errors == 0 ) printf( "OK\n" );
+	else {
+
+		if ( verbose ) printf( "\n    " );
+		printf( "FAILED %d checks\n", errors );
+	}
+
+	return errors;
+
+}  /* test_crc_ctx */
+
+/*
+ * int test_crc_multi( bool verbose );
+ *
+ * The function test_crc_multi() calculates several algorithms in one pass
+ * with crc_multi() and compares the results with the one-pass routines. It
+ * also checks that elements of algorithms which are not selected are left
+ * alone and that invalid masks are rejected.
+ */
+
+int test_crc_multi( bool verbose ) {
+
+	int errors;
+	int algo;
+	size_t a;
+	size_t b;
+	uint32_t mask;
+	uint64_t ref;
+	uint64_t results[CRC_ALGO_NUM];
+	static const size_t lengths[] = { 0, 1, 100, 8192, 8193, TEST_BUF_SIZE };
+
+	errors = 0;
+
+	printf( "Testing CRC multi algorithm routine: " );
+
+	fill_test_buf();
+
+	for (a=0; a<sizeof(test_masks)/sizeof(test_masks[0]); a++) for (b=0; b<sizeof(lengths)/sizeof(lengths[0]); b++) {
+
+		mask = test_masks[a];
+
+		for (algo=0; algo<CRC_ALGO_NUM; algo++) results[algo] = 0xDEADBEEFul;
+
+		if ( ! crc_multi( test_buf, lengths[b], mask, results ) ) {
+
+			if ( verbose ) printf( "\n    FAIL: crc_multi() rejects mask 0x%04" PRIX32, mask );
+			errors++;
+			continue;
+		}
+
+		for (algo=0; algo<CRC_ALGO_NUM; algo++) {
+
+			ref = ( mask & CRC_ALGO_MASK(algo) ) ? one_pass( (enum crc_algo) algo, test_buf, lengths[b] ) : 0xDEADBEEFul;
+
+			if ( results[algo] != ref ) {
+
+				if ( verbose ) printf( "\n    FAIL: mask 0x%04" PRIX32 " length %zu algorithm %d returns 0x%" PRIX64 ", not 0x%" PRIX64, mask, lengths[b], algo, results[algo], ref );
+				errors++;
+			}
+		}
+	}
+
+	if ( crc_multi( test_buf, TEST_BUF_SIZE, CRC_ALGO_MASK(CRC_ALGO_NUM), results ) ) {
+
+		if ( verbose ) printf( "\n    FAIL: crc_multi() accepts an invalid algorithm" );
+		errors++;
+	}
+
+	if ( crc_multi( test_buf, TEST_BUF_SIZE, CRC_ALGO_ALL, NULL ) ) {
+
+		if ( verbose ) printf( "\n    FAIL: crc_multi() accepts a NULL result array" );
+		errors++;
+	}
+
+	if ( errors == 0 ) printf( "OK\n" );
+	else {
+
+		if ( verbose ) printf( "\n    " );
+		printf( "FAILED %d checks\n", errors );
+	}
+
+	return errors;
+
+}  /* test_crc_multi */
+
+/*
+ * static uint64_t one_pass( enum crc_algo algo, const unsigned char *ptr, size_t num_bytes );
+ *
+ * The function one_pass() returns the CRC of a buffer calculated with the
+ * one-pass routine of an algorithm.
+ */
+
+static uint64_t one_pass( enum crc_algo algo, const unsigned char *ptr, size_t num_bytes ) {
+
+	switch ( algo ) {
+
+		case CRC_ALGO_8           : return crc_8(          ptr, num_bytes );
+		case CRC_ALGO_16          : return crc_16(         ptr, num_bytes );
+		case CRC_ALGO_32          : return crc_32(         ptr, num_bytes );
+		case CRC_ALGO_32C         : return crc_32c(        ptr, num_bytes );
+		case CRC_ALGO_64_ECMA     : return crc_64_ecma(    ptr, num_bytes );
+		case CRC_ALGO_64_WE       : return crc_64_we(      ptr, num_bytes );
+		case CRC_ALGO_CCITT_1D0F  : return crc_ccitt_1d0f( ptr, num_bytes );
+		case CRC_ALGO_CCITT_FFFF  : return crc_ccitt_ffff( ptr, num_bytes );
+		case CRC_ALGO_DNP         : return crc_dnp(        ptr, num_bytes );
+		case CRC_ALGO_KERMIT      : return crc_kermit(     ptr, num_bytes );
+		case CRC_ALGO_MODBUS      : return crc_modbus(     ptr, num_bytes );
+		case CRC_ALGO_SICK        : return crc_sick(       ptr, num_bytes );
+		case CRC_ALGO_XMODEM      : return crc_xmodem(     ptr, num_bytes );
+		case CRC_ALGO_8_AUTOSAR   : return crc_8_autosar(  ptr, num_bytes );
+		case CRC_ALGO_8_MAXIM     : return crc_8_maxim(    ptr, num_bytes );
+		case CRC_ALGO_8_SMBUS     : return crc_8_smbus(    ptr, num_bytes );
+		default                   : return 0;
+	}
+
+}  /* one_pass */
+
+/*
+ * static void fill_test_buf( void );
+ *
+ * The function fill_test_buf() fills the test buffer with a reproducible
+ * pseudo random byte sequence.
+ */
+
+static void fill_test_buf( void ) {
+
+	size_t a;
+	uint32_t seed;
+
+	seed = 0x2468ACE0ul;
+
+	for (a=0; a<TEST_BUF_SIZE; a++) {
+
+		seed        = seed * 1103515245ul + 12345ul;
+		test_buf[a] = (unsigned char) ( seed >> 16 );
+	}
+
+}  /* fill_test_buf */